@@ -4,6 +4,7 @@
 (do
   ; Memory layout constants
   (define-var HEAP_START 268435456)  ; 2GB offset - heap region
+  (define-var STACK_BASE 402653184)  ; 3GB offset - the VM stack grows down from here
   (define-var NULL 0)
   (define-var heap-pointer HEAP_START)
 
@@ -90,6 +91,9 @@
   (define-func (array-at object idx) (peek (+ object OBJECT_HEADER_SIZE (peek (+ object OBJECT_HEADER_NAMED_SLOTS)) idx)))
   (define-func (array-at-put object idx value)
     (poke (+ object OBJECT_HEADER_SIZE (peek (+ object OBJECT_HEADER_NAMED_SLOTS)) idx) value))
+  ; Address of indexed slot 0, for bulk copies
+  (define-func (array-base object)
+    (+ object OBJECT_HEADER_SIZE (peek (+ object OBJECT_HEADER_NAMED_SLOTS))))
 
   ; ===== Byte/Word Access for Different Shapes =====
   ; These functions handle element access based on object shape
@@ -165,8 +169,7 @@
       (define-var object-size (+ OBJECT_HEADER_SIZE named indexed-words))
       (define-var object (malloc object-size))
       ; Initialize all slots to NULL/zero
-      (for (i 0 object-size)
-        (poke (+ object i) NULL))
+      (mem-set object NULL object-size)
       ; Set header fields
       (poke (+ object OBJECT_HEADER_BEHAVIOR) behavior)
       (poke (+ object OBJECT_HEADER_IDENTITY) (allocate-identity))
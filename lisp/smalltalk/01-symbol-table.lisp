@@ -7,30 +7,9 @@
 
   ; Hash function using DJB2 algorithm for strings
   (define-func (hash-string str-addr table-size)
-    (do
-      (if (= str-addr NULL)
-          0
-          (do
-            (define-var str-len (peek str-addr))
-            (define-var hash 5381)  ; DJB2 initial value
-
-            ; Hash each character
-            (for (i 0 str-len)
-              (do
-                ; Get word containing this character
-                (define-var word-idx (/ i 8))
-                (define-var char-in-word (% i 8))
-                (define-var word (peek (+ str-addr 1 word-idx)))
-
-                ; Extract byte at position
-                (define-var shift (* char-in-word 8))
-                (define-var char-val (bit-and (bit-shr word shift) 255))
-
-                ; hash = hash * 33 + char
-                (set hash (+ (* hash 33) char-val))))
-
-            ; Return hash modulo table size
-            (% hash table-size)))))
+    (if (= str-addr NULL)
+        0
+        (% (str-hash str-addr) table-size)))
 
   ; Hash table structure:
   ; Each bucket has 3 slots: [key, value, occupied_flag]
@@ -50,11 +29,7 @@
     (do
       (define-var ht (new-instance (tag-int 992) 1 (* capacity HASH_BUCKET_SIZE)))
       (slot-at-put ht 0 (tag-int capacity))
-
-      ; Initialize all buckets to empty
-      (for (i 0 (* capacity HASH_BUCKET_SIZE))
-        (array-at-put ht i NULL))
-
+      ; Buckets start empty: new-instance zeroes every slot
       ht))
 
   (define-func (hash-table-capacity ht)
@@ -67,93 +42,56 @@
     (array-at-put ht (+ (* bucket-idx HASH_BUCKET_SIZE) offset) value))
 
   ; ===== Symbol Table for Selectors =====
-  ; Maps selector strings to unique IDs for consistent method lookup
+  ; Maps selector strings to unique IDs for consistent method lookup.
+  ; Hashing and probing happen natively (the INTERN opcode); this side keeps
+  ; the name string of each symbol for selector-name, indexed by id - 1.
 
-  (define-var SYMBOL_TABLE_CAPACITY 1000)
-  (define-var SYMBOL_HASH_SIZE 509)  ; Prime number for better distribution
+  (define-var SYMBOL_TABLE_INITIAL_CAPACITY 256)
   (define-var symbol-table NULL)
-  (define-var symbol-hash NULL)
-  (define-var symbol-count 0)
+  (define-var symbol-capacity 0)
+  (define-var symbol-count 0)  ; Highest symbol id in use
 
   (define-func (init-symbol-table)
     (do
-      (set symbol-table (new-instance (tag-int 991) 0 SYMBOL_TABLE_CAPACITY))
-      (set symbol-hash (new-hash-table SYMBOL_HASH_SIZE))
+      (intern NULL 0 0 0)
+      (set symbol-capacity SYMBOL_TABLE_INITIAL_CAPACITY)
+      (set symbol-table (new-instance (tag-int 991) 0 symbol-capacity))
       (set symbol-count 0)
       symbol-table))
 
-  (define-func (string-equal-addr str1-addr str2-addr)
-    ; Compare two strings for equality
+  (define-func (symbol-table-grow min-capacity)
+    ; Double the name array until it holds min-capacity entries
     (do
-      (define-var len1 (peek str1-addr))
-      (define-var len2 (peek str2-addr))
-      (if (= len1 len2)
-          (do
-            (define-var equal 1)
-            (define-var word-count (+ (/ len1 8) 1))
-            (for (i 1 (+ word-count 1))
-              (if (= (peek (+ str1-addr i)) (peek (+ str2-addr i)))
-                  0
-                  (set equal 0)))
-            equal)
-          0)))
-
-  (define-func (symbol-hash-lookup name-str)
-    ; Look up string in hash table
-    ; Returns symbol ID (tagged int) if found, 0 if not found
+      (define-var new-capacity symbol-capacity)
+      (while (< new-capacity min-capacity)
+        (set new-capacity (* new-capacity 2)))
+      (define-var grown (new-instance (tag-int 991) 0 new-capacity))
+      (mem-copy (array-base grown) (array-base symbol-table) symbol-count)
+      (set symbol-table grown)
+      (set symbol-capacity new-capacity)
+      grown))
+
+  (define-func (record-symbol id name-str)
+    ; Remember the name of a newly interned symbol
     (do
-      (define-var capacity SYMBOL_HASH_SIZE)
-      (define-var hash (hash-string name-str capacity))
-      (define-var idx hash)
-      (define-var found-id 0)
-      (define-var probes 0)
-
-      (while (< probes capacity)
-        (do
-          (define-var occupied (hash-table-get-bucket symbol-hash idx HASH_OCCUPIED_OFFSET))
+      (define-var n (untag-int id))
+      (if (> n symbol-capacity)
+          (symbol-table-grow n)
+          0)
+      (array-at-put symbol-table (- n 1) name-str)
+      (if (> n symbol-count)
+          (set symbol-count n)
+          0)
+      id))
 
-          (if (= occupied HASH_EMPTY)
-              (set probes capacity)
-              (do
-                (if (= occupied HASH_OCCUPIED)
-                    (do
-                      (define-var stored-str (hash-table-get-bucket symbol-hash idx HASH_KEY_OFFSET))
-                      (if (string-equal-addr name-str stored-str)
-                          (do
-                            (set found-id (hash-table-get-bucket symbol-hash idx HASH_VALUE_OFFSET))
-                            (set probes capacity))
-                          0))
-                    0)
-                (set idx (% (+ idx 1) capacity))
-                (set probes (+ probes 1))))))
-
-      found-id))
-
-  (define-func (symbol-hash-insert name-str symbol-id)
-    ; Insert string into hash table
+  (define-func (copy-string-slice str start len)
+    ; Fresh packed string holding len characters of str from start
     (do
-      (define-var capacity SYMBOL_HASH_SIZE)
-      (define-var hash (hash-string name-str capacity))
-      (define-var idx hash)
-      (define-var inserted 0)
-      (define-var probes 0)
-
-      (while (< probes capacity)
-        (do
-          (define-var occupied (hash-table-get-bucket symbol-hash idx HASH_OCCUPIED_OFFSET))
-
-          (if (if (= occupied HASH_EMPTY) 1 (= occupied HASH_DELETED))
-              (do
-                (hash-table-set-bucket symbol-hash idx HASH_KEY_OFFSET name-str)
-                (hash-table-set-bucket symbol-hash idx HASH_VALUE_OFFSET symbol-id)
-                (hash-table-set-bucket symbol-hash idx HASH_OCCUPIED_OFFSET HASH_OCCUPIED)
-                (set inserted 1)
-                (set probes capacity))
-              (do
-                (set idx (% (+ idx 1) capacity))
-                (set probes (+ probes 1))))))
-
-      inserted))
+      (define-var copy (malloc (+ (/ len 8) 2)))
+      (poke copy len)
+      (mem-set (+ copy 1) 0 (+ (/ len 8) 1))
+      (mem-copy-bytes (* (+ copy 1) 8) (+ (* (+ str 1) 8) start) len)
+      copy))
 
   (define-func (intern-selector name-str)
     ; Look up or create selector ID for given string
@@ -161,23 +99,54 @@
       (if (= symbol-table NULL)
           (init-symbol-table)
           0)
-
-      (define-var found-id (symbol-hash-lookup name-str))
-
-      (if (> found-id 0)
-          found-id
-          (do
-            (if (>= symbol-count SYMBOL_TABLE_CAPACITY)
-                (abort "Symbol table full")
-                0)
-
-            (array-at-put symbol-table symbol-count name-str)
-            (set symbol-count (+ symbol-count 1))
-
-            (define-var new-id (tag-int symbol-count))
-            (symbol-hash-insert name-str new-id)
-
-            new-id))))
+      (define-var id (intern name-str 0 (peek name-str) 0))
+      ; New ids are always one past the highest id in use
+      (if (> (untag-int id) symbol-count)
+          (record-symbol id name-str)
+          id)))
+
+  (define-func (intern-selector-at str start len)
+    ; Like intern-selector for the slice [start, start + len) of str; known
+    ; selectors allocate nothing, new ones get a copy of the slice as name
+    (do
+      (if (= symbol-table NULL)
+          (init-symbol-table)
+          0)
+      (define-var slice-id (intern str start len 0))
+      (if (> (untag-int slice-id) symbol-count)
+          (record-symbol slice-id (copy-string-slice str start len))
+          slice-id)))
+
+  (define-func (intern-selectors first-id names)
+    ; Bulk preload: the space-separated selectors in names get consecutive
+    ; ids from first-id. Returns the next free id (tagged).
+    (do
+      (if (= symbol-table NULL)
+          (init-symbol-table)
+          0)
+      (define-var names-len (peek names))
+      (define-var pos 0)
+      (define-var next-id first-id)
+      (while (< pos names-len)
+        (do
+          (define-var word-end pos)
+          (while (if (< word-end names-len)
+                     (if (= (bit-and (bit-shr (peek (+ names 1 (/ word-end 8)))
+                                              (* (% word-end 8) 8))
+                                     255)
+                            32)
+                         0
+                         1)
+                     0)
+            (set word-end (+ word-end 1)))
+          (if (> word-end pos)
+              (do
+                (record-symbol (intern names pos (- word-end pos) next-id)
+                               (copy-string-slice names pos (- word-end pos)))
+                (set next-id (+ next-id 1)))
+              0)
+          (set pos (+ word-end 1))))
+      (tag-int next-id)))
 
   (define-func (selector-name selector-id)
     ; Lookup string for a selector ID
@@ -2,91 +2,191 @@
 ; Method dictionaries, lookup, inline cache, context management
 
 (do
-  ; ===== Method Dictionary =====
-  ; Hash table for O(1) method lookup
-
-  (define-var METHOD_DICT_HASH_SIZE 127)
+  ; ===== Send Site Layout =====
+  ; Per-call-site polymorphic inline caches probed by the SEND_CACHED opcode.
+  ; Layout must match src/send_cache.hpp:
+  ;   [selector][nargs][miss-handler][state][hits][misses][next]
+  ;   [class0][target0] ... [class3][target3]
+  ; state counts the filled entries, or is SEND_SITE_MEGAMORPHIC.
+
+  (define-var SEND_SITE_SELECTOR 0)
+  (define-var SEND_SITE_NARGS 1)
+  (define-var SEND_SITE_HANDLER 2)
+  (define-var SEND_SITE_STATE 3)
+  (define-var SEND_SITE_HITS 4)
+  (define-var SEND_SITE_MISSES 5)
+  (define-var SEND_SITE_NEXT 6)
+  (define-var SEND_SITE_ENTRIES 7)
+  (define-var SEND_SITE_MAX_ENTRIES 4)
+  (define-var SEND_SITE_MEGAMORPHIC 5)
+  (define-var SEND_SITE_SIZE 15)
+  ; Arguments the miss handlers here take; sends of more get a handler the
+  ; compiler generates (see new-send-site-with)
+  (define-var SEND_SITE_MAX_ARGS 3)
+  (define-var SEND_SITE_BUCKETS 256)
+
+  ; All sites ever allocated, in SEND_SITE_BUCKETS chains by selector linked
+  ; through SEND_SITE_NEXT, so a new method only touches the sites that can
+  ; have cached a lookup of its selector
+  (define-var send-site-buckets NULL)
+
+  (define-func (send-site-bucket selector)
+    ; Word holding the first site of selector's chain
+    (+ send-site-buckets (bit-and (untag-int selector) (- SEND_SITE_BUCKETS 1))))
+
+  (define-func (flush-send-sites selector)
+    ; Forget the targets cached for selector (a method dictionary gained it)
+    (if (= send-site-buckets NULL)
+        0
+        (do
+          (define-var site (peek (send-site-bucket selector)))
+          (while (> site NULL)
+            (do
+              (if (= (peek (+ site SEND_SITE_SELECTOR)) selector)
+                  (poke (+ site SEND_SITE_STATE) 0)
+                  0)
+              (set site (peek (+ site SEND_SITE_NEXT)))))
+          0)))
 
-  (define-func (method-hash-int key table-size)
-    ; Hash function for integer keys (selector IDs)
+  ; ===== Method Dictionary =====
+  ; Power-of-two open-addressing table with Robin Hood probing.
+  ;
+  ; Named slots: [capacity][count][entries]. entries is a raw block of
+  ; capacity [selector, method] pairs; selectors are tagged (never 0), so a
+  ; 0 selector marks an empty slot. Entries are never removed, so there are
+  ; no tombstones. On insert, an entry that is closer to its home slot gives
+  ; way to the one being placed, which keeps probe lengths short and lets a
+  ; lookup stop as soon as it passes a closer entry. The table doubles when
+  ; a new entry takes it past 3/4 full.
+
+  (define-var METHOD_DICT_CAPACITY 0)
+  (define-var METHOD_DICT_COUNT 1)
+  (define-var METHOD_DICT_ENTRIES 2)
+  (define-var METHOD_DICT_MIN_CAPACITY 4)
+
+  (define-func (method-hash-int key mask)
+    ; Multiplicative hash of a selector id, reduced to a slot index
+    (bit-and (bit-shr (* (untag-int key) 2654435761) 16) mask))
+
+  (define-func (method-dict-capacity dict) (untag-int (slot-at dict METHOD_DICT_CAPACITY)))
+  (define-func (method-dict-size dict) (untag-int (slot-at dict METHOD_DICT_COUNT)))
+  (define-func (method-dict-entries dict) (slot-at dict METHOD_DICT_ENTRIES))
+
+  (define-func (new-method-entries capacity)
     (do
-      (define-var untagged (untag-int key))
-      (% (* untagged 2654435761) table-size)))
+      (mem-set (malloc (* capacity 2)) 0 (* capacity 2))))
 
   (define-func (new-method-dict capacity)
+    ; capacity is the expected number of methods
     (do
-      (define-var dict (new-instance (tag-int 989) 1 (* METHOD_DICT_HASH_SIZE HASH_BUCKET_SIZE)))
-      (slot-at-put dict 0 (tag-int METHOD_DICT_HASH_SIZE))
-
-      (for (i 0 (* METHOD_DICT_HASH_SIZE HASH_BUCKET_SIZE))
-        (array-at-put dict i NULL))
-
-      dict))
-
-  (define-func (method-dict-add dict selector code-addr)
+      (define-var size METHOD_DICT_MIN_CAPACITY)
+      (while (< (* size 3) (* capacity 4))
+        (set size (* size 2)))
+      (define-var new-methods (new-instance (tag-int 989) 3 0))
+      (slot-at-put new-methods METHOD_DICT_CAPACITY (tag-int size))
+      (slot-at-put new-methods METHOD_DICT_COUNT (tag-int 0))
+      (slot-at-put new-methods METHOD_DICT_ENTRIES (new-method-entries size))
+      new-methods))
+
+  (define-func (method-entries-insert entries mask selector code-addr)
+    ; Robin Hood insert; returns 1 for a new selector, 0 for a replacement
     (do
-      (define-var capacity (untag-int (slot-at dict 0)))
-      (define-var hash (method-hash-int selector capacity))
-      (define-var idx hash)
-      (define-var inserted 0)
-      (define-var probes 0)
-
-      (while (< probes capacity)
+      (define-var key selector)
+      (define-var value code-addr)
+      (define-var idx (method-hash-int key mask))
+      (define-var dist 0)
+      (define-var added 2)
+      (while (= added 2)
         (do
-          (define-var bucket-offset (* idx HASH_BUCKET_SIZE))
-          (define-var occupied (array-at dict (+ bucket-offset HASH_OCCUPIED_OFFSET)))
-
-          (if (if (= occupied HASH_EMPTY) 1 (= occupied HASH_DELETED))
+          (define-var slot (+ entries (* idx 2)))
+          (define-var resident (peek slot))
+          (if (= resident 0)
+              (do
+                (poke slot key)
+                (poke (+ slot 1) value)
+                (set added 1))
+          (if (= resident key)
               (do
-                (array-at-put dict (+ bucket-offset HASH_KEY_OFFSET) selector)
-                (array-at-put dict (+ bucket-offset HASH_VALUE_OFFSET) code-addr)
-                (array-at-put dict (+ bucket-offset HASH_OCCUPIED_OFFSET) HASH_OCCUPIED)
-                (set inserted 1)
-                (set probes capacity))
+                (poke (+ slot 1) value)
+                (set added 0))
               (do
-                (if (= occupied HASH_OCCUPIED)
-                    (if (= (array-at dict (+ bucket-offset HASH_KEY_OFFSET)) selector)
-                        (do
-                          (array-at-put dict (+ bucket-offset HASH_VALUE_OFFSET) code-addr)
-                          (set inserted 1)
-                          (set probes capacity))
-                        0)
+                (define-var resident-dist (bit-and (- idx (method-hash-int resident mask)) mask))
+                (if (< resident-dist dist)
+                    ; Take the slot from the richer resident and carry it on
+                    (do
+                      (define-var resident-value (peek (+ slot 1)))
+                      (poke slot key)
+                      (poke (+ slot 1) value)
+                      (set key resident)
+                      (set value resident-value)
+                      (set dist resident-dist))
                     0)
-                (set idx (% (+ idx 1) capacity))
-                (set probes (+ probes 1))))))
+                (set idx (bit-and (+ idx 1) mask))
+                (set dist (+ dist 1)))))))
+      added))
 
+  (define-func (method-dict-grow dict)
+    ; Double the capacity and reinsert every entry
+    (do
+      (define-var old-capacity (method-dict-capacity dict))
+      (define-var old-entries (method-dict-entries dict))
+      (define-var new-capacity (* old-capacity 2))
+      (define-var new-entries (new-method-entries new-capacity))
+      (for (i 0 old-capacity)
+        (if (= (peek (+ old-entries (* i 2))) 0)
+            0
+            (method-entries-insert new-entries (- new-capacity 1)
+                                   (peek (+ old-entries (* i 2)))
+                                   (peek (+ old-entries (* i 2) 1)))))
+      (slot-at-put dict METHOD_DICT_CAPACITY (tag-int new-capacity))
+      (slot-at-put dict METHOD_DICT_ENTRIES new-entries)
       dict))
 
-  (define-func (method-dict-lookup dict selector)
+  (define-func (method-dict-add dict selector code-addr)
     (do
-      (if (= dict NULL)
-          NULL
+      ; Grows after a new entry, so redefining a method never does; the
+      ; table is at most 3/4 full before the insert, so it has room
+      (if (= (method-entries-insert (method-dict-entries dict)
+                                    (- (method-dict-capacity dict) 1)
+                                    selector code-addr)
+             1)
           (do
-            (define-var capacity (untag-int (slot-at dict 0)))
-            (define-var hash (method-hash-int selector capacity))
-            (define-var idx hash)
-            (define-var found NULL)
-            (define-var probes 0)
-
-            (while (< probes capacity)
-              (do
-                (define-var bucket-offset (* idx HASH_BUCKET_SIZE))
-                (define-var occupied (array-at dict (+ bucket-offset HASH_OCCUPIED_OFFSET)))
+            (slot-at-put dict METHOD_DICT_COUNT (tag-int (+ (method-dict-size dict) 1)))
+            (if (> (* (method-dict-size dict) 4) (* (method-dict-capacity dict) 3))
+                (method-dict-grow dict)
+                0))
+          0)
+      (flush-send-sites selector)
+      (inline-cache-flush selector)
+      dict))
 
-                (if (= occupied HASH_EMPTY)
-                    (set probes capacity)
-                    (do
-                      (if (= occupied HASH_OCCUPIED)
-                          (if (= (array-at dict (+ bucket-offset HASH_KEY_OFFSET)) selector)
-                              (do
-                                (set found (array-at dict (+ bucket-offset HASH_VALUE_OFFSET)))
-                                (set probes capacity))
-                              0)
-                          0)
-                      (set idx (% (+ idx 1) capacity))
-                      (set probes (+ probes 1))))))
-
-            found))))
+  (define-func (method-dict-lookup dict selector)
+    (if (= dict NULL)
+        NULL
+        (do
+          (define-var entries (method-dict-entries dict))
+          (define-var mask (- (method-dict-capacity dict) 1))
+          (define-var idx (method-hash-int selector mask))
+          (define-var dist 0)
+          (define-var found NULL)
+          (define-var searching 1)
+          (while searching
+            (do
+              (define-var resident (peek (+ entries (* idx 2))))
+              (if (= resident selector)
+                  (do
+                    (set found (peek (+ entries (* idx 2) 1)))
+                    (set searching 0))
+                  ; An empty slot, or a resident closer to home than we have
+                  ; probed, means the selector is absent
+                  (if (if (= resident 0)
+                          1
+                          (< (bit-and (- idx (method-hash-int resident mask)) mask) dist))
+                      (set searching 0)
+                      (do
+                        (set idx (bit-and (+ idx 1) mask))
+                        (set dist (+ dist 1)))))))
+          found)))
 
   ; ===== Method Lookup =====
 
@@ -121,11 +221,9 @@
 
   (define-func (init-inline-cache)
     (do
+      ; new-instance zeroes the entries
       (set inline-cache (new-instance (tag-int 993) 0 (* INLINE_CACHE_SIZE INLINE_CACHE_ENTRY_SIZE)))
 
-      (for (i 0 (* INLINE_CACHE_SIZE INLINE_CACHE_ENTRY_SIZE))
-        (array-at-put inline-cache i NULL))
-
       (set inline-cache-hits 0)
       (set inline-cache-misses 0)
       inline-cache))
@@ -136,6 +234,18 @@
   (define-func (inline-cache-set-entry cache-id offset value)
     (array-at-put inline-cache (+ (* cache-id INLINE_CACHE_ENTRY_SIZE) offset) value))
 
+  (define-func (inline-cache-flush selector)
+    ; Forget the methods cached for selector, wherever its class put them
+    (if (= inline-cache NULL)
+        0
+        (for (i 0 INLINE_CACHE_SIZE)
+          (if (= (inline-cache-get-entry i 1) selector)
+              (do
+                (inline-cache-set-entry i 0 NULL)
+                (inline-cache-set-entry i 1 NULL)
+                (inline-cache-set-entry i 2 NULL))
+              0))))
+
   (define-func (lookup-method-cached receiver selector cache-id)
     ; Optimized method lookup with inline caching
     (do
@@ -183,7 +293,139 @@
             (print-string "%"))
           0)))
 
+  ; ===== Polymorphic Inline Caches =====
+  ; SEND_CACHED probes the site entries itself; on a miss it calls the
+  ; site's handler with (receiver args... site). The handler does the full
+  ; lookup, records the target while the site has room, and performs the
+  ; send. Sites that see more than SEND_SITE_MAX_ENTRIES classes turn
+  ; megamorphic and share the global selector cache above.
+
+  (define-func (send-site-class-key receiver)
+    ; Same key the VM computes for the receiver
+    (if (is-int receiver)
+        1
+        (if (= receiver NULL) 0 (peek receiver))))
+
+  (define-func (send-site-dnu-0 receiver) NULL)
+  (define-func (send-site-dnu-1 receiver arg1) NULL)
+  (define-func (send-site-dnu-2 receiver arg1 arg2) NULL)
+  (define-func (send-site-dnu-3 receiver arg1 arg2 arg3) NULL)
+
+  (define-func (send-site-resolve site receiver)
+    ; Full lookup for a miss; returns the code address to call
+    (do
+      (define-var selector (peek (+ site SEND_SITE_SELECTOR)))
+      (define-var state (peek (+ site SEND_SITE_STATE)))
+      (define-var method NULL)
+
+      (if (= state SEND_SITE_MEGAMORPHIC)
+          (set method (lookup-method-cached receiver selector
+                        (% (+ (send-site-class-key receiver) (untag-int selector))
+                           INLINE_CACHE_SIZE)))
+          (do
+            (set method (lookup-method receiver selector))
+            (if (> method NULL)
+                (if (< state SEND_SITE_MAX_ENTRIES)
+                    (do
+                      (define-var entry (+ site SEND_SITE_ENTRIES (* state 2)))
+                      (poke entry (send-site-class-key receiver))
+                      (poke (+ entry 1) method)
+                      (poke (+ site SEND_SITE_STATE) (+ state 1)))
+                    (poke (+ site SEND_SITE_STATE) SEND_SITE_MEGAMORPHIC))
+                0)))
+
+      (if (= method NULL)
+          (do
+            (print-string "ERROR: Method not found")
+            (print-int (untag-int selector))
+            (define-var nargs (peek (+ site SEND_SITE_NARGS)))
+            ; A generated handler answers NULL itself when given NULL
+            (if (= nargs 0) (function-address send-site-dnu-0)
+            (if (= nargs 1) (function-address send-site-dnu-1)
+            (if (= nargs 2) (function-address send-site-dnu-2)
+            (if (= nargs 3) (function-address send-site-dnu-3)
+                NULL)))))
+          method)))
+
+  (define-func (send-site-miss-0 receiver site)
+    (funcall (send-site-resolve site receiver) receiver))
+
+  (define-func (send-site-miss-1 receiver arg1 site)
+    (funcall (send-site-resolve site receiver) receiver arg1))
+
+  (define-func (send-site-miss-2 receiver arg1 arg2 site)
+    (funcall (send-site-resolve site receiver) receiver arg1 arg2))
+
+  (define-func (send-site-miss-3 receiver arg1 arg2 arg3 site)
+    (funcall (send-site-resolve site receiver) receiver arg1 arg2 arg3))
+
+  (define-func (new-send-site selector nargs)
+    ; Allocate an empty cache cell for one SEND_CACHED instruction
+    (do
+      (if (> nargs SEND_SITE_MAX_ARGS)
+          (abort "Too many arguments for a cached send")
+          0)
+      (new-send-site-with selector nargs
+            (if (= nargs 0) (function-address send-site-miss-0)
+            (if (= nargs 1) (function-address send-site-miss-1)
+            (if (= nargs 2) (function-address send-site-miss-2)
+                (function-address send-site-miss-3)))))))
+
+  (define-func (new-send-site-with selector nargs handler)
+    ; Same, with the miss handler given: one that takes (receiver args...
+    ; site) and sends through send-site-resolve
+    (do
+      (define-var site (malloc SEND_SITE_SIZE))
+      (poke (+ site SEND_SITE_SELECTOR) selector)
+      (poke (+ site SEND_SITE_NARGS) nargs)
+      (poke (+ site SEND_SITE_HANDLER) handler)
+      (poke (+ site SEND_SITE_STATE) 0)
+      (poke (+ site SEND_SITE_HITS) 0)
+      (poke (+ site SEND_SITE_MISSES) 0)
+      (if (= send-site-buckets NULL)
+          (set send-site-buckets (mem-set (malloc SEND_SITE_BUCKETS) 0 SEND_SITE_BUCKETS))
+          0)
+      (define-var bucket (send-site-bucket selector))
+      (poke (+ site SEND_SITE_NEXT) (peek bucket))
+      (poke bucket site)
+      site))
+
+  (define-func (send-site-stats site)
+    (do
+      (print-string "=== Send Site Statistics ===")
+      (print-string "  State (entries, 5 = megamorphic):")
+      (print-int (peek (+ site SEND_SITE_STATE)))
+      (print-string "  Hits:")
+      (print-int (peek (+ site SEND_SITE_HITS)))
+      (print-string "  Misses:")
+      (print-int (peek (+ site SEND_SITE_MISSES)))))
+
   ; ===== Context Management =====
+  ;
+  ; message-send runs sends in native frames bump-allocated on a context
+  ; stack; compiled methods only have their VM frame, which thisContext
+  ; reads on demand (method-context in 06-compiler). A frame only
+  ; becomes a heap Context when something asks for it as an object
+  ; (this-context, a debugger walking senders, a block capturing its home).
+  ; From then on the frame forwards to that Context, so either handle sees
+  ; the same state.
+  ;
+  ; Frame layout (the first five words mirror the CONTEXT_* named slots):
+  ; [sender][receiver][method][pc][sp][context][temp-count][temps...]
+
+  (define-var FRAME_CONTEXT 5)
+  (define-var FRAME_TEMP_COUNT 6)
+  (define-var FRAME_TEMPS 7)
+  (define-var CONTEXT_STACK_WORDS 8192)
+
+  (define-var context-stack NULL)
+  (define-var context-stack-top NULL)
+  (define-var context-stack-limit NULL)
+  (define-var contexts-materialized 0)
+  ; Heap Contexts pushed on a full stack whose sender is a frame, innermost
+  ; first, as links [context][frame sender][next]
+  (define-var overflow-links NULL)
+  (define-var overflow-spare-links NULL)
 
   (define-func (new-context sender receiver method temp-count)
     (do
@@ -195,17 +437,128 @@
       (slot-at-put ctx CONTEXT_SP (tag-int 0))
       ctx))
 
-  (define-func (context-get-sender ctx) (slot-at ctx CONTEXT_SENDER))
-  (define-func (context-get-receiver ctx) (slot-at ctx CONTEXT_RECEIVER))
-  (define-func (context-get-method ctx) (slot-at ctx CONTEXT_METHOD))
-  (define-func (context-get-pc ctx) (untag-int (slot-at ctx CONTEXT_PC)))
-  (define-func (context-get-sp ctx) (untag-int (slot-at ctx CONTEXT_SP)))
+  (define-func (context-is-frame ctx)
+    (if (= context-stack NULL)
+        0
+        (if (< ctx context-stack) 0 (< ctx context-stack-limit))))
+
+  (define-func (push-overflow-context sender receiver method temp-count)
+    ; Heap Context for a send on a full context stack. Its sender slot holds
+    ; the materialized sender, as for any heap Context; a frame sender is
+    ; recorded apart so method-return can pop back to the frame itself.
+    (do
+      (define-var ctx (new-context (context-materialize sender) receiver method temp-count))
+      (if (context-is-frame sender)
+          (do
+            (define-var link overflow-spare-links)
+            (if (= link NULL)
+                (set link (malloc 3))
+                (set overflow-spare-links (peek (+ link 2))))
+            (poke link ctx)
+            (poke (+ link 1) sender)
+            (poke (+ link 2) overflow-links)
+            (set overflow-links link))
+          0)
+      ctx))
+
+  (define-func (pop-overflow-sender ctx)
+    ; The frame recorded for ctx by push-overflow-context, else ctx's sender
+    (if (= overflow-links NULL)
+        (context-get-sender ctx)
+        (if (= (peek overflow-links) ctx)
+            (do
+              (define-var link overflow-links)
+              (set overflow-links (peek (+ link 2)))
+              (poke (+ link 2) overflow-spare-links)
+              (set overflow-spare-links link)
+              (peek (+ link 1)))
+            (context-get-sender ctx))))
+
+  (define-func (push-context-frame sender receiver method temp-count)
+    ; Falls back to a heap Context when the context stack is full
+    (do
+      (if (= context-stack NULL)
+          (do
+            (set context-stack (malloc CONTEXT_STACK_WORDS))
+            (set context-stack-top context-stack)
+            (set context-stack-limit (+ context-stack CONTEXT_STACK_WORDS)))
+          0)
+      ; Frames are rounded to 8 words like malloc so a frame address never
+      ; carries the SmallInteger tag
+      (define-var frame context-stack-top)
+      (define-var frame-end (+ frame (* (/ (+ FRAME_TEMPS temp-count 7) 8) 8)))
+      (if (> frame-end context-stack-limit)
+          (push-overflow-context sender receiver method temp-count)
+          (do
+            (set context-stack-top frame-end)
+            (poke (+ frame CONTEXT_SENDER) sender)
+            (poke (+ frame CONTEXT_RECEIVER) receiver)
+            (poke (+ frame CONTEXT_METHOD) method)
+            (poke (+ frame CONTEXT_PC) (tag-int 0))
+            (poke (+ frame CONTEXT_SP) (tag-int 0))
+            (poke (+ frame FRAME_CONTEXT) NULL)
+            (poke (+ frame FRAME_TEMP_COUNT) temp-count)
+            frame))))
+
+  (define-func (context-object ctx)
+    ; Heap Context holding ctx's state, or NULL for a frame not yet materialized
+    (if (context-is-frame ctx) (peek (+ ctx FRAME_CONTEXT)) ctx))
+
+  (define-func (materialize-frame frame sender)
+    ; sender is already materialized by the caller
+    (do
+      (define-var frame-temps (peek (+ frame FRAME_TEMP_COUNT)))
+      (define-var heap-ctx (new-context sender (peek (+ frame CONTEXT_RECEIVER))
+                                        (peek (+ frame CONTEXT_METHOD)) frame-temps))
+      (slot-at-put heap-ctx CONTEXT_PC (peek (+ frame CONTEXT_PC)))
+      (slot-at-put heap-ctx CONTEXT_SP (peek (+ frame CONTEXT_SP)))
+      (mem-copy (array-base heap-ctx) (+ frame FRAME_TEMPS) frame-temps)
+      (poke (+ frame FRAME_CONTEXT) heap-ctx)
+      (set contexts-materialized (+ contexts-materialized 1))
+      heap-ctx))
+
+  (define-func (context-materialize ctx)
+    ; Heap Context for ctx, materializing its sender chain first so the
+    ; object never points back into the context stack
+    (if (= ctx NULL)
+        NULL
+        (if (context-is-frame ctx)
+            (if (= (peek (+ ctx FRAME_CONTEXT)) NULL)
+                (materialize-frame ctx (context-materialize (peek (+ ctx CONTEXT_SENDER))))
+                (peek (+ ctx FRAME_CONTEXT)))
+            ctx)))
+
+  (define-func (this-context)
+    (context-materialize current-context))
+
+  (define-func (context-field ctx slot)
+    (do
+      (define-var obj (context-object ctx))
+      (if (= obj NULL) (peek (+ ctx slot)) (slot-at obj slot))))
+
+  (define-func (context-field-put ctx slot value)
+    (do
+      (define-var obj (context-object ctx))
+      (if (= obj NULL) (poke (+ ctx slot) value) (slot-at-put obj slot value))))
 
-  (define-func (context-set-pc ctx value) (slot-at-put ctx CONTEXT_PC (tag-int value)))
-  (define-func (context-set-sp ctx value) (slot-at-put ctx CONTEXT_SP (tag-int value)))
+  (define-func (context-get-sender ctx) (context-field ctx CONTEXT_SENDER))
+  (define-func (context-get-receiver ctx) (context-field ctx CONTEXT_RECEIVER))
+  (define-func (context-get-method ctx) (context-field ctx CONTEXT_METHOD))
+  (define-func (context-get-pc ctx) (untag-int (context-field ctx CONTEXT_PC)))
+  (define-func (context-get-sp ctx) (untag-int (context-field ctx CONTEXT_SP)))
 
-  (define-func (context-temp-at ctx idx) (array-at ctx idx))
-  (define-func (context-temp-at-put ctx idx value) (array-at-put ctx idx value))
+  (define-func (context-set-pc ctx value) (context-field-put ctx CONTEXT_PC (tag-int value)))
+  (define-func (context-set-sp ctx value) (context-field-put ctx CONTEXT_SP (tag-int value)))
+
+  (define-func (context-temp-at ctx idx)
+    (do
+      (define-var obj (context-object ctx))
+      (if (= obj NULL) (peek (+ ctx FRAME_TEMPS idx)) (array-at obj idx))))
+
+  (define-func (context-temp-at-put ctx idx value)
+    (do
+      (define-var obj (context-object ctx))
+      (if (= obj NULL) (poke (+ ctx FRAME_TEMPS idx) value) (array-at-put obj idx value))))
 
   ; ===== Test Framework =====
 
@@ -230,7 +583,7 @@
             (print-int (untag-int selector))
             NULL)
           (do
-            (define-var new-ctx (new-context current-context receiver method temp-count))
+            (define-var new-ctx (push-context-frame current-context receiver method temp-count))
 
             (define-var arg-count (untag-int (peek args)))
             (for (i 0 arg-count)
@@ -247,7 +600,15 @@
             (print-string "ERROR: Cannot return, no active context")
             NULL)
           (do
-            (define-var sender (context-get-sender current-context))
+            ; Pop the frame and follow its raw sender link, which stays a
+            ; frame even when both were materialized. A Context pushed on a
+            ; full stack returns to the frame it was pushed from.
+            (define-var sender NULL)
+            (if (context-is-frame current-context)
+                (do
+                  (set sender (peek (+ current-context CONTEXT_SENDER)))
+                  (set context-stack-top current-context))
+                (set sender (pop-overflow-sender current-context)))
             (set current-context sender)
             return-value))))
 
@@ -16,18 +16,7 @@
       (bit-and (bit-shr word (* byte-idx 8)) 255)))
 
   (define-func (string-equal str1 str2)
-    (do
-      (define-var len1 (string-length str1))
-      (define-var len2 (string-length str2))
-      (if (= len1 len2)
-          (do
-            (define-var equal 1)
-            (for (i 0 len1)
-              (if (= (string-char-at str1 i) (string-char-at str2 i))
-                  0
-                  (set equal 0)))
-            equal)
-          0)))
+    (str-equal str1 str2))
 
   ; ===== Character Classification =====
 
@@ -54,6 +43,11 @@
     (if (= char 10) 1
     (if (= char 13) 1 0)))))
 
+  ; Class bits for str-scan, which skips a run of such characters natively
+  (define-var CHAR_LETTER 1)
+  (define-var CHAR_DIGIT 2)
+  (define-var CHAR_WHITESPACE 4)
+
   ; ===== Token Types =====
 
   (define-var TOK_NUMBER 1)
@@ -67,10 +61,11 @@
   ; Token class (set during bootstrap)
   (define-var Token-class NULL)
 
-  ; Tokenizer state
-  (define-var tok-source NULL)
-  (define-var tok-pos 0)
-  (define-var tok-length 0)
+  ; Token records written by tokenize-into (the TOKENIZE opcode), reused
+  ; between calls and grown to the longest source seen
+  (define-var TOKEN_RECORD_SIZE 4)
+  (define-var tok-records NULL)
+  (define-var tok-records-capacity 0)
 
   ; Token factory
   (define-func (new-token type value start end)
@@ -88,38 +83,6 @@
   (define-func (token-start tok) (untag-int (slot-at tok 2)))
   (define-func (token-end tok) (untag-int (slot-at tok 3)))
 
-  ; Tokenizer helpers
-  (define-func (tok-peek)
-    (if (< tok-pos tok-length)
-        (string-char-at tok-source tok-pos)
-        0))
-
-  (define-func (tok-advance)
-    (set tok-pos (+ tok-pos 1)))
-
-  (define-func (tok-skip-whitespace)
-    (while (is-whitespace (tok-peek))
-      (tok-advance)))
-
-  (define-func (tok-read-number)
-    (do
-      (define-var num 0)
-      (while (is-digit (tok-peek))
-        (do
-          (define-var digit (- (tok-peek) 48))
-          (set num (+ (* num 10) digit))
-          (tok-advance)))
-      (tag-int num)))
-
-  (define-func (tok-read-identifier)
-    (do
-      (define-var start-pos tok-pos)
-      (while (if (is-letter (tok-peek))
-                 1
-                 (is-digit (tok-peek)))
-        (tok-advance))
-      (tag-int start-pos)))
-
   (define-func (is-binary-op char)
     ; Check if char is a binary operator: + - * / < > =
     (if (= char 43) 1  ; +
@@ -131,52 +94,26 @@
     (if (= char 61) 1  ; =
         0))))))))
 
-  (define-func (tok-next-token)
-    (do
-      (tok-skip-whitespace)
-      (define-var value NULL)
-      (define-var start tok-pos)
-      (define-var c (tok-peek))
-
-      (if (= c 0)
-          (new-token TOK_EOF NULL start start)
-      (if (is-digit c)
-          (do
-            (set value (tok-read-number))
-            (new-token TOK_NUMBER value start tok-pos))
-      (if (is-letter c)
-          (do
-            (set value (tok-read-identifier))
-            (if (= (tok-peek) 58)  ; ':'
-                (do
-                  (tok-advance)
-                  (new-token TOK_KEYWORD value start tok-pos))
-                (new-token TOK_IDENTIFIER value start tok-pos)))
-      (if (is-binary-op c)
-          (do
-            (tok-advance)
-            (new-token TOK_BINARY_OP (tag-int c) start tok-pos))
-          (new-token TOK_EOF NULL start start)))))))
-
+  ; The lexer itself is native (src/smalltalk_lexer.hpp). Each record has
+  ; the layout of a Token's slots, so a token is one allocation and one copy.
   (define-func (tokenize source)
     (do
-      (set tok-source source)
-      (set tok-pos 0)
-      (set tok-length (string-length source))
-
-      (define-var max-tokens (+ tok-length 1))
-      (define-var tokens (new-instance Array 0 max-tokens))
+      ; At most one token per character, plus EOF
+      (define-var max-tokens (+ (string-length source) 1))
+      (if (> max-tokens tok-records-capacity)
+          (do
+            (set tok-records (malloc (* max-tokens TOKEN_RECORD_SIZE)))
+            (set tok-records-capacity max-tokens))
+          0)
 
-      (define-var count 0)
-      (define-var tok (tok-next-token))
-      (while (< (token-type tok) TOK_EOF)
+      (define-var count (tokenize-into source tok-records max-tokens))
+      (define-var tokens (new-instance Array 0 count))
+      (for (i 0 count)
         (do
-          (array-at-put tokens count tok)
-          (set count (+ count 1))
-          (set tok (tok-next-token))))
-
-      (array-at-put tokens count tok)
-
+          (define-var tok (new-instance Token-class 4 0))
+          (mem-copy (+ tok OBJECT_HEADER_SIZE) (+ tok-records (* i TOKEN_RECORD_SIZE))
+                    TOKEN_RECORD_SIZE)
+          (array-at-put tokens i tok)))
       tokens))
 
   0)
@@ -3,6 +3,7 @@
 
 (do
   ; ===== VM Opcode Constants =====
+  ; Must match the Opcode enum in src/opcodes.hpp
 
   (define-var OP_HALT 0)
   (define-var OP_PUSH 1)
@@ -28,21 +29,39 @@
   (define-var OP_IRET 21)
   (define-var OP_LOAD 22)
   (define-var OP_STORE 23)
-  (define-var OP_BP_LOAD 24)
-  (define-var OP_BP_STORE 25)
-  (define-var OP_PRINT 26)
-  (define-var OP_PRINT_STR 27)
-  (define-var OP_AND 28)
-  (define-var OP_OR 29)
-  (define-var OP_XOR 30)
-  (define-var OP_SHL 31)
-  (define-var OP_SHR 32)
-  (define-var OP_ASHR 33)
-  (define-var OP_CLI 34)
-  (define-var OP_STI 35)
-  (define-var OP_SIGNAL_REG 36)
-  (define-var OP_ABORT 37)
-  (define-var OP_FUNCALL 38)
+  (define-var OP_LOAD_BYTE 24)
+  (define-var OP_STORE_BYTE 25)
+  (define-var OP_LOAD32 26)
+  (define-var OP_STORE32 27)
+  (define-var OP_BP_LOAD 28)
+  (define-var OP_BP_STORE 29)
+  (define-var OP_PRINT 30)
+  (define-var OP_PRINT_STR 31)
+  (define-var OP_AND 32)
+  (define-var OP_OR 33)
+  (define-var OP_XOR 34)
+  (define-var OP_SHL 35)
+  (define-var OP_SHR 36)
+  (define-var OP_ASHR 37)
+  (define-var OP_CLI 38)
+  (define-var OP_STI 39)
+  (define-var OP_SIGNAL_REG 40)
+  (define-var OP_ABORT 41)
+  (define-var OP_FUNCALL 42)
+  (define-var OP_EVAL 43)
+  (define-var OP_COMPILE 44)
+  (define-var OP_C_CALL 45)
+  (define-var OP_SEND_CACHED 46)
+  (define-var OP_TADD 47)
+  (define-var OP_TSUB 48)
+  (define-var OP_TMUL 49)
+  (define-var OP_TEQ 50)
+  (define-var OP_TLT 51)
+  (define-var OP_TGT 52)
+  (define-var OP_TLTE 53)
+  (define-var OP_TGTE 54)
+  (define-var OP_INTERN 55)
+  (define-var OP_FUNCTION 69)
 
   ; ===== Bytecode Buffer =====
 
@@ -56,55 +75,73 @@
   ; Source string for selector extraction
   (define-var compile-source-string NULL)
 
+  ; compile-method stores the address of a method's body this many words in
+  ; front of its entry point, just before the header (method-body,
+  ; method-containing)
+  (define-var METHOD_BODY_OFFSET 2)
+  (define-var METHOD_MAX_WORDS 1000)
+
+  ; Identifier compiled to a method-context call instead of a variable
+  (define-var THIS_CONTEXT_NAME "thisContext")
+
+  ; Miss handlers made by emit-miss-stub, by argument count
+  (define-var MISS_STUB_MAX 16)
+  (define-var miss-stubs NULL)
+
+  ; Out-of-line sends behind tagged fast paths, emitted after the method
+  ; body: pairs of [fast-path operand address, send site]
+  (define-var SLOW_PATH_MAX 64)
+  (define-var slow-paths NULL)
+  (define-var slow-path-count 0)
+
   ; ===== Selector Interning =====
 
+  (define-func (identifier-end pos)
+    ; Index just past the identifier that starts at pos
+    (str-scan compile-source-string pos (bit-or CHAR_LETTER CHAR_DIGIT)))
+
+  (define-func (keyword-end pos)
+    ; Index just past the keyword (identifier plus ':') that starts at pos
+    (do
+      (define-var end (identifier-end pos))
+      (if (if (< end (string-length compile-source-string))
+              (= (string-char-at compile-source-string end) 58)  ; ':'
+              0)
+          (+ end 1)
+          end)))
+
+  (define-func (copy-source-chars dest dest-pos start end)
+    ; Append source characters [start, end) to packed string dest at dest-pos
+    (do
+      (mem-copy-bytes (+ (* (+ dest 1) 8) dest-pos)
+                      (+ (* (+ compile-source-string 1) 8) start)
+                      (- end start))
+      (+ dest-pos (- end start))))
+
   (define-func (intern-identifier-at-pos pos)
-    ; Extract identifier string from source at position and intern it
+    ; Intern the identifier (or binary operator) at pos straight from the source
     (do
-      (define-var start pos)
-      (define-var end pos)
-      (define-var src-len (string-length compile-source-string))
-
-      ; Check if this is an operator
-      (define-var first-char (string-char-at compile-source-string pos))
-      (define-var is-operator (if (= first-char 43) 1   ; +
-                               (if (= first-char 45) 1   ; -
-                               (if (= first-char 42) 1   ; *
-                               (if (= first-char 47) 1   ; /
-                               (if (= first-char 60) 1   ; <
-                               (if (= first-char 62) 1   ; >
-                               (if (= first-char 61) 1   ; =
-                                   0))))))))
-
-      (if is-operator
-          (set end (+ pos 1))
-          (while (< end src-len)
-            (do
-              (define-var ch (string-char-at compile-source-string end))
-              (if (if (is-letter ch) 1 (is-digit ch))
-                  (set end (+ end 1))
-                  (set end src-len)))))
-
-      ; Create string with extracted identifier
-      (define-var id-len (- end start))
-      (define-var id-str (malloc (+ (/ id-len 8) 2)))
-      (poke id-str id-len)
-
-      (define-var word-count (+ (/ id-len 8) 1))
-      (for (word-idx 0 word-count)
-        (do
-          (define-var word 0)
-          (for (byte-idx 0 8)
-            (do
-              (define-var char-idx (+ (* word-idx 8) byte-idx))
-              (if (< char-idx id-len)
-                  (do
-                    (define-var ch (string-char-at compile-source-string (+ start char-idx)))
-                    (set word (bit-or word (bit-shl ch (* byte-idx 8)))))
-                  0)))
-          (poke (+ id-str 1 word-idx) word)))
-
-      (intern-selector id-str)))
+      (define-var end (if (is-binary-op (string-char-at compile-source-string pos))
+                          (+ pos 1)
+                          (identifier-end pos)))
+      (intern-selector-at compile-source-string pos (- end pos))))
+
+  ; Scratch string for assembling keyword and binary selectors
+  (define-var selector-buffer NULL)
+  (define-var selector-buffer-words 0)
+
+  (define-func (reset-selector-buffer len)
+    ; Empty the scratch string, growing it to hold len characters
+    (do
+      (define-var words (+ (/ len 8) 1))
+      (if (> words selector-buffer-words)
+          (do
+            (set selector-buffer-words (* (+ words 1) 2))
+            (set selector-buffer (malloc (+ selector-buffer-words 1))))
+          0)
+      (poke selector-buffer len)
+      (mem-set (+ selector-buffer 1) 0 words)
+      selector-buffer))
 
   (define-func (build-keyword-selector ast)
     ; Build keyword selector from AST (e.g., "at:put:")
@@ -116,59 +153,19 @@
       (for (i 0 num-args)
         (do
           (define-var kw-pos (untag-int (ast-child ast (+ (+ num-args 1) i))))
-          (define-var start kw-pos)
-          (define-var end kw-pos)
-          (define-var src-len (string-length compile-source-string))
-
-          (while (< end src-len)
-            (do
-              (define-var ch (string-char-at compile-source-string end))
-              (if (= ch 58)  ; ':'
-                  (do
-                    (set end (+ end 1))
-                    (set end src-len))
-                  (if (if (is-letter ch) 1 (is-digit ch))
-                      (set end (+ end 1))
-                      (set end src-len)))))
-
-          (set total-len (+ total-len (- end start)))))
-
-      ; Allocate string
-      (define-var sel-str (malloc (+ (/ total-len 8) 2)))
-      (poke sel-str total-len)
+          (set total-len (+ total-len (- (keyword-end kw-pos) kw-pos)))))
+
+      (reset-selector-buffer total-len)
 
       ; Second pass: copy keyword parts
       (define-var dest-pos 0)
       (for (i 0 num-args)
         (do
           (define-var kw-pos (untag-int (ast-child ast (+ (+ num-args 1) i))))
-          (define-var start kw-pos)
-          (define-var end kw-pos)
-          (define-var src-len (string-length compile-source-string))
-
-          (while (< end src-len)
-            (do
-              (define-var ch (string-char-at compile-source-string end))
-              (if (= ch 58)
-                  (do
-                    (set end (+ end 1))
-                    (set end src-len))
-                  (if (if (is-letter ch) 1 (is-digit ch))
-                      (set end (+ end 1))
-                      (set end src-len)))))
-
-          (define-var kw-len (- end start))
-          (for (j 0 kw-len)
-            (do
-              (define-var ch (string-char-at compile-source-string (+ start j)))
-              (define-var word-idx (/ dest-pos 8))
-              (define-var byte-idx (% dest-pos 8))
-              (define-var current-word (peek (+ sel-str 1 word-idx)))
-              (define-var new-word (bit-or current-word (bit-shl ch (* byte-idx 8))))
-              (poke (+ sel-str 1 word-idx) new-word)
-              (set dest-pos (+ dest-pos 1))))))
-
-      (intern-selector sel-str)))
+          (set dest-pos (copy-source-chars selector-buffer dest-pos kw-pos
+                                           (keyword-end kw-pos)))))
+
+      (intern-selector-at selector-buffer 0 total-len)))
 
   ; ===== Bytecode Emission =====
 
@@ -177,6 +174,10 @@
       (set bytecode-buffer heap-pointer)
       (set bytecode-pos 0)
       (set heap-pointer (+ heap-pointer max-size))
+      (if (= slow-paths NULL)
+          (set slow-paths (malloc (* SLOW_PATH_MAX 2)))
+          0)
+      (set slow-path-count 0)
       bytecode-buffer))
 
   (define-func (emit word)
@@ -187,9 +188,156 @@
   (define-func (current-address)
     (+ bytecode-buffer bytecode-pos))
 
+  (define-func (emit-function-header arg-count)
+    ; Header word in front of a method's entry point, as in
+    ; src/function_header.hpp: arity in bits 48-63, no temporaries. Answers
+    ; the entry point, which is what gets called.
+    (do
+      (emit (bit-or OP_FUNCTION (bit-shl arg-count 48)))
+      (current-address)))
+
+  (define-func (emit-send selector nargs)
+    ; Receiver and arguments are already on the stack; each send gets its
+    ; own inline cache cell
+    (do
+      (emit OP_SEND_CACHED)
+      (emit (if (> nargs SEND_SITE_MAX_ARGS)
+                (new-send-site-with selector nargs (miss-stub nargs))
+                (new-send-site selector nargs)))))
+
+  (define-func (emit-miss-stub nargs)
+    ; Miss handler for sends of more than SEND_SITE_MAX_ARGS arguments, which
+    ; no Lisp function can take whatever their number: called with (receiver
+    ; args... site), it copies them, finds the target with send-site-resolve
+    ; and sends with FUNCALL. A NULL target is the answer. BP_LOAD 1 is the
+    ; site and nargs + 2 the receiver.
+    (do
+      (define-var saved-buffer bytecode-buffer)
+      (define-var saved-pos bytecode-pos)
+      (set bytecode-buffer (malloc (+ (* nargs 3) 24)))
+      (set bytecode-pos 0)
+      (define-var entry (emit-function-header (+ nargs 2)))
+      (for (i 0 (+ nargs 1))
+        (do
+          (emit OP_PUSH)
+          (emit (- (+ nargs 2) i))
+          (emit OP_BP_LOAD)))
+      (emit OP_PUSH)
+      (emit (+ nargs 1))
+      (emit OP_PUSH)
+      (emit 1)
+      (emit OP_BP_LOAD)
+      (emit OP_PUSH)
+      (emit (+ nargs 2))
+      (emit OP_BP_LOAD)
+      (emit OP_PUSH)
+      (emit 2)
+      (emit OP_PUSH)
+      (emit (function-address send-site-resolve))
+      (emit OP_FUNCALL)
+      (emit OP_DUP)
+      (emit OP_JZ)
+      (emit (+ (current-address) 3))
+      (emit OP_FUNCALL)
+      (emit OP_RET)
+      (emit OP_RET)
+      (set bytecode-buffer saved-buffer)
+      (set bytecode-pos saved-pos)
+      entry))
+
+  (define-func (miss-stub nargs)
+    ; The generated miss handler for nargs, made once for the common counts
+    (if (< nargs MISS_STUB_MAX)
+        (do
+          (if (= miss-stubs NULL)
+              (set miss-stubs (mem-set (malloc MISS_STUB_MAX) NULL MISS_STUB_MAX))
+              0)
+          (if (= (peek (+ miss-stubs nargs)) NULL)
+              (poke (+ miss-stubs nargs) (emit-miss-stub nargs))
+              0)
+          (peek (+ miss-stubs nargs)))
+        (emit-miss-stub nargs)))
+
+  (define-func (tagged-opcode op-char)
+    ; SmallInteger fast-path opcode for a binary selector, or 0 if it has none
+    (if (= op-char 43) OP_TADD                       ; +
+    (if (= op-char 45) OP_TSUB                       ; -
+    (if (= op-char 42) OP_TMUL                       ; *
+    (if (= op-char 61) OP_TEQ                        ; =
+    (if (= op-char 60) OP_TLT                        ; <
+    (if (= op-char 62) OP_TGT                        ; >
+    (if (= op-char (bit-or 60 (bit-shl 61 8))) OP_TLTE  ; <=
+    (if (= op-char (bit-or 62 (bit-shl 61 8))) OP_TGTE  ; >=
+        0)))))))))
+
+  (define-func (emit-binary-send op-char selector)
+    ; Inline the SmallInteger case when there is one; its operand is patched
+    ; by emit-slow-paths to point at the real send
+    (do
+      (define-var fast-op (tagged-opcode op-char))
+      (if (= fast-op 0)
+          (emit-send selector 1)
+          (do
+            (if (< slow-path-count SLOW_PATH_MAX)
+                0
+                (abort "Too many tagged sends in one method"))
+            (emit fast-op)
+            (define-var slot (+ slow-paths (* slow-path-count 2)))
+            (poke slot (current-address))
+            (poke (+ slot 1) (new-send-site selector 1))
+            (set slow-path-count (+ slow-path-count 1))
+            (emit 0)))))
+
+  (define-func (emit-slow-paths)
+    ; Emit each pending send after the method body: the fast path jumps here
+    ; with both operands still on the stack, and the send's result resumes
+    ; right after the fast-path instruction
+    (do
+      (for (i 0 slow-path-count)
+        (do
+          (define-var operand-addr (peek (+ slow-paths (* i 2))))
+          (poke operand-addr (current-address))
+          (emit OP_SEND_CACHED)
+          (emit (peek (+ slow-paths (+ (* i 2) 1))))
+          (emit OP_JMP)
+          (emit (+ operand-addr 1))))
+      (set slow-path-count 0)))
+
   ; ===== AST Compilation =====
 
+  (define-func (compile-st-args ast from to)
+    ; Compile children [from, to) of ast; recursive so nested sends cannot
+    ; clobber a loop counter
+    (if (< from to)
+        (do
+          (compile-st-expr (ast-child ast from))
+          (compile-st-args ast (+ from 1) to))
+        0))
+
+  (define-func (this-context-at-pos pos)
+    ; Is the identifier at pos thisContext? Compared in the source, so
+    ; variable names never reach the selector table
+    (do
+      (define-var len (string-length THIS_CONTEXT_NAME))
+      (if (= (- (identifier-end pos) pos) len)
+          (= (mem-compare-bytes (+ (* (+ compile-source-string 1) 8) pos)
+                                (* (+ THIS_CONTEXT_NAME 1) 8)
+                                len)
+             0)
+          0)))
+
+  (define-func (binary-selector-id op-char)
+    ; op-char holds one or two packed characters, which is already the
+    ; string's data word
+    (do
+      (define-var op-len (if (< op-char 256) 1 2))
+      (reset-selector-buffer op-len)
+      (poke (+ selector-buffer 1) op-char)
+      (intern-selector-at selector-buffer 0 op-len)))
+
   (define-func (compile-st-expr ast)
+    ; Operands are compiled before the selector is looked at: locals of this
+    ; function are shared by every recursive call
     (do
       (define-var type (ast-type ast))
       (if (= type AST_NUMBER)
@@ -197,76 +345,34 @@
             (emit OP_PUSH)
             (emit (ast-value ast)))
       (if (= type AST_IDENTIFIER)
-          (do
-            (emit OP_PUSH)
-            (emit (tag-int 0)))
+          (if (this-context-at-pos (untag-int (ast-value ast)))
+              (do
+                (emit OP_PUSH)
+                (emit 0)
+                (emit OP_PUSH)
+                (emit (function-address method-context))
+                (emit OP_FUNCALL))
+              (do
+                (emit OP_PUSH)
+                (emit (tag-int 0))))
       (if (= type AST_UNARY_MSG)
           ; Unary message: receiver selector
           (do
-            (define-var selector-pos (untag-int (ast-value ast)))
-            (define-var selector-id (intern-identifier-at-pos selector-pos))
-
             (compile-st-expr (ast-child ast 0))
-            (emit OP_DUP)
-            (emit OP_PUSH)
-            (emit selector-id)
-            (emit OP_PUSH)
-            (emit lookup-method-addr)
-            (emit OP_PUSH)
-            (emit 2)
-            (emit OP_FUNCALL)
-            (emit OP_PUSH)
-            (emit 1)
-            (emit OP_FUNCALL)
+            (emit-send (intern-identifier-at-pos (untag-int (ast-value ast))) 0)
             0)
       (if (= type AST_KEYWORD_MSG)
           ; Keyword message: receiver selector: arg1 keyword2: arg2 ...
           (do
-            (define-var keyword-sel-id (build-keyword-selector ast))
-            (define-var num-args (untag-int (ast-value ast)))
-
-            (for (i 0 num-args)
-              (compile-st-expr (ast-child ast (+ i 1))))
-
-            (compile-st-expr (ast-child ast 0))
-            (emit OP_DUP)
-            (emit OP_PUSH)
-            (emit keyword-sel-id)
-            (emit OP_PUSH)
-            (emit lookup-method-addr)
-            (emit OP_PUSH)
-            (emit 2)
-            (emit OP_FUNCALL)
-            (emit OP_PUSH)
-            (emit (+ num-args 1))
-            (emit OP_FUNCALL)
+            (compile-st-args ast 0 (+ (untag-int (ast-value ast)) 1))
+            (emit-send (build-keyword-selector ast) (untag-int (ast-value ast)))
             0)
       (if (= type AST_BINARY_MSG)
           ; Binary message: receiver op argument
           (do
-            (define-var op-char (untag-int (ast-value ast)))
-
-            (define-var op-str (malloc 2))
-            (poke op-str 1)
-            (poke (+ op-str 1) op-char)
-
-            (define-var op-sel-id (intern-selector op-str))
-
-            (compile-st-expr (ast-child ast 0))
-            (emit OP_DUP)
-            (emit OP_PUSH)
-            (emit op-sel-id)
-            (emit OP_PUSH)
-            (emit lookup-method-addr)
-            (emit OP_PUSH)
-            (emit 2)
-            (emit OP_FUNCALL)
-
-            (compile-st-expr (ast-child ast 1))
-            (emit OP_SWAP)
-            (emit OP_PUSH)
-            (emit 2)
-            (emit OP_FUNCALL)
+            (compile-st-args ast 0 2)
+            (emit-binary-send (untag-int (ast-value ast))
+                              (binary-selector-id (untag-int (ast-value ast))))
             0)
           (abort "Unknown AST node type in compile"))))))))
 
@@ -280,18 +386,97 @@
       (define-var ast (parse source-string))
       (compile-st-expr ast)
       (emit OP_HALT)
+      (emit-slow-paths)
       bytecode-buffer))
 
   (define-func (compile-method source-string arg-count)
-    ; Compile a method body (ends with RET instead of HALT)
+    ; Compile a method body (ends with RET instead of HALT). The first
+    ; argument, if any, is the receiver. The method runs in nothing but its
+    ; VM frame; thisContext builds a Context from it (method-context).
     (do
       (set compile-source-string source-string)
-      (init-bytecode 1000)
+      (init-bytecode METHOD_MAX_WORDS)
+      (emit NULL)
+      (define-var entry (emit-function-header arg-count))
+      (poke (- entry METHOD_BODY_OFFSET) (current-address))
       (define-var ast (parse source-string))
       (compile-st-expr ast)
       (emit OP_RET)
-      (emit arg-count)
-      bytecode-buffer))
+      (emit-slow-paths)
+      entry))
+
+  (define-func (method-body entry)
+    ; First instruction of the body of a method from compile-method
+    (peek (- entry METHOD_BODY_OFFSET)))
+
+  ; ===== Contexts of Compiled Methods =====
+  ;
+  ; Compiled methods do no context work when called: their activation is
+  ; the VM frame SEND_CACHED or FUNCALL built. thisContext walks those
+  ; frames through their link words ([arity:16][temporaries:16][caller's
+  ; bp:32], src/function_header.hpp) and builds heap Contexts for the ones
+  ; running compiled methods, skipping Lisp frames such as miss handlers.
+  ; Past the outermost method, the sender is the message-send context
+  ; (this-context). The Contexts are copies: writing one does not change
+  ; the frame.
+
+  (define-var FRAME_LINK_BP_MASK 4294967295)
+
+  (define-func (method-containing pos)
+    ; Entry point of the method from compile-method whose code holds pos, or
+    ; NULL. Such a method has its body address then its header in front of
+    ; its entry point, and fits in METHOD_MAX_WORDS.
+    (if (< pos HEAP_START)
+        NULL
+        (do
+          (define-var found NULL)
+          (define-var at (- pos 2))
+          (define-var limit (- pos METHOD_MAX_WORDS))
+          (while (if (= found NULL) (> at limit) 0)
+            (if (if (= (bit-and (peek (+ at 1)) 255) OP_FUNCTION)
+                    (if (< (+ at 1) (peek at)) (<= (peek at) pos) 0)
+                    0)
+                (set found (+ at METHOD_BODY_OFFSET))
+                (set at (- at 1))))
+          found)))
+
+  (define-func (frame-context frame)
+    ; Context of the innermost compiled method among the callers of the
+    ; function whose VM frame is at frame
+    (do
+      (define-var link (peek frame))
+      (define-var caller (bit-and link FRAME_LINK_BP_MASK))
+      (if (>= caller STACK_BASE)
+          (this-context)
+          (do
+            ; The caller runs at the return address, above the temporaries
+            (define-var pos (peek (+ frame (bit-and (bit-shr link 32) 65535) 1)))
+            (define-var method (method-containing pos))
+            (if (= method NULL)
+                (frame-context caller)
+                (method-frame-context caller method pos))))))
+
+  (define-func (method-frame-context frame method pos)
+    ; Heap Context for the activation of method whose VM frame is at frame,
+    ; running at pos. Its temps are the arguments after the receiver.
+    (do
+      (define-var link (peek frame))
+      (define-var arity (bit-shr link 48))
+      ; Arguments sit above the return address, the receiver deepest
+      (define-var return-slot (+ frame (bit-and (bit-shr link 32) 65535) 1))
+      (define-var ctx (new-context (frame-context frame)
+                                   (if (> arity 0) (peek (+ return-slot arity)) NULL)
+                                   method
+                                   (if (> arity 0) (- arity 1) 0)))
+      (slot-at-put ctx CONTEXT_PC (tag-int (- pos method)))
+      (for (i 1 arity)
+        (array-at-put ctx (- i 1) (peek (+ return-slot (- arity i)))))
+      ctx))
+
+  (define-func (method-context)
+    ; What thisContext compiles to a call of: the Context of the calling
+    ; method. frame-pointer (C_CALL 15) answers this function's own frame.
+    (frame-context (c-call 15)))
 
   (define-func (install-method class selector source arg-count)
     ; Install a compiled method into a class
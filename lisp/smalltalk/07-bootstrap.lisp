@@ -76,7 +76,8 @@
   (define-var NAME_TOKEN 101)
 
   ; ===== Selector IDs =====
-  ; Core selectors used by the system
+  ; Core selectors used by the system; intern-bootstrap-selectors preloads
+  ; their names at these ids
   (define-var SEL_CLASS 10)           ; class
   (define-var SEL_IDENTITY_EQ 20)     ; ==
   (define-var SEL_IDENTITY_NEQ 21)    ; ~~
@@ -136,6 +137,21 @@
   (define-var SEL_AS_ARRAY 113)       ; asArray
   (define-var SEL_CONCAT 114)         ; ,
 
+  (define-func (intern-bootstrap-selectors)
+    ; Preload the core selector names so interning them answers the SEL_* ids
+    (do
+      (intern-selectors SEL_CLASS "class")
+      (intern-selectors SEL_IDENTITY_EQ "== ~~ yourself = ~= hash isNil notNil")
+      (intern-selectors SEL_SUPERCLASS "superclass methodDict new new: basicNew basicNew:")
+      (intern-selectors SEL_LT "< > <= >=")
+      (intern-selectors SEL_PLUS "+ - * / \\\\ bitAnd: bitOr: bitXor: bitShift: negated")
+      (intern-selectors SEL_SIZE "size isEmpty notEmpty do: includes:")
+      (intern-selectors SEL_AT "at: at:put: first last")
+      (intern-selectors SEL_ADD "add: remove: addFirst: addLast: removeFirst removeLast")
+      (intern-selectors SEL_AT_IFABSENT "at:ifAbsent: at:put:ifAbsent: keys values")
+      (intern-selectors SEL_SELECTOR "selector bytecodes literals numArgs numTemps")
+      (intern-selectors SEL_COPY_FROM_TO "copyFrom:to: asString asSymbol asArray ,")))
+
   ; ===== Bootstrap Function =====
   ; Creates the complete minimal class hierarchy
 
@@ -144,6 +160,8 @@
       (print-string "=== Smalltalk Bootstrap ===")
       (print-string "")
 
+      (intern-bootstrap-selectors)
+
       ; ===== Core Root Classes =====
       (print-string "Creating root classes...")
 
@@ -0,0 +1,183 @@
+(do
+  (print-string "")
+  (print-string "=== Send Cache Tests ===")
+
+  ; Method implementations take the receiver as their first argument
+  (define-func (st-int-add receiver arg)
+    (tag-int (+ (untag-int receiver) (untag-int arg))))
+  (define-func (st-int-mul receiver arg)
+    (tag-int (* (untag-int receiver) (untag-int arg))))
+  (define-func (st-int-div receiver arg)
+    (tag-int (/ (untag-int receiver) (untag-int arg))))
+  (define-func (st-int-between receiver low high)
+    (if (< (untag-int receiver) (untag-int low))
+        (tag-int 0)
+        (if (> (untag-int receiver) (untag-int high)) (tag-int 0) (tag-int 1))))
+  (define-func (st-int-sum4 receiver a b c d)
+    (tag-int (+ (untag-int receiver) (untag-int a) (untag-int b) (untag-int c) (untag-int d))))
+  (define-func (describe-int receiver) (tag-int 100))
+  (define-func (describe-a receiver) (tag-int 101))
+  (define-func (describe-b receiver) (tag-int 102))
+  (define-func (describe-c receiver) (tag-int 103))
+  (define-func (describe-d receiver) (tag-int 104))
+  (define-func (describe-a-override receiver) (tag-int 201))
+
+  (define-var int-methods (get-methods SmallInteger-class))
+  (method-dict-add int-methods (intern-selector "+") (function-address st-int-add))
+  (method-dict-add int-methods (intern-selector "*") (function-address st-int-mul))
+  (method-dict-add int-methods (intern-selector "/") (function-address st-int-div))
+  (method-dict-add int-methods (intern-selector "between:and:")
+                   (function-address st-int-between))
+  (method-dict-add int-methods (intern-selector "a:b:c:d:") (function-address st-int-sum4))
+
+  ; Test 1: binary sends through a fresh site ('/' has no SmallInteger fast path)
+  (print-string "Test 1: 7 / 2 through SEND_CACHED")
+  (define-var div-method (compile-method "7 / 2" 0))
+  (define-var div-body (method-body div-method))
+  (assert-equal (peek (+ div-body 4)) OP_SEND_CACHED "Expected SEND_CACHED")
+  (define-var div-site (peek (+ div-body 5)))
+  (assert-equal (untag-int (funcall div-method)) 3 "7 / 2 should be 3")
+  (assert-equal (peek (+ div-site SEND_SITE_STATE)) 1 "Site should be monomorphic")
+  (assert-equal (peek (+ div-site SEND_SITE_MISSES)) 1 "First send should miss")
+  (assert-equal (untag-int (funcall div-method)) 3 "7 / 2 should still be 3")
+  (assert-equal (peek (+ div-site SEND_SITE_HITS)) 1 "Second send should hit")
+  (print-string "  PASSED")
+
+  ; Test 2: nested sends each get their own site
+  (print-string "Test 2: 10 * 2 + 5")
+  (define-var nested-method (compile-method "10 * 2 + 5" 0))
+  (assert-equal (untag-int (funcall nested-method)) 25 "10 * 2 + 5 should be 25")
+  (assert-equal (untag-int (funcall nested-method)) 25 "Cached result should be 25")
+  (print-string "  PASSED")
+
+  ; Test 3: keyword send with two arguments
+  (print-string "Test 3: 3 between: 1 and: 5")
+  (define-var between-method (compile-method "3 between: 1 and: 5" 0))
+  (assert-equal (untag-int (funcall between-method)) 1 "3 should be between 1 and 5")
+  (define-var outside-method (compile-method "9 between: 1 and: 5" 0))
+  (assert-equal (untag-int (funcall outside-method)) 0 "9 should not be between 1 and 5")
+  (print-string "  PASSED")
+
+  ; Test 3b: more arguments than the Lisp miss handlers take
+  (print-string "Test 3b: 1 a: 2 b: 3 c: 4 d: 5")
+  (define-var sum4-method (compile-method "1 a: 2 b: 3 c: 4 d: 5" 0))
+  (assert-equal (untag-int (funcall sum4-method)) 15 "Sum should be 15 on a miss")
+  (assert-equal (untag-int (funcall sum4-method)) 15 "Sum should be 15 on a hit")
+  (define-var sum4-site (peek (+ (method-body sum4-method) 11)))
+  (assert-equal (peek (+ sum4-site SEND_SITE_STATE)) 1 "Miss should fill the site")
+  (assert-equal (peek (+ sum4-site SEND_SITE_HITS)) 1 "Second send should hit")
+  (define-var unknown4-method (compile-method "1 w: 2 x: 3 y: 4 z: 5" 0))
+  (assert-equal (funcall unknown4-method) NULL "Unknown selector should answer NULL")
+  (print-string "  PASSED")
+
+  ; Test 4: one site seeing several receiver classes
+  (print-string "Test 4: polymorphic and megamorphic site")
+  (define-var sel-describe (intern-selector "describe"))
+  (define-var ClassA (new-class (tag-int 501) Object-class))
+  (define-var ClassB (new-class (tag-int 502) Object-class))
+  (define-var ClassC (new-class (tag-int 503) Object-class))
+  (define-var ClassD (new-class (tag-int 504) Object-class))
+  (define-var methods-a (new-method-dict 4))
+  (define-var methods-b (new-method-dict 4))
+  (define-var methods-c (new-method-dict 4))
+  (define-var methods-d (new-method-dict 4))
+  (method-dict-add int-methods sel-describe (function-address describe-int))
+  (method-dict-add methods-a sel-describe (function-address describe-a))
+  (method-dict-add methods-b sel-describe (function-address describe-b))
+  (method-dict-add methods-c sel-describe (function-address describe-c))
+  (method-dict-add methods-d sel-describe (function-address describe-d))
+  (class-set-methods ClassA methods-a)
+  (class-set-methods ClassB methods-b)
+  (class-set-methods ClassC methods-c)
+  (class-set-methods ClassD methods-d)
+  (define-var obj-a (new-instance ClassA 0 0))
+  (define-var obj-b (new-instance ClassB 0 0))
+  (define-var obj-c (new-instance ClassC 0 0))
+  (define-var obj-d (new-instance ClassD 0 0))
+
+  ; (receiver) -> receiver describe, through a single site
+  (define-var describe-site (new-send-site sel-describe 0))
+  (init-bytecode 16)
+  (define-var describe-code (emit-function-header 1))
+  (emit OP_PUSH)
+  (emit 1)                              ; Receiver, past the return address
+  (emit OP_BP_LOAD)
+  (emit OP_SEND_CACHED)
+  (emit describe-site)
+  (emit OP_RET)
+
+  (assert-equal (untag-int (funcall describe-code (tag-int 7))) 100 "Integer describe")
+  (assert-equal (untag-int (funcall describe-code obj-a)) 101 "ClassA describe")
+  (assert-equal (untag-int (funcall describe-code obj-b)) 102 "ClassB describe")
+  (assert-equal (untag-int (funcall describe-code obj-c)) 103 "ClassC describe")
+  (assert-equal (peek (+ describe-site SEND_SITE_STATE)) 4 "Site should hold 4 entries")
+  (assert-equal (untag-int (funcall describe-code obj-b)) 102 "ClassB describe (cached)")
+  (assert-equal (peek (+ describe-site SEND_SITE_HITS)) 1 "Cached ClassB send should hit")
+  (assert-equal (untag-int (funcall describe-code obj-d)) 104 "ClassD describe")
+  (assert-equal (peek (+ describe-site SEND_SITE_STATE)) SEND_SITE_MEGAMORPHIC
+                "Fifth class should make the site megamorphic")
+  (assert-equal (untag-int (funcall describe-code obj-a)) 101 "ClassA describe (megamorphic)")
+  (assert-equal (untag-int (funcall describe-code (tag-int 1))) 100
+                "Integer describe (megamorphic)")
+  (print-string "  PASSED")
+
+  ; Test 5: installing a method flushes the sites of its selector
+  (print-string "Test 5: method install flushes sites")
+  (assert-equal (untag-int (funcall div-method)) 3 "7 / 2 before flush")
+  (method-dict-add methods-a sel-describe (function-address describe-a-override))
+  (assert-equal (peek (+ describe-site SEND_SITE_STATE)) 0 "Site should be flushed")
+  (assert-equal (peek (+ div-site SEND_SITE_STATE)) 1
+                "Sites of other selectors should keep their entries")
+  (assert-equal (untag-int (funcall describe-code obj-a)) 201 "Override should be found")
+  (assert-equal (untag-int (funcall div-method)) 3 "7 / 2 after flush")
+  ; Megamorphic again, the site goes through the global cache, which held
+  ; the old method for ClassA
+  (funcall describe-code obj-b)
+  (funcall describe-code obj-c)
+  (funcall describe-code obj-d)
+  (funcall describe-code (tag-int 1))
+  (assert-equal (peek (+ describe-site SEND_SITE_STATE)) SEND_SITE_MEGAMORPHIC
+                "Site should be megamorphic again")
+  (assert-equal (untag-int (funcall describe-code obj-a)) 201
+                "Override should be found through the global cache")
+  (print-string "  PASSED")
+
+  ; Test 6: does-not-understand answers NULL
+  (print-string "Test 6: unknown selector")
+  (define-var plain (new-instance Object-class 0 0))
+  (assert-equal (funcall describe-code plain) NULL "Unknown selector should answer NULL")
+  (print-string "  PASSED")
+
+  ; Test 7: SmallInteger fast paths with out-of-line sends
+  (print-string "Test 7: tagged arithmetic and comparisons")
+  (define-var add-method (compile-method "3 + 4" 0))
+  (define-var add-body (method-body add-method))
+  (assert-equal (peek (+ add-body 4)) OP_TADD "Expected TADD")
+  (define-var add-slow-path (peek (+ add-body 5)))
+  (assert-equal (peek add-slow-path) OP_SEND_CACHED "Fallback should be a send")
+  (assert-equal (peek (+ add-slow-path 2)) OP_JMP "Send should jump back")
+  (assert-equal (peek (+ add-slow-path 3)) (+ add-body 6) "Send should resume after TADD")
+  (define-var add-site (peek (+ add-slow-path 1)))
+  (assert-equal (untag-int (funcall add-method)) 7 "3 + 4 should be 7")
+  (assert-equal (peek (+ add-site SEND_SITE_MISSES)) 0 "Fast path should not send")
+  (assert-equal (untag-int (funcall (compile-method "7 - 10" 0))) -3 "7 - 10 should be -3")
+  (assert-equal (untag-int (funcall (compile-method "6 * 7" 0))) 42 "6 * 7 should be 42")
+  (assert-equal (untag-int (funcall (compile-method "3 < 4" 0))) 1 "3 < 4")
+  (assert-equal (untag-int (funcall (compile-method "3 > 4" 0))) 0 "3 > 4")
+  (assert-equal (untag-int (funcall (compile-method "4 = 4" 0))) 1 "4 = 4")
+  (assert-equal (untag-int (funcall (compile-method "4 <= 4" 0))) 1 "4 <= 4")
+  (assert-equal (untag-int (funcall (compile-method "5 <= 4" 0))) 0 "5 <= 4")
+  (assert-equal (untag-int (funcall (compile-method "5 >= 4" 0))) 1 "5 >= 4")
+  (assert-equal (untag-int (funcall (compile-method "1 + 2 * 3 - 4 < 6" 0))) 1
+                "(1 + 2) * 3 - 4 < 6 should be true")
+
+  ; SmallInteger overflow leaves the operands to the real send
+  (define-var overflow-method (compile-method "4611686018427387903 + 1" 0))
+  (define-var overflow-site (peek (+ (peek (+ (method-body overflow-method) 5)) 1)))
+  (funcall overflow-method)
+  (assert-equal (peek (+ overflow-site SEND_SITE_MISSES)) 1 "Overflow should send +")
+  (print-string "  PASSED")
+
+  (send-site-stats describe-site)
+  (print-string "=== Send Cache Tests Complete ===")
+  424242)
@@ -0,0 +1,151 @@
+(do
+  (print-string "")
+  (print-string "=== Stack Context Tests ===")
+
+  (define-func (st-int-identity receiver) receiver)
+  (define-var sel-identity (intern-selector "identity"))
+  (method-dict-add (get-methods SmallInteger-class) sel-identity
+                   (function-address st-int-identity))
+
+  (define-var args-addr (malloc 3))
+  (poke args-addr (tag-int 2))
+  (poke (+ args-addr 1) (tag-int 100))
+  (poke (+ args-addr 2) (tag-int 200))
+
+  ; Test 1: sends push native frames instead of allocating
+  (print-string "Test 1: message-send does not allocate")
+  (define-var outer-ctx (message-send (tag-int 42) sel-identity args-addr 2))
+  (define-var heap-before heap-pointer)
+  (define-var inner-ctx (message-send (tag-int 7) sel-identity args-addr 3))
+  (assert-equal heap-pointer heap-before "Send should not touch the heap")
+  (assert-true (context-is-frame inner-ctx) "Context should be a stack frame")
+  (assert-equal (bit-and inner-ctx 1) 0 "Frame address should not look like a SmallInteger")
+  (assert-equal current-context inner-ctx "Current context should be the new frame")
+  (print-string "  PASSED")
+
+  ; Test 2: frame accessors
+  (print-string "Test 2: frame accessors")
+  (assert-equal (untag-int (context-get-receiver inner-ctx)) 7 "Receiver should be 7")
+  (assert-equal (context-get-sender inner-ctx) outer-ctx "Sender should be the outer frame")
+  (assert-equal (untag-int (context-temp-at inner-ctx 1)) 200 "Second arg should be 200")
+  (context-temp-at-put inner-ctx 2 (tag-int 300))
+  (assert-equal (untag-int (context-temp-at inner-ctx 2)) 300 "Temp 2 should be 300")
+  (context-set-pc inner-ctx 12)
+  (assert-equal (context-get-pc inner-ctx) 12 "PC should be 12")
+  (print-string "  PASSED")
+
+  ; Test 3: reflective access materializes the sender chain
+  (print-string "Test 3: this-context materializes")
+  (define-var materialized-before contexts-materialized)
+  (define-var inner-obj (this-context))
+  (assert-true (if (context-is-frame inner-obj) 0 1) "this-context should be a heap object")
+  (assert-equal contexts-materialized (+ materialized-before 2) "Both frames materialized")
+  (assert-equal (this-context) inner-obj "Second access should answer the same object")
+  (assert-equal (context-object inner-ctx) inner-obj "Frame should forward to the object")
+  (define-var outer-obj (slot-at inner-obj CONTEXT_SENDER))
+  (assert-equal (context-object outer-ctx) outer-obj "Sender slot should be the outer object")
+  (assert-equal (untag-int (array-at inner-obj 2)) 300 "Temps should be copied")
+  (assert-equal (untag-int (slot-at inner-obj CONTEXT_PC)) 12 "PC should be copied")
+  (print-string "  PASSED")
+
+  ; Test 4: frame and object stay in sync after materialization
+  (print-string "Test 4: forwarding after materialization")
+  (context-temp-at-put inner-ctx 0 (tag-int 555))
+  (assert-equal (untag-int (array-at inner-obj 0)) 555 "Frame write should reach the object")
+  (array-at-put inner-obj 1 (tag-int 666))
+  (assert-equal (untag-int (context-temp-at inner-ctx 1)) 666 "Object write should reach frame")
+  (assert-equal (context-get-sender inner-ctx) outer-obj "Sender should be the outer object")
+  (print-string "  PASSED")
+
+  ; Test 5: returns pop frames; materialized contexts outlive them
+  (print-string "Test 5: method return")
+  (assert-equal (untag-int (method-return (tag-int 999))) 999 "Return value should be 999")
+  (assert-equal current-context outer-ctx "Should return to the outer frame")
+  (assert-equal context-stack-top inner-ctx "Inner frame should be popped")
+  (method-return (tag-int 0))
+  (assert-equal current-context NULL "Should return to NULL context")
+  (assert-equal context-stack-top context-stack "Context stack should be empty")
+  (assert-equal (untag-int (slot-at inner-obj CONTEXT_RECEIVER)) 7 "Object should survive")
+  (print-string "  PASSED")
+
+  ; Test 6: deep send chains reuse the same stack space
+  (print-string "Test 6: deep send chain")
+  (define-var heap-before-deep heap-pointer)
+  (define-var depth 0)
+  (while (< depth 500)
+    (do
+      (message-send (tag-int depth) sel-identity args-addr 2)
+      (set depth (+ depth 1))))
+  (assert-equal (untag-int (context-get-receiver current-context)) 499 "Top receiver")
+  (while (> depth 0)
+    (do
+      (method-return NULL)
+      (set depth (- depth 1))))
+  (assert-equal current-context NULL "All frames should be popped")
+  (assert-equal context-stack-top context-stack "Context stack should be empty again")
+  (assert-equal heap-pointer heap-before-deep "500 sends should not allocate")
+  (print-string "  PASSED")
+
+  ; Test 7: compiled methods run in VM frames, read by thisContext
+  (print-string "Test 7: thisContext in a compiled method")
+  (define-var sel-here (intern-selector "here"))
+  (install-method SmallInteger-class sel-here "thisContext" 1)
+  (define-var here-method (lookup-method (tag-int 5) sel-here))
+  (define-var caller-method (compile-method "5 here" 0))
+  (define-var here-ctx (funcall caller-method))
+  (assert-equal (untag-int (context-get-receiver here-ctx)) 5 "Receiver should be 5")
+  (assert-equal (context-get-method here-ctx) here-method "Method should be here")
+  (define-var caller-ctx (context-get-sender here-ctx))
+  (assert-equal (context-get-method caller-ctx) caller-method "Sender should be the caller")
+  (assert-equal (context-get-sender caller-ctx) NULL "Caller was entered from Lisp")
+  (assert-true (> (context-get-pc here-ctx) 0) "PC should be past the entry")
+  (assert-equal current-context NULL "Compiled sends should not touch the context stack")
+  (assert-equal context-stack-top context-stack "Context stack should be empty after the send")
+  (print-string "  PASSED")
+
+  ; Test 8: the context is read from the VM frame on every path
+  (print-string "Test 8: thisContext with arguments")
+  (define-var sel-at-put (intern-selector "ctxAt:put:"))
+  (install-method SmallInteger-class sel-at-put "thisContext" 3)
+  (define-var at-put-caller (compile-method "5 ctxAt: 6 put: 7" 0))
+  (define-var heap-before-sends heap-pointer)
+  (define-var at-put-ctx (funcall at-put-caller))
+  (assert-true (> heap-pointer heap-before-sends) "thisContext should build heap Contexts")
+  (define-var at-put-again (funcall at-put-caller))
+  (assert-true (if (= at-put-ctx at-put-again) 0 1) "Each activation gets its own Context")
+  (assert-equal (untag-int (context-get-receiver at-put-again)) 5 "Receiver after a cache hit")
+  (assert-equal (untag-int (context-temp-at at-put-again 0)) 6 "First argument")
+  (assert-equal (untag-int (context-temp-at at-put-again 1)) 7 "Second argument")
+  (assert-equal (context-get-method (context-get-sender at-put-again)) at-put-caller
+                "Sender after a cache hit")
+  (print-string "  PASSED")
+
+  ; Test 9: a full context stack falls back to heap Contexts
+  (print-string "Test 9: context stack overflow")
+  (set depth 0)
+  (while (context-is-frame (message-send (tag-int depth) sel-identity args-addr 2))
+    (set depth (+ depth 1)))
+  (define-var overflow-ctx current-context)
+  (define-var last-frame (context-get-sender overflow-ctx))
+  (assert-true (if (context-is-frame last-frame) 0 1) "Sender slot should be a heap object")
+  (assert-equal (untag-int (slot-at last-frame CONTEXT_RECEIVER)) (- depth 1) "Sender receiver")
+  (define-var full-top context-stack-top)
+  (message-send (tag-int 0) sel-identity args-addr 2)
+  (method-return NULL)
+  (assert-equal current-context overflow-ctx "Should return to the overflow Context")
+  (method-return NULL)
+  (assert-true (context-is-frame current-context) "Should return to the sender frame")
+  (assert-equal (context-object current-context) last-frame "Frame should forward to its object")
+  (assert-equal context-stack-top full-top "Stack should still hold the sender frame")
+  (method-return NULL)
+  (assert-true (< context-stack-top full-top) "Returning from the frame should pop it")
+  (while (> depth 1)
+    (do
+      (method-return NULL)
+      (set depth (- depth 1))))
+  (assert-equal current-context NULL "All frames should be popped")
+  (assert-equal context-stack-top context-stack "Context stack should be empty again")
+  (print-string "  PASSED")
+
+  (print-string "=== Stack Context Tests Complete ===")
+  424242)
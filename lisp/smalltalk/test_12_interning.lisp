@@ -0,0 +1,62 @@
+(do
+  (print-string "")
+  (print-string "=== Selector Interning Tests ===")
+
+  ; Test 1: bootstrap preloads the core selectors at their SEL_* ids
+  (print-string "Test 1: bootstrap selectors")
+  (assert-equal (untag-int (intern-selector "+")) SEL_PLUS "+ should be SEL_PLUS")
+  (assert-equal (untag-int (intern-selector "\\\\")) SEL_MOD "\\\\ should be SEL_MOD")
+  (assert-equal (untag-int (intern-selector "at:put:")) SEL_AT_PUT "at:put: should be SEL_AT_PUT")
+  (assert-equal (untag-int (intern-selector ",")) SEL_CONCAT ", should be SEL_CONCAT")
+  (assert-equal (peek (selector-name (tag-int SEL_NEGATED))) 7 "negated should have 7 chars")
+  (print-string "  PASSED")
+
+  ; Test 2: new selectors continue above the preloaded ids
+  (print-string "Test 2: sequential ids")
+  (define-var sel-foo (intern-selector "foo:bar:"))
+  (assert-true (> (untag-int sel-foo) SEL_CONCAT) "New ids should follow the bootstrap ids")
+  (assert-equal (intern-selector "foo:bar:") sel-foo "Re-interning should answer the same id")
+  (assert-equal (untag-int sel-foo) symbol-count "symbol-count tracks the highest id")
+  (print-string "  PASSED")
+
+  ; Test 3: slices of source text intern without allocating
+  (print-string "Test 3: intern-selector-at")
+  (define-var source "x foo:bar: y")
+  (define-var heap-before heap-pointer)
+  (assert-equal (intern-selector-at source 2 8) sel-foo "Slice should find foo:bar:")
+  (assert-equal heap-pointer heap-before "Known selector should not allocate")
+  (define-var sel-x (intern-selector-at source 0 1))
+  (assert-equal (peek (selector-name sel-x)) 1 "New slice should get a name string")
+  (print-string "  PASSED")
+
+  ; Test 4: compiling known selectors does not create symbols
+  (print-string "Test 4: compiler interning")
+  (compile-method "3 between: 1 and: 5" 0)
+  (define-var count-before symbol-count)
+  (compile-method "7 between: 2 and: 9" 0)
+  (compile-method "7 + 2" 0)
+  (assert-equal symbol-count count-before "Recompiling should not add symbols")
+  (compile-method "someVariable" 0)
+  (compile-method "thisContextual + thisContex" 0)
+  (assert-equal symbol-count count-before "Variable names should not become symbols")
+  (print-string "  PASSED")
+
+  ; Test 5: no fixed capacity
+  (print-string "Test 5: 2000 selectors")
+  ; Names are "Q" followed by two generated characters
+  (define-var name-buf (malloc 2))
+  (poke name-buf 3)
+  (define-var first-new (+ symbol-count 1))
+  (for (i 0 2000)
+    (do
+      (poke (+ name-buf 1) (bit-or 81 (bit-or (bit-shl (+ 48 (% i 64)) 8)
+                                              (bit-shl (+ 48 (/ i 64)) 16))))
+      (intern-selector-at name-buf 0 3)))
+  (assert-equal symbol-count (+ first-new 1999) "Every selector should get an id")
+  (poke (+ name-buf 1) (bit-or 81 (bit-or (bit-shl (+ 48 5) 8) (bit-shl (+ 48 3) 16))))
+  (assert-equal (untag-int (intern-selector-at name-buf 0 3)) (+ first-new 197)
+                "Lookup after growth")
+  (print-string "  PASSED")
+
+  (print-string "=== Selector Interning Tests Complete ===")
+  424242)
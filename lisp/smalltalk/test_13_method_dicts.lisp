@@ -0,0 +1,80 @@
+(do
+  (print-string "")
+  (print-string "=== Method Dictionary Tests ===")
+
+  ; Test 1: dictionaries start small and round up to a power of two
+  (print-string "Test 1: initial capacity")
+  (define-var heap-before heap-pointer)
+  (define-var small-dict (new-method-dict 1))
+  (assert-equal (method-dict-capacity small-dict) 4 "One method should fit in 4 slots")
+  (assert-equal (method-dict-size small-dict) 0 "New dictionary should be empty")
+  (assert-true (< (- heap-pointer heap-before) 32) "Small dictionary should stay small")
+  (assert-equal (method-dict-capacity (new-method-dict 10)) 16 "10 methods need 16 slots")
+  (assert-equal (method-dict-capacity (new-method-dict 12)) 16 "12 methods fit 16 at 3/4")
+  (assert-equal (method-dict-capacity (new-method-dict 13)) 32 "13 methods need 32 slots")
+  (print-string "  PASSED")
+
+  ; Test 2: add, replace and miss
+  (print-string "Test 2: add and lookup")
+  (method-dict-add small-dict (tag-int 5) 500)
+  (method-dict-add small-dict (tag-int 9) 900)
+  (assert-equal (method-dict-lookup small-dict (tag-int 5)) 500 "Lookup 5")
+  (assert-equal (method-dict-lookup small-dict (tag-int 9)) 900 "Lookup 9")
+  (assert-equal (method-dict-lookup small-dict (tag-int 7)) NULL "Missing selector")
+  (method-dict-add small-dict (tag-int 5) 555)
+  (assert-equal (method-dict-lookup small-dict (tag-int 5)) 555 "Replacement should win")
+  (assert-equal (method-dict-size small-dict) 2 "Replacement should not add an entry")
+  (method-dict-add small-dict (tag-int 11) 1100)
+  (assert-equal (method-dict-capacity small-dict) 4 "3 of 4 slots is still 3/4 full")
+  (method-dict-add small-dict (tag-int 9) 999)
+  (assert-equal (method-dict-capacity small-dict) 4 "Replacement at 3/4 should not grow")
+  (assert-equal (method-dict-lookup small-dict (tag-int 9)) 999 "Replacement at 3/4 should win")
+  (method-dict-add small-dict (tag-int 13) 1300)
+  (assert-equal (method-dict-capacity small-dict) 8 "A fourth method should grow the table")
+  (assert-equal (method-dict-size small-dict) 4 "Four methods")
+  (print-string "  PASSED")
+
+  ; Test 3: growth keeps identity and every entry
+  (print-string "Test 3: growth past 127 selectors")
+  (define-var big-dict (new-method-dict 1))
+  (for (i 1 301)
+    (method-dict-add big-dict (tag-int (* i 3)) (* i 10)))
+  (assert-equal (method-dict-size big-dict) 300 "Should hold 300 methods")
+  (assert-equal (method-dict-capacity big-dict) 512 "Should have doubled to 512")
+  (define-var all-found 1)
+  (for (i 1 301)
+    (if (= (method-dict-lookup big-dict (tag-int (* i 3))) (* i 10))
+        0
+        (set all-found 0)))
+  (assert-true all-found "Every method should survive growth")
+  (assert-equal (method-dict-lookup big-dict (tag-int 4)) NULL "Gaps should miss")
+  (assert-equal (method-dict-lookup big-dict (tag-int 903)) NULL "Past the end should miss")
+  (print-string "  PASSED")
+
+  ; Test 4: entries are packed pairs with 0 as the empty key
+  (print-string "Test 4: packed layout")
+  (define-var used 0)
+  (define-var entries (method-dict-entries big-dict))
+  (for (i 0 (method-dict-capacity big-dict))
+    (if (= (peek (+ entries (* i 2))) 0)
+        0
+        (set used (+ used 1))))
+  (assert-equal used 300 "Non-zero keys should match the count")
+  (print-string "  PASSED")
+
+  ; Test 5: sends find methods in grown class dictionaries
+  (print-string "Test 5: sends after growth")
+  (define-func (st-int-answer receiver) (tag-int 77))
+  (define-func (st-int-halve receiver) (tag-int (/ (untag-int receiver) 2)))
+  (define-var int-methods (get-methods SmallInteger-class))
+  (method-dict-add int-methods (intern-selector "halve") (function-address st-int-halve))
+  (for (i 0 150)
+    (method-dict-add int-methods (tag-int (+ 5000 i)) (function-address st-int-answer)))
+  (method-dict-add int-methods (intern-selector "answer") (function-address st-int-answer))
+  (assert-true (> (method-dict-capacity int-methods) 150) "Class dictionary should grow")
+  (assert-equal (untag-int (funcall (compile-method "3 answer" 0))) 77 "Late method")
+  (assert-equal (untag-int (funcall (compile-method "10 halve" 0))) 5 "Early method")
+  (print-string "  PASSED")
+
+  (print-string "=== Method Dictionary Tests Complete ===")
+  424242)
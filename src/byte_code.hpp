@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "function_header.hpp"
+#include "opcodes.hpp"
+
+// Byte encoding for StackVM::execute_byte_code
+//
+// The word format spends a 64-bit word on every opcode and another on every
+// immediate, so PUSH 1 takes 16 bytes. In the byte encoding:
+//   - an opcode is one byte
+//   - an immediate is signed LEB128: seven bits a byte, low bits first, the
+//     top bit set on every byte but the last. Values in [-64, 64) take one
+//     byte, 32-bit addresses five and a full word ten.
+//   - a function header is the FUNCTION byte followed by the arity and the
+//     temporaries as 16-bit little-endian fields. It is always HEADER_SIZE
+//     bytes, so a call finds it at a fixed distance in front of the entry.
+//
+// Code addresses are byte addresses into VM memory: ip, return addresses,
+// jump targets, interrupt handlers and function addresses alike. Data
+// addresses stay word addresses.
+//
+// encode() converts a word program. Jump, branch, call and fallback operands
+// are code addresses; any other word holding one (a function-address or
+// interrupt handler PUSH) must be listed in code_refs, as the compiler does in
+// CompiledProgram::code_refs. Code compiled while the VM runs (EVAL, COMPILE,
+// Smalltalk methods) is word code, which byte code can't enter: the VM only
+// calls the entry_points() of the byte code it loaded.
+
+namespace ByteCode {
+constexpr size_t HEADER_SIZE = 5;         // FUNCTION, arity:16, temporaries:16
+constexpr size_t MAX_IMMEDIATE_SIZE = 10; // ceil(64 / 7)
+
+// Bytes value takes as an immediate
+inline size_t immediate_size(uint64_t value) {
+    auto v = static_cast<int64_t>(value);
+    size_t size = 1;
+    while (v >= 64 || v < -64) {
+        v >>= 7;
+        size++;
+    }
+    return size;
+}
+
+// Append value as an immediate of at least min_size bytes; the padding is
+// more continuation bytes, which decode to the same value
+inline void write_immediate(std::vector<uint8_t>& out, uint64_t value, size_t min_size = 1) {
+    const size_t size = std::max(immediate_size(value), min_size);
+    auto v = static_cast<int64_t>(value);
+    for (size_t i = 1; i < size; i++) {
+        out.push_back(static_cast<uint8_t>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v & 0x7F));
+}
+
+// Decode the immediate at pc and advance pc past it
+inline uint64_t read_immediate(const uint8_t* code, uint64_t& pc) {
+    uint8_t byte = code[pc++];
+    if (byte < 0x40) {
+        return byte; // Small and positive: most of them
+    }
+
+    uint64_t value = byte & 0x7F;
+    unsigned shift = 7;
+    while ((byte & 0x80) != 0 && shift < 64) {
+        byte = code[pc++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        shift += 7;
+    }
+    if (shift < 64 && (byte & 0x40) != 0) {
+        value |= ~uint64_t{0} << shift; // Sign extend
+    }
+    return value;
+}
+
+inline void write_header(std::vector<uint8_t>& out, uint64_t header) {
+    const uint64_t arity = FunctionHeader::arity(header);
+    const uint64_t temporaries = FunctionHeader::temporaries(header);
+    out.push_back(static_cast<uint8_t>(Opcode::FUNCTION));
+    out.push_back(static_cast<uint8_t>(arity));
+    out.push_back(static_cast<uint8_t>(arity >> 8));
+    out.push_back(static_cast<uint8_t>(temporaries));
+    out.push_back(static_cast<uint8_t>(temporaries >> 8));
+}
+
+// Header word of the function entered at entry, or a word that isn't one
+inline uint64_t read_header(const uint8_t* code, uint64_t entry) {
+    const uint8_t* header = code + entry - HEADER_SIZE;
+    if (header[0] != static_cast<uint8_t>(Opcode::FUNCTION)) {
+        return header[0];
+    }
+    return FunctionHeader::make(header[1] | (header[2] << 8), header[3] | (header[4] << 8));
+}
+
+// Marks the offsets in code where a function is entered: just past each
+// header. code holds nothing but instructions, as encode() writes it.
+inline std::vector<bool> entry_points(const std::vector<uint8_t>& code) {
+    std::vector<bool> entries(code.size() + 1, false);
+    for (size_t pc = 0; pc < code.size();) {
+        const auto op = static_cast<Opcode>(code[pc]);
+        if (op == Opcode::FUNCTION) {
+            pc += HEADER_SIZE;
+            if (pc <= code.size()) {
+                entries[pc] = true;
+            }
+            continue;
+        }
+        pc++;
+        if (opcode_operand_count(op) == 1) {
+            while (pc < code.size() && (code[pc] & 0x80) != 0) {
+                pc++;
+            }
+            pc++;
+        }
+    }
+    return entries;
+}
+
+// Operands of these are always code addresses
+inline bool takes_code_address(Opcode op) {
+    switch (op) {
+        case Opcode::JMP:
+        case Opcode::JZ:
+        case Opcode::CALL:
+        case Opcode::TADD:
+        case Opcode::TSUB:
+        case Opcode::TMUL:
+        case Opcode::TEQ:
+        case Opcode::TLT:
+        case Opcode::TGT:
+        case Opcode::TLTE:
+        case Opcode::TGTE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Convert a word program meant to be loaded at word address word_base into
+// byte code loaded at byte address byte_base
+inline std::vector<uint8_t> encode(const std::vector<uint64_t>& words,
+                                   const std::vector<size_t>& code_refs = {},
+                                   uint64_t word_base = 0, uint64_t byte_base = 0) {
+    struct Instruction {
+        size_t pos;              // Of the opcode word
+        bool header;             // A FUNCTION header
+        bool operand;            // Followed by an immediate
+        bool code_address;       // The immediate is a code address
+        size_t operand_size;     // Bytes for the immediate
+    };
+    constexpr size_t NONE = SIZE_MAX;
+
+    auto fail = [](const std::string& what, size_t pos) {
+        throw std::runtime_error("Byte code: " + what + " at word " + std::to_string(pos));
+    };
+
+    std::vector<bool> is_code_ref(words.size(), false);
+    for (size_t pos : code_refs) {
+        if (pos >= words.size()) {
+            fail("code address outside the program", pos);
+        }
+        is_code_ref[pos] = true;
+    }
+
+    // Split the program into instructions; position words.size() is the end
+    std::vector<Instruction> program;
+    std::vector<size_t> index(words.size() + 1, NONE); // Word position -> instruction
+    for (size_t pos = 0; pos < words.size();) {
+        const uint64_t word = words[pos];
+        const auto op = static_cast<Opcode>(word & 0xFF);
+        const bool header = FunctionHeader::is_header(word);
+        if (!header && word > static_cast<uint64_t>(Opcode::FUNCTION)) {
+            fail("not an instruction", pos);
+        }
+        if (is_code_ref[pos]) {
+            fail("code address that isn't an operand", pos);
+        }
+
+        Instruction ins{pos, header, opcode_operand_count(op) == 1, false, 0};
+        if (ins.operand) {
+            if (pos + 1 >= words.size()) {
+                fail("truncated instruction", pos);
+            }
+            ins.code_address = takes_code_address(op) || is_code_ref[pos + 1];
+            ins.operand_size = ins.code_address ? 1 : immediate_size(words[pos + 1]);
+        }
+        index[pos] = program.size();
+        program.push_back(ins);
+        pos += ins.operand ? 2 : 1;
+    }
+    index[words.size()] = program.size();
+
+    std::vector<uint64_t> offsets(program.size() + 1); // Byte address of each instruction
+    auto layout = [&]() {
+        uint64_t at = byte_base;
+        for (size_t i = 0; i < program.size(); i++) {
+            offsets[i] = at;
+            at += program[i].header ? HEADER_SIZE
+                                    : 1 + (program[i].operand ? program[i].operand_size : 0);
+        }
+        offsets.back() = at;
+    };
+    auto target = [&](const Instruction& ins) {
+        const uint64_t address = words[ins.pos + 1];
+        if (address < word_base || address - word_base > words.size() ||
+            index[address - word_base] == NONE) {
+            fail("code address " + std::to_string(address) +
+                     " that isn't an instruction of the program",
+                 ins.pos);
+        }
+        return offsets[index[address - word_base]];
+    };
+
+    // A code address takes as many bytes as the layout gives its target, and
+    // that moves the targets after it: grow operands until nothing moves.
+    // Operands only grow, so this ends.
+    bool grown = true;
+    while (grown) {
+        layout();
+        grown = false;
+        for (Instruction& ins : program) {
+            if (ins.code_address) {
+                const size_t size = immediate_size(target(ins));
+                if (size > ins.operand_size) {
+                    ins.operand_size = size;
+                    grown = true;
+                }
+            }
+        }
+    }
+
+    std::vector<uint8_t> code;
+    code.reserve(offsets.back() - byte_base);
+    for (const Instruction& ins : program) {
+        const uint64_t word = words[ins.pos];
+        if (ins.header) {
+            write_header(code, word);
+            continue;
+        }
+        code.push_back(static_cast<uint8_t>(word));
+        if (ins.operand) {
+            write_immediate(code, ins.code_address ? target(ins) : words[ins.pos + 1],
+                            ins.operand_size);
+        }
+    }
+    return code;
+}
+} // namespace ByteCode
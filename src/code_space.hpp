@@ -0,0 +1,208 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <vector>
+
+// ============================================================================
+// Code Space Manager
+// ============================================================================
+// Hands out blocks of the code segment to programs loaded at run time (REPL
+// lines, EVAL and COMPILE) and takes back the ones nothing refers to any more.
+//
+// A block stays allocated while a root points anywhere inside it, or while a
+// live block refers to it. Roots are whatever the caller knows can reach
+// code: function symbols, global variable values, the VM's ip, return
+// addresses on its stack and signal handlers. A block's references are the
+// code addresses its program holds (call targets, function addresses), given
+// by set_refs when it is loaded; they keep a callee alive for the callers
+// compiled against it after its name is redefined. Everything else is dead
+// and goes onto a free list, where neighbouring free blocks merge and a free
+// block at the top of the used area gives that space back to the bump
+// pointer.
+//
+// Blocks are never moved. Code addresses are plain words that can be stored
+// anywhere in VM memory, so there is no safe way to patch every reference to
+// a block that moved; only the roots above are known. Code reachable only
+// through an address kept somewhere else (the heap, say) must also be kept
+// reachable by one of them.
+
+class CodeSpace {
+  public:
+    struct Stats {
+        uint64_t collections{0};
+        uint64_t blocks_freed{0};
+        uint64_t words_freed{0};
+    };
+
+    explicit CodeSpace(uint64_t limit) : limit(limit) {}
+
+    // Address for a block of size words: the lowest free block that fits,
+    // else the top of the used area. nullopt when neither has room.
+    std::optional<uint64_t> allocate(uint64_t size) {
+        if (size == 0) {
+            size = 1; // Every block needs an address of its own
+        }
+        for (auto it = free_blocks.begin(); it != free_blocks.end(); ++it) {
+            if (it->second >= size) {
+                const uint64_t start = it->first;
+                const uint64_t rest = it->second - size;
+                free_blocks.erase(it);
+                if (rest > 0) {
+                    free_blocks.emplace(start + size, rest);
+                }
+                return claim(start, size);
+            }
+        }
+        if (size > limit - top) {
+            return std::nullopt;
+        }
+        top += size;
+        return claim(top - size, size);
+    }
+
+    // Record the code addresses the block at start refers to
+    void set_refs(uint64_t start, std::vector<uint64_t> addrs) {
+        if (blocks.count(start) != 0) {
+            refs[start] = std::move(addrs);
+        }
+    }
+
+    // Free every block that neither holds one of roots nor is referred to by
+    // a block that is kept; returns the words freed
+    uint64_t collect(const std::vector<uint64_t>& roots) {
+        std::vector<uint64_t> live;    // Starts of the blocks reached, sorted
+        std::vector<uint64_t> pending; // Reached, references not yet followed
+        auto mark = [&](uint64_t addr) {
+            auto it = blocks.upper_bound(addr);
+            if (it == blocks.begin() || addr - std::prev(it)->first >= std::prev(it)->second) {
+                return;
+            }
+            const uint64_t start = std::prev(it)->first;
+            auto pos = std::lower_bound(live.begin(), live.end(), start);
+            if (pos == live.end() || *pos != start) {
+                live.insert(pos, start);
+                pending.push_back(start);
+            }
+        };
+        for (uint64_t root : roots) {
+            mark(root);
+        }
+        while (!pending.empty()) {
+            auto it = refs.find(pending.back());
+            pending.pop_back();
+            if (it != refs.end()) {
+                for (uint64_t addr : it->second) {
+                    mark(addr);
+                }
+            }
+        }
+
+        uint64_t freed = 0;
+        for (auto it = blocks.begin(); it != blocks.end();) {
+            if (std::binary_search(live.begin(), live.end(), it->first)) {
+                ++it;
+                continue;
+            }
+            freed += it->second;
+            stats.blocks_freed++;
+            release(it->first, it->second);
+            refs.erase(it->first);
+            it = blocks.erase(it);
+        }
+        stats.collections++;
+        stats.words_freed += freed;
+        allocated_since_collect = 0;
+        return freed;
+    }
+
+    // Is addr inside an allocated block?
+    [[nodiscard]] bool contains(uint64_t addr) const {
+        auto it = blocks.upper_bound(addr);
+        if (it == blocks.begin()) {
+            return false;
+        }
+        --it;
+        return addr - it->first < it->second;
+    }
+
+    void clear() {
+        blocks.clear();
+        free_blocks.clear();
+        refs.clear();
+        top = 0;
+        allocated_since_collect = 0;
+    }
+
+    // End of the highest block; everything above is unused
+    [[nodiscard]] uint64_t get_top() const {
+        return top;
+    }
+
+    // Words in allocated blocks
+    [[nodiscard]] uint64_t used() const {
+        uint64_t words = 0;
+        for (const auto& [start, size] : blocks) {
+            words += size;
+        }
+        return words;
+    }
+
+    [[nodiscard]] size_t block_count() const {
+        return blocks.size();
+    }
+
+    [[nodiscard]] size_t free_block_count() const {
+        return free_blocks.size();
+    }
+
+    // Words allocated since the last collection
+    [[nodiscard]] uint64_t get_allocated_since_collect() const {
+        return allocated_since_collect;
+    }
+
+    [[nodiscard]] const Stats& get_stats() const {
+        return stats;
+    }
+
+  private:
+    uint64_t limit;
+    uint64_t top{0};
+    uint64_t allocated_since_collect{0};
+    std::map<uint64_t, uint64_t> blocks;      // Start -> size, allocated
+    std::map<uint64_t, uint64_t> free_blocks; // Start -> size, never adjacent
+    std::map<uint64_t, std::vector<uint64_t>> refs; // Start -> code addresses held
+    Stats stats;
+
+    uint64_t claim(uint64_t start, uint64_t size) {
+        blocks.emplace(start, size);
+        allocated_since_collect += size;
+        return start;
+    }
+
+    // Return a block to the free list, merging it with free neighbours
+    void release(uint64_t start, uint64_t size) {
+        auto next = free_blocks.lower_bound(start);
+        if (next != free_blocks.end() && next->first == start + size) {
+            size += next->second;
+            next = free_blocks.erase(next);
+        }
+        if (next != free_blocks.begin()) {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == start) {
+                start = prev->first;
+                size += prev->second;
+                free_blocks.erase(prev);
+            }
+        }
+
+        if (start + size == top) {
+            top = start;
+        } else {
+            free_blocks.emplace(start, size);
+        }
+    }
+};
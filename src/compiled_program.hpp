@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -17,6 +18,11 @@ struct CompiledProgram {
     // Executable bytecode
     std::vector<uint64_t> bytecode;
 
+    // Positions of words holding a code address other than the operands of
+    // jumps, branches and calls (function addresses, interrupt handlers), for
+    // re-encoding the program as byte code (byte_code.hpp)
+    std::vector<size_t> code_refs;
+
     // String literal metadata for runtime initialization
     struct StringLiteral {
         std::string content; // The actual string content
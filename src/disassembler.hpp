@@ -79,6 +79,54 @@ class Disassembler {
                 return "STI";
             case Opcode::SIGNAL_REG:
                 return "SIGNAL_REG";
+            case Opcode::SEND_CACHED:
+                return "SEND_CACHED";
+            case Opcode::TADD:
+                return "TADD";
+            case Opcode::TSUB:
+                return "TSUB";
+            case Opcode::TMUL:
+                return "TMUL";
+            case Opcode::TEQ:
+                return "TEQ";
+            case Opcode::TLT:
+                return "TLT";
+            case Opcode::TGT:
+                return "TGT";
+            case Opcode::TLTE:
+                return "TLTE";
+            case Opcode::TGTE:
+                return "TGTE";
+            case Opcode::INTERN:
+                return "INTERN";
+            case Opcode::MEMCPY:
+                return "MEMCPY";
+            case Opcode::MEMMOVE:
+                return "MEMMOVE";
+            case Opcode::MEMSET:
+                return "MEMSET";
+            case Opcode::MEMCMP:
+                return "MEMCMP";
+            case Opcode::MEMCPY_BYTE:
+                return "MEMCPY_BYTE";
+            case Opcode::MEMMOVE_BYTE:
+                return "MEMMOVE_BYTE";
+            case Opcode::MEMSET_BYTE:
+                return "MEMSET_BYTE";
+            case Opcode::MEMCMP_BYTE:
+                return "MEMCMP_BYTE";
+            case Opcode::STR_EQ:
+                return "STR_EQ";
+            case Opcode::STR_HASH:
+                return "STR_HASH";
+            case Opcode::STR_INDEX:
+                return "STR_INDEX";
+            case Opcode::STR_SCAN:
+                return "STR_SCAN";
+            case Opcode::TOKENIZE:
+                return "TOKENIZE";
+            case Opcode::FUNCTION:
+                return "FUNCTION";
             default:
                 return "UNKNOWN";
         }
@@ -96,19 +144,7 @@ class Disassembler {
     }
 
     static int operand_count(Opcode op) {
-        switch (op) {
-            case Opcode::PUSH:
-            case Opcode::JMP:
-            case Opcode::JZ:
-            case Opcode::ENTER:
-            case Opcode::LEAVE:
-            case Opcode::RET:
-                return 1;
-            case Opcode::CALL:
-                return 2;
-            default:
-                return 0;
-        }
+        return opcode_operand_count(op);
     }
 
     static void disassemble(const std::vector<uint64_t>& bytecode, std::ostream& out = std::cout) {
@@ -126,6 +162,13 @@ class Disassembler {
 
             ip++;
 
+            // A header's fields share its word
+            if (op == Opcode::FUNCTION) {
+                const uint64_t header = bytecode[ip - 1];
+                out << "arity " << FunctionHeader::arity(header) << ", temporaries "
+                    << FunctionHeader::temporaries(header);
+            }
+
             // Print operands if present
             int op_count = operand_count(op);
             for (int i = 0; i < op_count && ip < bytecode.size(); i++) {
@@ -152,6 +195,56 @@ class Disassembler {
         }
     }
 
+    // Byte code (byte_code.hpp) loaded at byte address base, listed like
+    // word code with byte addresses
+    static void disassemble_bytes(const std::vector<uint8_t>& code, std::ostream& out = std::cout,
+                                  uint64_t base = 0) {
+        uint64_t ip = 0;
+        while (ip < code.size()) {
+            out << std::right << std::setw(6) << std::setfill('0') << base + ip << ": ";
+
+            const auto op = static_cast<Opcode>(code[ip]);
+            out << std::left << std::setw(12) << std::setfill(' ') << opcode_to_string(op);
+
+            if (op == Opcode::FUNCTION) {
+                if (ip + ByteCode::HEADER_SIZE > code.size()) {
+                    out << "<truncated>" << '\n';
+                    break;
+                }
+                ip += ByteCode::HEADER_SIZE;
+                const uint64_t header = ByteCode::read_header(code.data(), ip);
+                out << "arity " << FunctionHeader::arity(header) << ", temporaries "
+                    << FunctionHeader::temporaries(header) << '\n';
+                continue;
+            }
+            ip++;
+
+            if (operand_count(op) > 0) {
+                // The immediate ends at the first byte without the continuation bit
+                uint64_t end = ip;
+                while (end < code.size() && (code[end] & 0x80) != 0) {
+                    end++;
+                }
+                if (end >= code.size()) {
+                    out << "<truncated>" << '\n';
+                    break;
+                }
+
+                const uint64_t operand = ByteCode::read_immediate(code.data(), ip);
+                if (ByteCode::takes_code_address(op)) {
+                    out << "@" << operand;
+                } else {
+                    out << operand;
+                    if (operand > 9 || operand == 0) {
+                        out << " (0x" << std::hex << operand << std::dec << ")";
+                    }
+                }
+            }
+
+            out << '\n';
+        }
+    }
+
     static std::string disassemble_to_string(const std::vector<uint64_t>& bytecode) {
         std::ostringstream oss;
         disassemble(bytecode, oss);
@@ -2,11 +2,84 @@
 #include "symbol_table.hpp"
 #include <cstdint>
 #include <functional>
+#include <iterator>
+#include <optional>
 #include <string>
+#include <unordered_map>
 
 // Forward declaration
 class StackVM;
 
+// ============================================================================
+// EvalCache - Compiled code for EVAL/COMPILE, by source text
+// ============================================================================
+// Evaluating the same string again (say, in a loop) reuses the code loaded
+// the first time instead of parsing and compiling it again. Each entry
+// remembers the symbol table generation it was compiled against; once a
+// global or function is redefined or removed the generation moves on and
+// the entry is compiled afresh on its next use.
+
+class EvalCache {
+  public:
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t invalidations{0}; // Misses on an entry that had gone stale
+    };
+
+    // Code address for code compiled at this generation, if cached
+    std::optional<uint64_t> lookup(const std::string& code, uint64_t generation) {
+        auto it = entries.find(code);
+        if (it != entries.end() && it->second.generation == generation) {
+            stats.hits++;
+            return it->second.address;
+        }
+        stats.misses++;
+        if (it != entries.end()) {
+            stats.invalidations++;
+            entries.erase(it);
+        }
+        return std::nullopt;
+    }
+
+    void insert(const std::string& code, uint64_t generation, uint64_t address) {
+        entries[code] = {.generation = generation, .address = address};
+    }
+
+    void clear() {
+        entries.clear();
+    }
+
+    // Drop the entries whose code address keep rejects (code freed, say)
+    template <typename Keep> void retain(const Keep& keep) {
+        for (auto it = entries.begin(); it != entries.end();) {
+            it = keep(it->second.address) ? std::next(it) : entries.erase(it);
+        }
+    }
+
+    [[nodiscard]] size_t size() const {
+        return entries.size();
+    }
+
+    [[nodiscard]] const Stats& get_stats() const {
+        return stats;
+    }
+
+    // Fraction of lookups that hit, 0 before the first lookup
+    [[nodiscard]] double hit_rate() const {
+        const uint64_t lookups = stats.hits + stats.misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(stats.hits) / static_cast<double>(lookups);
+    }
+
+  private:
+    struct Entry {
+        uint64_t generation;
+        uint64_t address;
+    };
+    std::unordered_map<std::string, Entry> entries;
+    Stats stats;
+};
+
 // ============================================================================
 // EvalContext - Shared context for runtime eval/compile
 // ============================================================================
@@ -19,10 +92,11 @@ class StackVM;
 // - Callback is implemented in main.cpp where both headers are available
 
 struct EvalContext {
-    SymbolTable* symbols;          // Shared symbol table
-    uint64_t* next_var_address;    // Where to allocate next variable
-    uint64_t* next_string_address; // Where to allocate next string
-    uint64_t* next_code_address;   // Where to load compiled code
+    // Shared symbol table; EVAL/COMPILE results are only cached when set
+    const SymbolTable* symbols{nullptr};
+    uint64_t* next_var_address{nullptr};    // Where to allocate next variable
+    uint64_t* next_string_address{nullptr}; // Where to allocate next string
+    uint64_t* next_code_address{nullptr};   // Where to load compiled code
 
     // Callback: compile string and load into VM, return code address
     // The code ends with HALT (for eval)
@@ -31,4 +105,8 @@ struct EvalContext {
     // Callback: compile string and load into VM, return code address
     // The code ends with RET (for funcall)
     std::function<uint64_t(StackVM&, const std::string&)> compile_for_funcall;
+
+    // Code already compiled by each callback
+    EvalCache eval_cache;
+    EvalCache compile_cache;
 };
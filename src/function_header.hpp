@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory_layout.hpp"
+#include "opcodes.hpp"
+
+// Function header word for CALL, FUNCALL, SEND_CACHED and EVAL
+//
+// Every function is entered through a header word just in front of its
+// entry point, so a code address still names the function's first
+// instruction. The header carries what the call needs to build the frame:
+//
+// [ARITY:16][TEMPORARIES:16][unused:24][FUNCTION opcode:8]
+//
+// The calls read it once, push the return address, reserve the zeroed
+// temporaries and push a link word in place of the plain saved bp:
+//
+// [ARITY:16][TEMPORARIES:16][caller's bp:32]
+//
+// which is all RET needs to find the return address and drop the frame and
+// arguments, so neither CALL nor RET carries an operand. The opcode byte
+// makes a linear disassembly show the header for what it is.
+//
+// The layout is mirrored by OP_FUNCTION and emit-function-header in
+// lisp/smalltalk/06-compiler.lisp.
+
+namespace FunctionHeader {
+constexpr size_t SIZE = 1; // Words in front of the entry point
+
+constexpr uint64_t MAX_ARITY = 0xFFFF;
+constexpr uint64_t MAX_TEMPORARIES = 0xFFFF;
+
+constexpr uint64_t ARITY_SHIFT = 48;
+constexpr uint64_t TEMPORARIES_SHIFT = 32;
+constexpr uint64_t BP_MASK = 0xFFFFFFFF;
+
+static_assert(MemoryLayout::MEMORY_SIZE - 1 <= BP_MASK, "A link word must hold any bp");
+
+constexpr uint64_t make(uint64_t arity, uint64_t temporaries) {
+    return static_cast<uint64_t>(Opcode::FUNCTION) | (temporaries << TEMPORARIES_SHIFT) |
+           (arity << ARITY_SHIFT);
+}
+
+constexpr bool is_header(uint64_t word) {
+    return (word & 0xFF) == static_cast<uint64_t>(Opcode::FUNCTION);
+}
+
+// These read headers and link words alike
+constexpr uint64_t arity(uint64_t word) {
+    return word >> ARITY_SHIFT;
+}
+
+constexpr uint64_t temporaries(uint64_t word) {
+    return (word >> TEMPORARIES_SHIFT) & MAX_TEMPORARIES;
+}
+
+constexpr uint64_t link(uint64_t bp, uint64_t header) {
+    return bp | (header & ~BP_MASK);
+}
+
+constexpr uint64_t link_bp(uint64_t link) {
+    return link & BP_MASK;
+}
+} // namespace FunctionHeader
@@ -0,0 +1,208 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ============================================================================
+// Selector Intern Table
+// ============================================================================
+// Maps selector strings to small, stable ids for the INTERN opcode.
+//
+// Open addressing in the Swiss-table style: a control byte per slot holds
+// either EMPTY or the low 7 bits of the key's hash, and probing scans groups
+// of 8 control bytes at once (SWAR), so most lookups compare a single key.
+// Entries are never removed (only clear() resets the table), so there are no
+// tombstones. The table doubles at 7/8 load.
+//
+// Ids are handed out sequentially from 1; 0 means "no symbol". Bootstrap
+// code can reserve specific ids with preload(), after which sequential
+// allocation continues above the highest id in use. A fixed id may be at
+// most MAX_ID_GAP above next_id(), since names are indexed by id.
+
+class InternTable {
+  public:
+    static constexpr uint64_t NO_ID = 0;
+    static constexpr uint64_t MAX_ID_GAP = 4096;
+
+    InternTable() {
+        rehash(INITIAL_CAPACITY);
+    }
+
+    // Id for name, or NO_ID if it has not been interned
+    [[nodiscard]] uint64_t lookup(std::string_view name) const {
+        const size_t slot = find_slot(name, hash(name));
+        return ctrl[slot] == EMPTY ? NO_ID : slot_ids[slot];
+    }
+
+    // Id for name, allocating the next id if it is new
+    uint64_t intern(std::string_view name) {
+        return insert(name, NO_ID);
+    }
+
+    // Intern name with a fixed id. Returns the id, or NO_ID if name already
+    // has a different id, id belongs to another name or id is too far
+    // above next_id().
+    uint64_t intern_as(std::string_view name, uint64_t id) {
+        if (id == NO_ID || id > next + MAX_ID_GAP) {
+            return NO_ID;
+        }
+        const uint64_t existing = lookup(name);
+        if (existing != NO_ID) {
+            return existing == id ? id : NO_ID;
+        }
+        if (contains_id(id)) {
+            return NO_ID;
+        }
+        return insert(name, id);
+    }
+
+    // Bulk preload: names[i] gets id first_id + i. Returns false on the first
+    // conflict.
+    bool preload(uint64_t first_id, std::initializer_list<std::string_view> names) {
+        uint64_t id = first_id;
+        for (std::string_view name : names) {
+            if (intern_as(name, id++) == NO_ID) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool contains_id(uint64_t id) const {
+        return id < present.size() && present[id];
+    }
+
+    // Name of an interned id (empty for unknown ids)
+    [[nodiscard]] const std::string& name(uint64_t id) const {
+        static const std::string none;
+        return contains_id(id) ? names[id] : none;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return count;
+    }
+    [[nodiscard]] size_t capacity() const {
+        return ctrl.size();
+    }
+    [[nodiscard]] uint64_t next_id() const {
+        return next;
+    }
+
+    void clear() {
+        names.clear();
+        present.clear();
+        count = 0;
+        next = 1;
+        ctrl.assign(INITIAL_CAPACITY, EMPTY);
+        slot_ids.assign(INITIAL_CAPACITY, NO_ID);
+    }
+
+  private:
+    static constexpr size_t GROUP_WIDTH = 8;
+    static constexpr size_t INITIAL_CAPACITY = 64;
+    static constexpr uint8_t EMPTY = 0x80;
+    static constexpr uint64_t LSBS = 0x0101010101010101ULL;
+    static constexpr uint64_t MSBS = 0x8080808080808080ULL;
+
+    std::vector<uint8_t> ctrl;      // EMPTY or 7-bit hash fragment, one per slot
+    std::vector<uint64_t> slot_ids; // Id stored in each full slot
+    std::vector<std::string> names; // Indexed by id
+    std::vector<bool> present;      // Indexed by id
+    size_t count{0};
+    uint64_t next{1};
+
+    static uint64_t hash(std::string_view name) {
+        // Mix so the control fragment (low bits) and group index (high bits)
+        // are independent
+        const uint64_t h = std::hash<std::string_view>{}(name);
+        return h * 0x9E3779B97F4A7C15ULL;
+    }
+
+    static uint8_t fragment(uint64_t h) {
+        return static_cast<uint8_t>(h & 0x7F);
+    }
+
+    [[nodiscard]] uint64_t load_group(size_t group) const {
+        uint64_t word = 0;
+        std::memcpy(&word, &ctrl[group * GROUP_WIDTH], GROUP_WIDTH);
+        return word;
+    }
+
+    // Bytes of word equal to byte, as a mask of high bits (may report false
+    // positives above a real match; callers compare the key anyway)
+    static uint64_t match_byte(uint64_t word, uint8_t byte) {
+        const uint64_t x = word ^ (LSBS * byte);
+        return (x - LSBS) & ~x & MSBS;
+    }
+
+    // Slot holding name, or the empty slot where it would be inserted
+    [[nodiscard]] size_t find_slot(std::string_view name, uint64_t h) const {
+        const size_t groups = ctrl.size() / GROUP_WIDTH;
+        size_t group = static_cast<size_t>(h >> 32) & (groups - 1);
+        for (size_t step = 1;; step++) {
+            const uint64_t word = load_group(group);
+            for (uint64_t m = match_byte(word, fragment(h)); m != 0; m &= m - 1) {
+                const size_t slot = group * GROUP_WIDTH + __builtin_ctzll(m) / 8;
+                if (ctrl[slot] != EMPTY && names[slot_ids[slot]] == name) {
+                    return slot;
+                }
+            }
+            const uint64_t empty = word & MSBS;
+            if (empty != 0) {
+                return group * GROUP_WIDTH + __builtin_ctzll(empty) / 8;
+            }
+            group = (group + step) & (groups - 1); // Triangular probing over groups
+        }
+    }
+
+    uint64_t insert(std::string_view name, uint64_t id) {
+        const uint64_t h = hash(name);
+        size_t slot = find_slot(name, h);
+        if (ctrl[slot] != EMPTY) {
+            return slot_ids[slot];
+        }
+
+        if ((count + 1) * 8 > ctrl.size() * 7) {
+            rehash(ctrl.size() * 2);
+            slot = find_slot(name, h);
+        }
+
+        if (id == NO_ID) {
+            id = next;
+        }
+        if (id >= names.size()) {
+            names.resize(id + 1);
+            present.resize(id + 1, false);
+        }
+        names[id] = std::string(name);
+        present[id] = true;
+        next = std::max(next, id + 1);
+
+        ctrl[slot] = fragment(h);
+        slot_ids[slot] = id;
+        count++;
+        return id;
+    }
+
+    void rehash(size_t new_capacity) {
+        std::vector<uint8_t> old_ctrl = std::move(ctrl);
+        std::vector<uint64_t> old_ids = std::move(slot_ids);
+        ctrl.assign(new_capacity, EMPTY);
+        slot_ids.assign(new_capacity, NO_ID);
+
+        for (size_t i = 0; i < old_ctrl.size(); i++) {
+            if (old_ctrl[i] != EMPTY) {
+                const std::string& key = names[old_ids[i]];
+                const uint64_t h = hash(key);
+                const size_t slot = find_slot(key, h);
+                ctrl[slot] = fragment(h);
+                slot_ids[slot] = old_ids[i];
+            }
+        }
+    }
+};
@@ -52,6 +52,12 @@ class InterruptHandling {
         }
     }
 
+    // Mark sig pending as if it had been delivered, for events the VM
+    // detects itself (I/O readiness)
+    static void post(int sig) {
+        handler(sig);
+    }
+
     static bool has_event() {
         return signal_event.load(std::memory_order_acquire) > 0;
     }
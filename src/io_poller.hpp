@@ -0,0 +1,167 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <csignal>
+#include <cstdint>
+#include <deque>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <unordered_set>
+#include <utility>
+
+#include "interrupt.hpp"
+
+// ============================================================================
+// I/O Readiness Poller
+// ============================================================================
+// epoll-backed readiness tracking for the I/O C_CALLs. Programs register
+// file descriptors with watch(); they are switched to nonblocking mode and
+// registered edge-triggered, so each fd is reported once per new batch of
+// data and the reader drains it until read answers EAGAIN.
+//
+// Readiness is collected by poll() into a FIFO of [fd, events] records.
+// The VM polls without blocking every IO_POLL_INTERVAL instructions, and once
+// a SIGIO handler is registered with SIGNAL_REG the poller keeps one SIGIO
+// pending in InterruptHandling while records are queued, so they reach the
+// handler through the VM's ordinary interrupt check. The handler drains the
+// queue with next(). A program with nothing else to do blocks in poll()
+// through the io-wait C_CALL instead of spinning.
+
+class IoPoller {
+  public:
+    static constexpr uint64_t READABLE = 1;
+    static constexpr uint64_t WRITABLE = 2;
+
+    IoPoller() = default;
+
+    ~IoPoller() {
+        if (epoll_fd >= 0) {
+            close(epoll_fd);
+        }
+    }
+
+    IoPoller(const IoPoller&) = delete;
+    IoPoller& operator=(const IoPoller&) = delete;
+
+    // Watch fd for the READABLE/WRITABLE bits in events; 0 stops watching.
+    // Returns 0, or -1 with errno set.
+    int watch(int fd, uint64_t events) {
+        if (events == 0) {
+            if (watched.erase(fd) == 0) {
+                errno = ENOENT;
+                return -1;
+            }
+            return epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        }
+        if (epoll_fd < 0) {
+            epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+            if (epoll_fd < 0) {
+                return -1;
+            }
+        }
+
+        const int flags = fcntl(fd, F_GETFL);
+        if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+            return -1;
+        }
+
+        struct epoll_event event{};
+        event.events = EPOLLET;
+        if ((events & READABLE) != 0) {
+            event.events |= EPOLLIN | EPOLLRDHUP;
+        }
+        if ((events & WRITABLE) != 0) {
+            event.events |= EPOLLOUT;
+        }
+        event.data.fd = fd;
+
+        // An fd closed behind our back left the epoll set with it, so a
+        // reused number is added afresh
+        const bool known = watched.count(fd) != 0;
+        if (epoll_ctl(epoll_fd, known ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event) != 0 &&
+            (!known || errno != ENOENT || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)) {
+            return -1;
+        }
+        watched.insert(fd);
+        return 0;
+    }
+
+    // Drop fd, which is about to be closed, and any readiness queued for it
+    void forget(int fd) {
+        if (watched.erase(fd) == 0) {
+            return;
+        }
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        ready.erase(std::remove_if(ready.begin(), ready.end(),
+                                   [fd](const auto& record) { return record.first == fd; }),
+                    ready.end());
+        update_signal();
+    }
+
+    // Raise SIGIO for queued records from now on (a handler was registered)
+    void set_signaling(bool on) {
+        signaling = on;
+        update_signal();
+    }
+
+    // Queue readiness, waiting up to timeout_ms (-1 blocks, 0 just checks).
+    // Returns the number of queued records.
+    size_t poll(int timeout_ms) {
+        if (epoll_fd < 0 || watched.empty()) {
+            return ready.size();
+        }
+        struct epoll_event events[MAX_EVENTS];
+        const int n = epoll_wait(epoll_fd, events, MAX_EVENTS, timeout_ms);
+        for (int i = 0; i < n; i++) {
+            uint64_t bits = 0;
+            // Hangups and errors are reported as readable so the reader sees
+            // EOF or the error from read()
+            if ((events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0) {
+                bits |= READABLE;
+            }
+            if ((events[i].events & EPOLLOUT) != 0) {
+                bits |= WRITABLE;
+            }
+            const int fd = events[i].data.fd;
+            ready.emplace_back(fd, bits);
+        }
+        update_signal();
+        return ready.size();
+    }
+
+    // Pop the oldest readiness record
+    bool next(int& fd, uint64_t& events) {
+        if (ready.empty()) {
+            return false;
+        }
+        fd = ready.front().first;
+        events = ready.front().second;
+        ready.pop_front();
+        update_signal();
+        return true;
+    }
+
+  private:
+    static constexpr int MAX_EVENTS = 64;
+
+    // Keep exactly one SIGIO pending while records are queued. Taking the
+    // interrupt consumes it, and next() raises it again if records remain.
+    void update_signal() const {
+        if (!signaling) {
+            return;
+        }
+        const bool pending = InterruptHandling::get_count(SIGIO) > 0;
+        if (!ready.empty() && !pending) {
+            InterruptHandling::post(SIGIO);
+        } else if (ready.empty() && pending) {
+            InterruptHandling::consumme(SIGIO);
+        }
+    }
+
+    int epoll_fd{-1};
+    bool signaling{false};
+    std::unordered_set<int> watched;
+    std::deque<std::pair<int, uint64_t>> ready;
+};
@@ -1,11 +1,16 @@
 #pragma once
+#include "lisp_module.hpp"
 #include "lisp_parser.hpp"
 #include "stack_vm.hpp"
 #include "symbol_table.hpp"
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <optional>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 class LispCompiler {
@@ -13,39 +18,113 @@ class LispCompiler {
     std::vector<uint64_t> bytecode;
     std::map<std::string, uint64_t> labels;
     std::vector<std::pair<size_t, std::string>> label_refs;
+    std::vector<size_t> code_refs; // See note_code_ref
 
     struct Variable {
         bool is_global;
         uint64_t addr;
+        bool is_argument{false}; // Frame slot is addr past the temporaries
     };
 
-    // Environment management - stack of scopes
+    // Environment management - stack of scopes. Bindings are kept per
+    // interned symbol id: bindings[id] is a stack whose back is the innermost
+    // binding, so a lookup is one index however deep the nesting. Each scope
+    // lists the ids it bound so closing it pops exactly those.
+    struct Binding {
+        Variable var;
+        size_t depth; // Number of scopes open when it was bound
+    };
     struct Scope {
-        std::map<std::string, Variable> variables;
+        std::vector<uint32_t> symbols;
     };
 
+    // While a function body is compiled, let, for and define-var bind frame
+    // temporaries instead of globals. Temporaries sit between bp and the
+    // arguments, so argument slots are patched once their number is known.
     bool is_in_function{false};
     std::vector<Scope> scopes;
+    std::vector<std::vector<Binding>> bindings;
     uint64_t next_var_address;
     uint64_t function_local_var_index{0};
-    uint64_t function_temporary_var_index{0};
+    uint64_t function_temporary_var_index{0}; // Next free; reused once a scope ends
+    uint64_t function_temporary_var_count{0}; // Most in use at once: the frame's size
+    std::vector<size_t> argument_refs;        // Words holding an argument slot
 
-    // Function definitions
+    // Function definitions, kept in name order (which sets their layout in
+    // the code) and indexed by symbol id for the lookup on every call
     struct Function {
         std::vector<std::string> params;
+        std::vector<uint32_t> param_ids;
         ASTNodePtr body;
         uint64_t code_address{};
+        uint64_t generation{0}; // Compile that defined it (incremental mode)
     };
     std::map<std::string, Function> functions;
+    std::vector<Function*> functions_by_id;
+
+    // Function and interrupt bodies are compiled again by every later
+    // compile() on this compiler, so they are copied out of the parser's
+    // arena, which may be gone by then
+    ASTArena bodies;
 
     // Interrupt handler definitions
     struct Interrupt {
         uint64_t signal_number;
         ASTNodePtr body;
         uint64_t code_address{};
+        uint64_t generation{0};
     };
     std::map<uint64_t, Interrupt> interrupts;
 
+    // Incremental mode (see set_incremental): every compile is a new
+    // generation that only emits what it defines itself, and is undone if it
+    // throws. The undo log is what this generation defined or replaced.
+    bool incremental{false};
+    uint64_t generation{0};
+    struct Undo {
+        uint64_t next_var_address{0};
+        uint64_t next_string_address{0};
+        size_t globals{0}; // Global scope bindings before this compile
+        size_t strings{0}; // String table entries before this compile
+        std::vector<std::pair<std::string, std::optional<Function>>> functions;
+        std::vector<std::pair<uint64_t, std::optional<Interrupt>>> interrupts;
+    } undo;
+
+    // Function units (see compile_units). A unit is one function body
+    // compiled on a worker thread into a buffer of its own, as if loaded at
+    // address 0; whatever depends on the units before it is left as a
+    // relocation and filled in when the units are laid out in order. A
+    // module (compile_module) is compiled as one unit that also imports
+    // variables.
+    struct Unit {
+        enum class State : uint8_t { COMPILED, SERIAL, FAILED };
+        State state{State::COMPILED};
+        std::vector<uint64_t> code;
+        std::vector<size_t> code_relocs; // Words holding a unit-relative code address
+        std::vector<size_t> code_refs;   // Pushed code addresses (CompiledProgram::code_refs)
+        std::vector<std::pair<size_t, std::string>> calls;   // Function address words
+        std::vector<std::pair<size_t, std::string>> strings; // String literal address words
+        std::vector<std::pair<size_t, uint64_t>> globals;    // Global variable words, by index
+        std::vector<std::pair<size_t, std::string>> imports; // Imported variable words
+        std::vector<std::string> import_names;               // By UNIT_IMPORTS index
+        uint64_t global_count{0};
+        bool module{false};
+        std::set<uint32_t> forms; // A module's form heads that no function took
+    };
+    Unit* unit{nullptr}; // Set while compiling a unit
+    size_t compile_threads{0};
+
+    // Unit-allocated globals are numbered from here until they are placed,
+    // and a module's imported variables from UNIT_IMPORTS
+    static constexpr uint64_t UNIT_GLOBALS = uint64_t{1} << 62;
+    static constexpr uint64_t UNIT_IMPORTS = uint64_t{1} << 61;
+    // Fewer functions than this are not worth starting threads for
+    static constexpr size_t PARALLEL_MIN_FUNCTIONS = 64;
+
+    // Thrown by forms whose code depends on what serial compilation has
+    // placed so far; the unit is then compiled serially in its turn
+    struct SerialOnly {};
+
     // String literal table (for compile-time string allocation)
     struct StringLiteral {
         std::string content;
@@ -84,6 +163,66 @@ class LispCompiler {
         return code_base_address + bytecode.size();
     }
 
+    // Emit, or patch in the current address as, a code address in this
+    // program; function units record these for relocation
+    void emit_code_address(uint64_t addr) {
+        if (unit != nullptr) {
+            unit->code_relocs.push_back(current_address());
+        }
+        emit(addr);
+    }
+
+    // A PUSH operand holding a code address, which a change of encoding
+    // must remap like jump and call operands (CompiledProgram::code_refs)
+    void note_code_ref(size_t pos) {
+        (unit != nullptr ? unit->code_refs : code_refs).push_back(pos);
+    }
+
+    void patch_code_address(size_t pos) {
+        if (unit != nullptr) {
+            unit->code_relocs.push_back(pos);
+        }
+        bytecode[pos] = current_absolute_address();
+    }
+
+    // Emit a variable's address, global or frame-relative
+    void emit_variable_address(uint64_t addr) {
+        if (unit != nullptr && addr >= UNIT_GLOBALS) {
+            unit->globals.emplace_back(current_address(), addr - UNIT_GLOBALS);
+            addr = 0;
+        } else if (unit != nullptr && addr >= UNIT_IMPORTS) {
+            unit->imports.emplace_back(current_address(), unit->import_names[addr - UNIT_IMPORTS]);
+            addr = 0;
+        }
+        emit(addr);
+    }
+
+    void emit_variable_address(const Variable& var) {
+        if (var.is_argument) {
+            argument_refs.push_back(current_address());
+        }
+        emit_variable_address(var.addr);
+    }
+
+    // Push a variable's value, or pop the top of the stack into it
+    void emit_load(const Variable& var) {
+        emit_opcode(Opcode::PUSH);
+        emit_variable_address(var);
+        emit_opcode(var.is_global ? Opcode::LOAD : Opcode::BP_LOAD);
+    }
+
+    void emit_store(const Variable& var) {
+        emit_opcode(Opcode::PUSH);
+        emit_variable_address(var);
+        emit_opcode(var.is_global ? Opcode::STORE : Opcode::BP_STORE);
+    }
+
+    void require_serial() const {
+        if (unit != nullptr) {
+            throw SerialOnly{};
+        }
+    }
+
     // Push a new scope
     void push_scope() {
         scopes.emplace_back();
@@ -95,71 +234,84 @@ class LispCompiler {
             throw std::runtime_error("Cannot pop empty scope");
         }
 
+        for (uint32_t id : scopes.back().symbols) {
+            bindings[id].pop_back();
+        }
         scopes.pop_back();
     }
 
+    void clear_scopes() {
+        scopes.clear();
+        bindings.clear();
+    }
+
     // Look up variable in current and parent scopes
-    std::optional<Variable> lookup_variable(const std::string& name) {
-        // Search from innermost to outermost scope
-        for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
-            auto var_it = it->variables.find(name);
-            if (var_it != it->variables.end()) {
-                return var_it->second;
-            }
+    std::optional<Variable> lookup_variable(uint32_t id) const {
+        if (id < bindings.size() && !bindings[id].empty()) {
+            return bindings[id].back().var;
         }
         return {};
     }
 
-    // Define global variable in current scope
-    uint64_t define_variable(const std::string& name) {
+    Function* lookup_function(uint32_t id) const {
+        return id < functions_by_id.size() ? functions_by_id[id] : nullptr;
+    }
+
+    // Bind id in the current scope
+    void bind(uint32_t id, Variable var) {
         if (scopes.empty()) {
             throw std::runtime_error("No active scope");
         }
+        if (id >= bindings.size()) {
+            bindings.resize(id + 1);
+        }
 
-        auto& current_scope = scopes.back();
-        if (current_scope.variables.find(name) != current_scope.variables.end()) {
-            throw std::runtime_error("Variable already defined in current scope: " + name);
+        auto& stack = bindings[id];
+        if (!stack.empty() && stack.back().depth == scopes.size()) {
+            throw std::runtime_error("Variable already defined in current scope: " +
+                                     std::string(LispSymbols::name(id)));
         }
+        stack.push_back({.var = var, .depth = scopes.size()});
+        scopes.back().symbols.push_back(id);
+    }
 
-        uint64_t addr = next_var_address++;
-        current_scope.variables[name] = {.is_global = true, .addr = addr};
+    // Define global variable in current scope
+    uint64_t define_variable(uint32_t id) {
+        uint64_t addr = unit != nullptr ? UNIT_GLOBALS + unit->global_count++ : next_var_address++;
+        bind(id, {.is_global = true, .addr = addr});
 
         // Export global variable to symbol table (only at global scope level)
         if (scopes.size() == 1) {
-            exported_symbols.define_variable(name, addr);
+            exported_symbols.define_variable(std::string(LispSymbols::name(id)), addr);
         }
 
         return addr;
     }
 
-    uint64_t define_argument_variable(const std::string& name) {
-        if (scopes.empty()) {
-            throw std::runtime_error("No active scope");
-        }
-
-        auto& current_scope = scopes.back();
-        if (current_scope.variables.find(name) != current_scope.variables.end()) {
-            throw std::runtime_error("Variable already defined in current scope: " + name);
-        }
-
-        uint64_t addr = function_local_var_index++;
-        current_scope.variables[name] = {.is_global = false, .addr = addr};
+    // The caller's arguments sit above the return address, the last one nearest
+    uint64_t define_argument_variable(uint32_t id, uint64_t arg_count) {
+        uint64_t addr = arg_count - function_local_var_index;
+        bind(id, {.is_global = false, .addr = addr, .is_argument = true});
+        function_local_var_index++;
         return addr;
     }
 
-    uint64_t define_temporary_variable(const std::string& name) {
-        if (scopes.empty()) {
-            throw std::runtime_error("No active scope");
-        }
+    uint64_t define_temporary_variable(uint32_t id) {
+        uint64_t addr = function_temporary_var_index;
+        bind(id, {.is_global = false, .addr = addr});
+        function_temporary_var_index++;
+        function_temporary_var_count =
+            std::max(function_temporary_var_count, function_temporary_var_index);
+        return addr;
+    }
 
-        auto& current_scope = scopes.back();
-        if (current_scope.variables.find(name) != current_scope.variables.end()) {
-            throw std::runtime_error("Variable already defined in current scope: " + name);
+    // A variable for let, for or define-var: a frame temporary in a function
+    // body, else a global
+    Variable define_local_variable(uint32_t id) {
+        if (is_in_function) {
+            return {.is_global = false, .addr = define_temporary_variable(id)};
         }
-
-        uint64_t addr = function_temporary_var_index++;
-        current_scope.variables[name] = {.is_global = false, .addr = addr};
-        return addr;
+        return {.is_global = true, .addr = define_variable(id)};
     }
 
     void compile_expr(const ASTNodePtr& node) {
@@ -171,25 +323,18 @@ class LispCompiler {
 
             case NodeType::STRING: {
                 // Compile string literal to memory allocation
-                std::string str = node->as_string();
+                std::string str(node->as_string());
                 compile_string_literal(str);
                 break;
             }
 
             case NodeType::SYMBOL: {
-                std::string sym = node->as_symbol();
-
-                std::optional<Variable> addr = lookup_variable(sym);
+                std::optional<Variable> addr = lookup_variable(node->symbol_id());
                 if (addr) {
-                    emit_opcode(Opcode::PUSH);
-                    emit(addr->addr);
-                    if (addr->is_global) {
-                        emit_opcode(Opcode::LOAD);
-                    } else {
-                        emit_opcode(Opcode::BP_LOAD);
-                    }
+                    emit_load(*addr);
                 } else {
-                    if (functions.find(sym) != functions.end()) {
+                    std::string sym(node->as_symbol());
+                    if (lookup_function(node->symbol_id()) != nullptr) {
                         throw std::runtime_error("Cannot use function as value: " + sym);
                     }
 
@@ -209,227 +354,337 @@ class LispCompiler {
                     throw std::runtime_error("First element of list must be a symbol");
                 }
 
-                std::string op = items[0]->as_symbol();
+                compile_form(items);
+                break;
+            }
+        }
+    }
 
-                // Check if it's a function call
-                if (functions.find(op) != functions.end()) {
-                    compile_function_call(op, items);
-                    return;
-                }
+    // A list headed by a symbol: a call to a defined function (which takes
+    // precedence), or a special form, dispatched on the interned id
+    void compile_form(const ASTList& items) {
+        const uint32_t op = items[0]->symbol_id();
 
-                // Variable binding forms
-                if (op == "define-func") {
-                    compile_define_function(items);
-                } else if (op == "define-int") {
-                    compile_define_interrupt(items);
-                } else if (op == "define-var") {
-                    compile_define_variable(items);
-                } else if (op == "set") {
-                    compile_set(items);
-                } else if (op == "let") {
-                    compile_let(items);
-                }
-                // Loop constructs
-                else if (op == "while") {
-                    compile_while(items);
-                } else if (op == "for") {
-                    compile_for(items);
-                }
-                // Memory primitives
-                else if (op == "peek") {
-                    compile_peek(items);
-                } else if (op == "poke") {
-                    compile_poke(items);
-                } else if (op == "peek-byte") {
-                    compile_peek_byte(items);
-                } else if (op == "poke-byte") {
-                    compile_poke_byte(items);
-                } else if (op == "peek32") {
-                    compile_peek32(items);
-                } else if (op == "poke32") {
-                    compile_poke32(items);
-                }
-                // C function call primitive
-                else if (op == "c-call") {
-                    compile_c_call(items);
-                }
-                // Basic arithmetic operators
-                else if (op == "+") {
-                    compile_binary_op(items, Opcode::ADD, "+", true);
-                } else if (op == "-") {
-                    compile_binary_op(items, Opcode::SUB, "-", true);
-                } else if (op == "*") {
-                    compile_binary_op(items, Opcode::MUL, "*", true);
-                } else if (op == "/") {
-                    compile_binary_op(items, Opcode::DIV, "/", true);
-                } else if (op == "%") {
-                    compile_binary_op(items, Opcode::MOD, "%");
-                }
-                // Comparison operators
-                else if (op == "=") {
-                    compile_binary_op(items, Opcode::EQ, "=");
-                } else if (op == "<") {
-                    compile_binary_op(items, Opcode::LT, "<");
-                } else if (op == ">") {
-                    compile_binary_op(items, Opcode::GT, ">");
-                } else if (op == "<=") {
-                    compile_binary_op(items, Opcode::LTE, "<=");
-                } else if (op == ">=") {
-                    compile_binary_op(items, Opcode::GTE, ">=");
-                }
-                // Control flow
-                else if (op == "if") {
-                    if (items.size() != 4)
-                        throw std::runtime_error("if requires 3 arguments: condition, then, else");
+        // Check if it's a function call
+        if (Function* func = lookup_function(op)) {
+            compile_function_call(std::string(items[0]->as_symbol()), *func, items);
+            return;
+        }
+        if (unit != nullptr && unit->module) {
+            unit->forms.insert(op);
+        }
 
-                    compile_expr(items[1]); // condition
+        switch (op) {
+            // Variable binding forms
+            case LispSymbols::DEFINE_FUNC:
+                compile_define_function(items);
+                break;
+            case LispSymbols::DEFINE_INT:
+                compile_define_interrupt(items);
+                break;
+            case LispSymbols::DEFINE_VAR:
+                compile_define_variable(items);
+                break;
+            case LispSymbols::SET:
+                compile_set(items);
+                break;
+            case LispSymbols::LET:
+                compile_let(items);
+                break;
 
-                    emit_opcode(Opcode::JZ);
-                    size_t else_jump = current_address();
-                    emit(0); // placeholder for else branch address
+            // Loop constructs
+            case LispSymbols::WHILE:
+                compile_while(items);
+                break;
+            case LispSymbols::FOR:
+                compile_for(items);
+                break;
+
+            // Memory primitives
+            case LispSymbols::PEEK:
+                compile_peek(items);
+                break;
+            case LispSymbols::POKE:
+                compile_poke(items);
+                break;
+            case LispSymbols::PEEK_BYTE:
+                compile_peek_byte(items);
+                break;
+            case LispSymbols::POKE_BYTE:
+                compile_poke_byte(items);
+                break;
+            case LispSymbols::PEEK32:
+                compile_peek32(items);
+                break;
+            case LispSymbols::POKE32:
+                compile_poke32(items);
+                break;
 
-                    compile_expr(items[2]); // then branch
+            // C function call primitive
+            case LispSymbols::C_CALL:
+                compile_c_call(items);
+                break;
 
-                    emit_opcode(Opcode::JMP);
-                    size_t end_jump = current_address();
-                    emit(0); // placeholder for end address
+            // Native selector interning
+            case LispSymbols::INTERN:
+                compile_intern(items);
+                break;
 
-                    bytecode[else_jump] = current_absolute_address(); // patch else jump
-                    compile_expr(items[3]);                           // else branch
+            // Bulk memory operations
+            case LispSymbols::MEM_COPY:
+                compile_mem_op(items, Opcode::MEMCPY, "mem-copy");
+                break;
+            case LispSymbols::MEM_MOVE:
+                compile_mem_op(items, Opcode::MEMMOVE, "mem-move");
+                break;
+            case LispSymbols::MEM_SET:
+                compile_mem_op(items, Opcode::MEMSET, "mem-set");
+                break;
+            case LispSymbols::MEM_COMPARE:
+                compile_mem_op(items, Opcode::MEMCMP, "mem-compare");
+                break;
+            case LispSymbols::MEM_COPY_BYTES:
+                compile_mem_op(items, Opcode::MEMCPY_BYTE, "mem-copy-bytes");
+                break;
+            case LispSymbols::MEM_MOVE_BYTES:
+                compile_mem_op(items, Opcode::MEMMOVE_BYTE, "mem-move-bytes");
+                break;
+            case LispSymbols::MEM_SET_BYTES:
+                compile_mem_op(items, Opcode::MEMSET_BYTE, "mem-set-bytes");
+                break;
+            case LispSymbols::MEM_COMPARE_BYTES:
+                compile_mem_op(items, Opcode::MEMCMP_BYTE, "mem-compare-bytes");
+                break;
 
-                    bytecode[end_jump] = current_absolute_address(); // patch end jump
-                }
-                // Sequential evaluation
-                else if (op == "do") {
-                    if (items.size() < 2)
-                        throw std::runtime_error("do requires at least 1 expression");
-                    for (size_t i = 1; i < items.size(); i++) {
-                        compile_expr(items[i]);
-                        if (i < items.size() - 1) {
-                            emit_opcode(Opcode::POP); // discard intermediate values
-                        }
-                    }
-                }
-                // Print (for debugging)
-                else if (op == "print" || op == "print-int") {
-                    if (items.size() != 2)
-                        throw std::runtime_error("print requires exactly 1 argument");
-                    compile_expr(items[1]);
-                    emit_opcode(Opcode::PRINT);
-                } else if (op == "print-string") {
-                    if (items.size() != 2)
-                        throw std::runtime_error("print-string requires exactly 1 argument");
-                    compile_expr(items[1]);
-                    emit_opcode(Opcode::PRINT_STR);
-                } else if (op == "abort") {
-                    if (items.size() != 2)
-                        throw std::runtime_error("abort requires exactly 1 argument");
-                    compile_expr(items[1]);
-                    emit_opcode(Opcode::ABORT);
-                }
-                // Bitwise operations
-                else if (op == "bit-and") {
-                    compile_binary_op(items, Opcode::AND, "bit-and");
-                } else if (op == "bit-or") {
-                    compile_binary_op(items, Opcode::OR, "bit-or");
-                } else if (op == "bit-xor") {
-                    compile_binary_op(items, Opcode::XOR, "bit-xor");
-                } else if (op == "bit-shl") {
-                    compile_binary_op(items, Opcode::SHL, "bit-shl");
-                } else if (op == "bit-shr") {
-                    compile_binary_op(items, Opcode::SHR, "bit-shr");
-                } else if (op == "bit-ashr") {
-                    compile_binary_op(items, Opcode::ASHR, "bit-ashr");
-                }
-                // Function address (get pointer to compiled function)
-                else if (op == "function-address") {
-                    if (items.size() != 2)
-                        throw std::runtime_error("function-address requires exactly 1 argument");
+            // Packed string primitives
+            case LispSymbols::STR_EQUAL:
+                compile_string_op(items, Opcode::STR_EQ, "str-equal", 2);
+                break;
+            case LispSymbols::STR_HASH:
+                compile_string_op(items, Opcode::STR_HASH, "str-hash", 1);
+                break;
+            case LispSymbols::STR_INDEX:
+                compile_string_op(items, Opcode::STR_INDEX, "str-index", 3);
+                break;
+            case LispSymbols::STR_SCAN:
+                compile_string_op(items, Opcode::STR_SCAN, "str-scan", 3);
+                break;
+            case LispSymbols::TOKENIZE_INTO:
+                compile_string_op(items, Opcode::TOKENIZE, "tokenize-into", 3);
+                break;
 
-                    if (items[1]->type != NodeType::SYMBOL) {
-                        throw std::runtime_error("function-address argument must be a symbol");
-                    }
+            // Basic arithmetic operators
+            case LispSymbols::ADD:
+                compile_binary_op(items, Opcode::ADD, "+", true);
+                break;
+            case LispSymbols::SUB:
+                compile_binary_op(items, Opcode::SUB, "-", true);
+                break;
+            case LispSymbols::MUL:
+                compile_binary_op(items, Opcode::MUL, "*", true);
+                break;
+            case LispSymbols::DIV:
+                compile_binary_op(items, Opcode::DIV, "/", true);
+                break;
+            case LispSymbols::MOD:
+                compile_binary_op(items, Opcode::MOD, "%");
+                break;
+
+            // Comparison operators
+            case LispSymbols::EQ:
+                compile_binary_op(items, Opcode::EQ, "=");
+                break;
+            case LispSymbols::LT:
+                compile_binary_op(items, Opcode::LT, "<");
+                break;
+            case LispSymbols::GT:
+                compile_binary_op(items, Opcode::GT, ">");
+                break;
+            case LispSymbols::LTE:
+                compile_binary_op(items, Opcode::LTE, "<=");
+                break;
+            case LispSymbols::GTE:
+                compile_binary_op(items, Opcode::GTE, ">=");
+                break;
 
-                    std::string func_name = items[1]->as_symbol();
+            // Control flow
+            case LispSymbols::IF: {
+                if (items.size() != 4)
+                    throw std::runtime_error("if requires 3 arguments: condition, then, else");
 
-                    // Check that function exists (will be compiled later)
-                    if (functions.find(func_name) == functions.end()) {
-                        throw std::runtime_error("Unknown function: " + func_name);
-                    }
+                compile_expr(items[1]); // condition
 
-                    // Emit PUSH with placeholder address, will be patched later
-                    emit_opcode(Opcode::PUSH);
-                    label_refs.emplace_back(current_address(), func_name);
-                    emit(0); // Placeholder
-                }
-                // Dynamic function call via FUNCALL opcode
-                else if (op == "funcall") {
-                    // Syntax: (funcall target-address arg1 arg2 ... argN)
-                    // Stack layout: [arg1] [arg2] ... [argN] [arg_count] [target_address]
-                    if (items.size() < 2)
-                        throw std::runtime_error(
-                            "funcall requires at least 1 argument (target address)");
-
-                    // Compile all arguments first (they go on the stack)
-                    size_t num_args = items.size() - 2; // Exclude 'funcall' and target-address
-                    for (size_t i = 2; i < items.size(); i++) {
-                        compile_expr(items[i]);
+                emit_opcode(Opcode::JZ);
+                size_t else_jump = current_address();
+                emit(0); // placeholder for else branch address
+
+                compile_expr(items[2]); // then branch
+
+                emit_opcode(Opcode::JMP);
+                size_t end_jump = current_address();
+                emit(0); // placeholder for end address
+
+                patch_code_address(else_jump); // patch else jump
+                compile_expr(items[3]);        // else branch
+
+                patch_code_address(end_jump); // patch end jump
+                break;
+            }
+
+            // Sequential evaluation
+            case LispSymbols::DO:
+                if (items.size() < 2)
+                    throw std::runtime_error("do requires at least 1 expression");
+                for (size_t i = 1; i < items.size(); i++) {
+                    compile_expr(items[i]);
+                    if (i < items.size() - 1) {
+                        emit_opcode(Opcode::POP); // discard intermediate values
                     }
+                }
+                break;
 
-                    // Push arg count
-                    emit_opcode(Opcode::PUSH);
-                    emit(num_args);
+            // Print (for debugging)
+            case LispSymbols::PRINT:
+            case LispSymbols::PRINT_INT:
+                if (items.size() != 2)
+                    throw std::runtime_error("print requires exactly 1 argument");
+                compile_expr(items[1]);
+                emit_opcode(Opcode::PRINT);
+                break;
+            case LispSymbols::PRINT_STRING:
+                if (items.size() != 2)
+                    throw std::runtime_error("print-string requires exactly 1 argument");
+                compile_expr(items[1]);
+                emit_opcode(Opcode::PRINT_STR);
+                break;
+            case LispSymbols::ABORT:
+                if (items.size() != 2)
+                    throw std::runtime_error("abort requires exactly 1 argument");
+                compile_expr(items[1]);
+                emit_opcode(Opcode::ABORT);
+                break;
 
-                    // Push target address
-                    compile_expr(items[1]);
+            // Bitwise operations
+            case LispSymbols::BIT_AND:
+                compile_binary_op(items, Opcode::AND, "bit-and");
+                break;
+            case LispSymbols::BIT_OR:
+                compile_binary_op(items, Opcode::OR, "bit-or");
+                break;
+            case LispSymbols::BIT_XOR:
+                compile_binary_op(items, Opcode::XOR, "bit-xor");
+                break;
+            case LispSymbols::BIT_SHL:
+                compile_binary_op(items, Opcode::SHL, "bit-shl");
+                break;
+            case LispSymbols::BIT_SHR:
+                compile_binary_op(items, Opcode::SHR, "bit-shr");
+                break;
+            case LispSymbols::BIT_ASHR:
+                compile_binary_op(items, Opcode::ASHR, "bit-ashr");
+                break;
 
-                    // Emit FUNCALL
-                    emit_opcode(Opcode::FUNCALL);
+            // Function address (get pointer to compiled function)
+            case LispSymbols::FUNCTION_ADDRESS: {
+                if (items.size() != 2)
+                    throw std::runtime_error("function-address requires exactly 1 argument");
+
+                if (items[1]->type != NodeType::SYMBOL) {
+                    throw std::runtime_error("function-address argument must be a symbol");
                 }
-                // Symbol table access primitives (compile-time resolution)
-                else if (op == "symbol-count") {
-                    // (symbol-count) -> returns number of exported symbols
-                    emit_opcode(Opcode::PUSH);
-                    emit(exported_symbols.size());
-                } else if (op == "symbol-bound?") {
-                    // (symbol-bound? 'name) -> 1 if symbol exists, 0 otherwise
-                    compile_symbol_bound(items);
-                } else if (op == "symbol-address") {
-                    // (symbol-address 'name) -> address of symbol
-                    compile_symbol_address(items);
-                } else if (op == "symbol-value") {
-                    // (symbol-value 'name) -> value of variable
-                    compile_symbol_value(items);
-                } else if (op == "symbol-set!") {
-                    // (symbol-set! 'name value) -> set variable value
-                    compile_symbol_set(items);
+
+                std::string func_name(items[1]->as_symbol());
+
+                // Check that function exists (will be compiled later)
+                if (lookup_function(items[1]->symbol_id()) == nullptr) {
+                    throw std::runtime_error("Unknown function: " + func_name);
                 }
-                // Runtime code generation
-                else if (op == "eval") {
-                    // (eval string-expr) - Compile and execute string at runtime
-                    if (items.size() != 2)
-                        throw std::runtime_error("eval requires exactly 1 argument");
-                    compile_expr(items[1]); // Push string address
-                    emit_opcode(Opcode::EVAL);
-                } else if (op == "compile") {
-                    // (compile string-expr) - Compile string to callable function, return address
-                    if (items.size() != 2)
-                        throw std::runtime_error("compile requires exactly 1 argument");
-                    compile_expr(items[1]); // Push string address
-                    emit_opcode(Opcode::COMPILE);
-                } else {
-                    throw std::runtime_error("Unknown operator: " + op);
+
+                // Emit PUSH with placeholder address, will be patched later
+                emit_opcode(Opcode::PUSH);
+                label_refs.emplace_back(current_address(), func_name);
+                note_code_ref(current_address());
+                emit(0); // Placeholder
+                break;
+            }
+
+            // Dynamic function call via FUNCALL opcode
+            case LispSymbols::FUNCALL: {
+                // Syntax: (funcall target-address arg1 arg2 ... argN)
+                // Stack layout: [arg1] [arg2] ... [argN] [arg_count] [target_address]
+                if (items.size() < 2)
+                    throw std::runtime_error(
+                        "funcall requires at least 1 argument (target address)");
+
+                // Compile all arguments first (they go on the stack)
+                size_t num_args = items.size() - 2; // Exclude 'funcall' and target-address
+                for (size_t i = 2; i < items.size(); i++) {
+                    compile_expr(items[i]);
                 }
+
+                // Push arg count
+                emit_opcode(Opcode::PUSH);
+                emit(num_args);
+
+                // Push target address
+                compile_expr(items[1]);
+
+                // Emit FUNCALL
+                emit_opcode(Opcode::FUNCALL);
                 break;
             }
+
+            // Symbol table access primitives (compile-time resolution)
+            case LispSymbols::SYMBOL_COUNT:
+                // (symbol-count) -> returns number of exported symbols
+                require_serial();
+                emit_opcode(Opcode::PUSH);
+                emit(exported_symbols.size());
+                break;
+            case LispSymbols::SYMBOL_BOUND:
+                // (symbol-bound? 'name) -> 1 if symbol exists, 0 otherwise
+                require_serial();
+                compile_symbol_bound(items);
+                break;
+            case LispSymbols::SYMBOL_ADDRESS:
+                // (symbol-address 'name) -> address of symbol
+                require_serial();
+                compile_symbol_address(items);
+                break;
+            case LispSymbols::SYMBOL_VALUE:
+                // (symbol-value 'name) -> value of variable
+                require_serial();
+                compile_symbol_value(items);
+                break;
+            case LispSymbols::SYMBOL_SET:
+                // (symbol-set! 'name value) -> set variable value
+                require_serial();
+                compile_symbol_set(items);
+                break;
+
+            // Runtime code generation
+            case LispSymbols::EVAL:
+                // (eval string-expr) - Compile and execute string at runtime
+                if (items.size() != 2)
+                    throw std::runtime_error("eval requires exactly 1 argument");
+                compile_expr(items[1]); // Push string address
+                emit_opcode(Opcode::EVAL);
+                break;
+            case LispSymbols::COMPILE:
+                // (compile string-expr) - Compile string to callable function, return address
+                if (items.size() != 2)
+                    throw std::runtime_error("compile requires exactly 1 argument");
+                compile_expr(items[1]); // Push string address
+                emit_opcode(Opcode::COMPILE);
+                break;
+
+            default:
+                throw std::runtime_error("Unknown operator: " + std::string(items[0]->as_symbol()));
         }
     }
 
     // (define (func-name param1 param2 ...) body) - Define function
-    void compile_define_function(const std::vector<ASTNodePtr>& items) {
-
-        is_in_function = true;
-
+    void compile_define_function(const ASTList& items) {
         if (items.size() < 3) {
             throw std::runtime_error("define-func requires at least 2 arguments");
         }
@@ -444,14 +699,16 @@ class LispCompiler {
             throw std::runtime_error("define: function name must be a symbol");
         }
 
-        std::string func_name = func_def[0]->as_symbol();
+        std::string func_name(func_def[0]->as_symbol());
 
         std::vector<std::string> params;
+        std::vector<uint32_t> param_ids;
         for (size_t i = 1; i < func_def.size(); i++) {
             if (func_def[i]->type != NodeType::SYMBOL) {
                 throw std::runtime_error("define-func: function parameters must be symbols");
             }
-            params.push_back(func_def[i]->as_symbol());
+            params.emplace_back(func_def[i]->as_symbol());
+            param_ids.push_back(func_def[i]->symbol_id());
         }
 
         if (items.size() != 3) {
@@ -461,18 +718,17 @@ class LispCompiler {
         // Store function
         Function func;
         func.params = params;
-        func.body = items[2];
+        func.param_ids = param_ids;
+        func.body = bodies.copy_tree(items[2]);
         func.code_address = 0; // Will be set during compilation
-        functions[func_name] = func;
+        add_function(func_def[0]->symbol_id(), func_name, func);
 
         emit_opcode(Opcode::PUSH);
         emit(0);
-
-        is_in_function = false;
     }
 
     // (define-int NUMBER body) - Define interrupt handler
-    void compile_define_interrupt(const std::vector<ASTNodePtr>& items) {
+    void compile_define_interrupt(const ASTList& items) {
         if (items.size() != 3) {
             throw std::runtime_error(
                 "define-int requires exactly 2 arguments: signal number and body");
@@ -491,8 +747,17 @@ class LispCompiler {
         // Store interrupt handler
         Interrupt intr;
         intr.signal_number = signal_num;
-        intr.body = items[2];
+        intr.body = bodies.copy_tree(items[2]);
         intr.code_address = 0; // Will be set during compilation
+        intr.generation = generation;
+        if (incremental) {
+            auto it = interrupts.find(signal_num);
+            if (it == interrupts.end()) {
+                undo.interrupts.emplace_back(signal_num, std::nullopt);
+            } else if (it->second.generation != generation) {
+                undo.interrupts.emplace_back(signal_num, it->second);
+            }
+        }
         interrupts[signal_num] = intr;
 
         // Emit placeholder (no value pushed)
@@ -501,7 +766,7 @@ class LispCompiler {
     }
 
     // (define var value) - Define variable in current scope
-    void compile_define_variable(const std::vector<ASTNodePtr>& items) {
+    void compile_define_variable(const ASTList& items) {
         if (items.size() < 3) {
             throw std::runtime_error("define-var requires at least 2 arguments");
         }
@@ -511,15 +776,10 @@ class LispCompiler {
             throw std::runtime_error("define-var: first argument must be a symbol");
         }
 
-        std::string var_name = items[1]->as_symbol();
+        const uint32_t var_id = items[1]->symbol_id();
 
-        // Define global variable in current scope
-        uint64_t addr = 0;
-        if (!is_in_function) {
-            addr = define_variable(var_name);
-        } else {
-            addr = define_temporary_variable(var_name);
-        }
+        // Define the variable in current scope
+        const Variable var = define_local_variable(var_id);
 
         // Compile the value expression
         compile_expr(items[2]);
@@ -528,18 +788,11 @@ class LispCompiler {
         emit_opcode(Opcode::DUP);
 
         // Store it in the variable's memory location
-        emit_opcode(Opcode::PUSH);
-        emit(addr);
-        if (!is_in_function) {
-            emit_opcode(Opcode::STORE);
-        } else {
-            function_temporary_var_index++;
-            emit_opcode(Opcode::BP_STORE);
-        }
+        emit_store(var);
     }
 
     // (set var value) - Set existing variable
-    void compile_set(const std::vector<ASTNodePtr>& items) {
+    void compile_set(const ASTList& items) {
         if (items.size() != 3) {
             throw std::runtime_error("set requires 2 arguments: name and value");
         }
@@ -547,12 +800,11 @@ class LispCompiler {
             throw std::runtime_error("set: first argument must be a symbol");
         }
 
-        std::string var_name = items[1]->as_symbol();
-
         // Look up variable
-        std::optional<Variable> addr = lookup_variable(var_name);
+        std::optional<Variable> addr = lookup_variable(items[1]->symbol_id());
         if (!addr) {
-            throw std::runtime_error("set: undefined variable: " + var_name);
+            throw std::runtime_error("set: undefined variable: " +
+                                     std::string(items[1]->as_symbol()));
         }
 
         // Compile the value expression
@@ -562,59 +814,58 @@ class LispCompiler {
         emit_opcode(Opcode::DUP);
 
         // Store it in the variable's memory location
-        emit_opcode(Opcode::PUSH);
-        emit(addr->addr);
-        if (addr->is_global) {
-            emit_opcode(Opcode::STORE);
-        } else {
-            emit_opcode(Opcode::BP_STORE);
-        }
+        emit_store(*addr);
         // The duplicated value remains on the stack as the result
     }
 
-    // Helper: Extract symbol name from quoted expression (quote name) or 'name
-    std::string extract_quoted_symbol(const ASTNodePtr& node) {
+    // Helper: Extract the symbol from quoted expression (quote name) or 'name
+    ASTNodePtr extract_quoted_symbol(const ASTNodePtr& node) {
         if (node->type == NodeType::LIST) {
             const auto& list = node->as_list();
             if (list.size() == 2 && list[0]->type == NodeType::SYMBOL &&
-                list[0]->as_symbol() == "quote" && list[1]->type == NodeType::SYMBOL) {
-                return list[1]->as_symbol();
+                list[0]->symbol_id() == LispSymbols::QUOTE && list[1]->type == NodeType::SYMBOL) {
+                return list[1];
             }
         }
         throw std::runtime_error("Expected quoted symbol, e.g., (quote name) or 'name");
     }
 
     // (symbol-bound? 'name) -> 1 if symbol exists, 0 otherwise
-    void compile_symbol_bound(const std::vector<ASTNodePtr>& items) {
+    void compile_symbol_bound(const ASTList& items) {
         if (items.size() != 2) {
             throw std::runtime_error("symbol-bound? requires 1 argument: quoted symbol name");
         }
-        std::string name = extract_quoted_symbol(items[1]);
-        bool bound = exported_symbols.exists(name) || lookup_variable(name).has_value();
+        ASTNodePtr symbol = extract_quoted_symbol(items[1]);
+        std::string name(symbol->as_symbol());
+        bool bound = exported_symbols.exists(name) || lookup_variable(symbol->symbol_id());
         emit_opcode(Opcode::PUSH);
         emit(bound ? 1 : 0);
     }
 
     // (symbol-address 'name) -> address of symbol
-    void compile_symbol_address(const std::vector<ASTNodePtr>& items) {
+    void compile_symbol_address(const ASTList& items) {
         if (items.size() != 2) {
             throw std::runtime_error("symbol-address requires 1 argument: quoted symbol name");
         }
-        std::string name = extract_quoted_symbol(items[1]);
+        ASTNodePtr symbol = extract_quoted_symbol(items[1]);
+        std::string name(symbol->as_symbol());
 
         // Check exported symbols first
         auto entry = exported_symbols.lookup(name);
         if (entry.has_value()) {
             emit_opcode(Opcode::PUSH);
+            if (entry->is_function()) {
+                note_code_ref(current_address());
+            }
             emit(entry->address);
             return;
         }
 
         // Check compiler's variable table
-        auto var = lookup_variable(name);
+        auto var = lookup_variable(symbol->symbol_id());
         if (var.has_value()) {
             emit_opcode(Opcode::PUSH);
-            emit(var->addr);
+            emit_variable_address(*var);
             return;
         }
 
@@ -622,11 +873,12 @@ class LispCompiler {
     }
 
     // (symbol-value 'name) -> value of variable
-    void compile_symbol_value(const std::vector<ASTNodePtr>& items) {
+    void compile_symbol_value(const ASTList& items) {
         if (items.size() != 2) {
             throw std::runtime_error("symbol-value requires 1 argument: quoted symbol name");
         }
-        std::string name = extract_quoted_symbol(items[1]);
+        ASTNodePtr symbol = extract_quoted_symbol(items[1]);
+        std::string name(symbol->as_symbol());
 
         // Check exported symbols first
         auto entry = exported_symbols.lookup(name);
@@ -634,6 +886,7 @@ class LispCompiler {
             if (entry->is_function()) {
                 // For functions, return the code address
                 emit_opcode(Opcode::PUSH);
+                note_code_ref(current_address());
                 emit(entry->address);
                 return;
             }
@@ -645,15 +898,9 @@ class LispCompiler {
         }
 
         // Check compiler's variable table
-        auto var = lookup_variable(name);
+        auto var = lookup_variable(symbol->symbol_id());
         if (var.has_value()) {
-            emit_opcode(Opcode::PUSH);
-            emit(var->addr);
-            if (var->is_global) {
-                emit_opcode(Opcode::LOAD);
-            } else {
-                emit_opcode(Opcode::BP_LOAD);
-            }
+            emit_load(*var);
             return;
         }
 
@@ -661,12 +908,13 @@ class LispCompiler {
     }
 
     // (symbol-set! 'name value) -> set variable value
-    void compile_symbol_set(const std::vector<ASTNodePtr>& items) {
+    void compile_symbol_set(const ASTList& items) {
         if (items.size() != 3) {
             throw std::runtime_error(
                 "symbol-set! requires 2 arguments: quoted symbol name and value");
         }
-        std::string name = extract_quoted_symbol(items[1]);
+        ASTNodePtr symbol = extract_quoted_symbol(items[1]);
+        std::string name(symbol->as_symbol());
 
         // Check exported symbols first
         auto entry = exported_symbols.lookup(name);
@@ -686,20 +934,14 @@ class LispCompiler {
         }
 
         // Check compiler's variable table
-        auto var = lookup_variable(name);
+        auto var = lookup_variable(symbol->symbol_id());
         if (var.has_value()) {
             // Compile the value expression
             compile_expr(items[2]);
             // Duplicate value to return
             emit_opcode(Opcode::DUP);
             // Store to the variable's address
-            emit_opcode(Opcode::PUSH);
-            emit(var->addr);
-            if (var->is_global) {
-                emit_opcode(Opcode::STORE);
-            } else {
-                emit_opcode(Opcode::BP_STORE);
-            }
+            emit_store(*var);
             return;
         }
 
@@ -707,7 +949,7 @@ class LispCompiler {
     }
 
     // (let ((var1 val1) (var2 val2) ...) body...)
-    void compile_let(const std::vector<ASTNodePtr>& items) {
+    void compile_let(const ASTList& items) {
         if (items.size() < 3) {
             throw std::runtime_error("let requires at least 2 arguments: bindings and body");
         }
@@ -717,7 +959,8 @@ class LispCompiler {
 
         const auto& bindings = items[1]->as_list();
 
-        // Push new scope
+        // Push new scope; its temporaries are free again once it ends
+        const uint64_t temporaries = function_temporary_var_index;
         push_scope();
 
         // Process bindings
@@ -734,28 +977,13 @@ class LispCompiler {
                 throw std::runtime_error("let: binding name must be a symbol");
             }
 
-            std::string var_name = binding_list[0]->as_symbol();
+            const uint32_t var_id = binding_list[0]->symbol_id();
 
             // Compile value expression
             compile_expr(binding_list[1]);
 
-            // Define variable in new scope
-            uint64_t addr = 0;
-            if (!is_in_function) {
-                addr = define_variable(var_name);
-            } else {
-                addr = define_temporary_variable(var_name);
-            }
-
-            // Store the value
-            emit_opcode(Opcode::PUSH);
-            emit(addr);
-            if (!is_in_function) {
-                emit_opcode(Opcode::STORE);
-            } else {
-                function_temporary_var_index++;
-                emit_opcode(Opcode::BP_STORE);
-            }
+            // Define variable in new scope and store the value
+            emit_store(define_local_variable(var_id));
         }
 
         // Compile body expressions
@@ -768,12 +996,13 @@ class LispCompiler {
 
         // Pop scope
         pop_scope();
+        function_temporary_var_index = temporaries;
     }
 
     // Helper: Compile binary/variadic operators
     // Variadic: (op a b c) => ((a op b) op c) - left-to-right folding
     // Binary: (op a b) => (a op b) - exactly 2 arguments
-    void compile_binary_op(const std::vector<ASTNodePtr>& items, Opcode opcode,
+    void compile_binary_op(const ASTList& items, Opcode opcode,
                            const std::string& op_name, bool variadic = false) {
         if (variadic) {
             // Variadic operator: requires at least 2 arguments
@@ -797,7 +1026,7 @@ class LispCompiler {
     }
 
     // (while condition body...)
-    void compile_while(const std::vector<ASTNodePtr>& items) {
+    void compile_while(const ASTList& items) {
         if (items.size() < 3) {
             throw std::runtime_error("while requires at least 2 arguments: condition and body");
         }
@@ -829,10 +1058,10 @@ class LispCompiler {
 
         // Jump back to loop start
         emit_opcode(Opcode::JMP);
-        emit(loop_start);
+        emit_code_address(loop_start);
 
         // Patch loop end address
-        bytecode[loop_end_ref] = current_absolute_address();
+        patch_code_address(loop_end_ref);
 
         // Push 0 as return value (while doesn't return anything useful)
         emit_opcode(Opcode::PUSH);
@@ -841,7 +1070,7 @@ class LispCompiler {
 
     // (for (var start end) body...)
     // Iterates var from start to end-1
-    void compile_for(const std::vector<ASTNodePtr>& items) {
+    void compile_for(const ASTList& items) {
         if (items.size() < 3) {
             throw std::runtime_error("for requires at least 2 arguments: (var start end) and body");
         }
@@ -857,24 +1086,22 @@ class LispCompiler {
             throw std::runtime_error("for: loop variable must be a symbol");
         }
 
-        std::string var_name = loop_spec[0]->as_symbol();
+        const uint32_t var_id = loop_spec[0]->symbol_id();
 
-        // Push new scope for loop variable
+        // Push new scope for loop variable (in a function, both variables
+        // are frame temporaries, so loops are reentrant)
+        const uint64_t temporaries = function_temporary_var_index;
         push_scope();
 
         // Initialize loop variable
         compile_expr(loop_spec[1]); // start value
-        uint64_t var_addr = define_variable(var_name);
-        emit_opcode(Opcode::PUSH);
-        emit(var_addr);
-        emit_opcode(Opcode::STORE);
+        const Variable var = define_local_variable(var_id);
+        emit_store(var);
 
         // Evaluate and store end value in a temp variable
         compile_expr(loop_spec[2]); // end value
-        uint64_t end_addr = define_variable("__for_end__");
-        emit_opcode(Opcode::PUSH);
-        emit(end_addr);
-        emit_opcode(Opcode::STORE);
+        const Variable end = define_local_variable(LispSymbols::FOR_END);
+        emit_store(end);
 
         // Loop structure:
         // loop_start:
@@ -890,13 +1117,8 @@ class LispCompiler {
         size_t loop_start = current_absolute_address();
 
         // Check condition: var < end
-        emit_opcode(Opcode::PUSH);
-        emit(var_addr);
-        emit_opcode(Opcode::LOAD);
-
-        emit_opcode(Opcode::PUSH);
-        emit(end_addr);
-        emit_opcode(Opcode::LOAD);
+        emit_load(var);
+        emit_load(end);
 
         emit_opcode(Opcode::LT); // var < end
 
@@ -912,28 +1134,25 @@ class LispCompiler {
         }
 
         // Increment loop variable: var = var + 1
-        emit_opcode(Opcode::PUSH);
-        emit(var_addr);
-        emit_opcode(Opcode::LOAD);
+        emit_load(var);
 
         emit_opcode(Opcode::PUSH);
         emit(1);
 
         emit_opcode(Opcode::ADD);
 
-        emit_opcode(Opcode::PUSH);
-        emit(var_addr);
-        emit_opcode(Opcode::STORE);
+        emit_store(var);
 
         // Jump back to loop start
         emit_opcode(Opcode::JMP);
-        emit(loop_start);
+        emit_code_address(loop_start);
 
         // Patch loop end address
-        bytecode[loop_end_ref] = current_absolute_address();
+        patch_code_address(loop_end_ref);
 
         // Pop scope
         pop_scope();
+        function_temporary_var_index = temporaries;
 
         // Push 0 as return value
         emit_opcode(Opcode::PUSH);
@@ -941,7 +1160,7 @@ class LispCompiler {
     }
 
     // (peek addr) - Read memory at address
-    void compile_peek(const std::vector<ASTNodePtr>& items) {
+    void compile_peek(const ASTList& items) {
         if (items.size() != 2) {
             throw std::runtime_error("peek requires 1 argument: address");
         }
@@ -954,7 +1173,7 @@ class LispCompiler {
     }
 
     // (poke addr value) - Write value to memory at address
-    void compile_poke(const std::vector<ASTNodePtr>& items) {
+    void compile_poke(const ASTList& items) {
         if (items.size() != 3) {
             throw std::runtime_error("poke requires 2 arguments: address and value");
         }
@@ -978,7 +1197,7 @@ class LispCompiler {
     }
 
     // (peek-byte addr) - Read single byte from memory
-    void compile_peek_byte(const std::vector<ASTNodePtr>& items) {
+    void compile_peek_byte(const ASTList& items) {
         if (items.size() != 2) {
             throw std::runtime_error("peek-byte requires 1 argument: byte address");
         }
@@ -988,7 +1207,7 @@ class LispCompiler {
     }
 
     // (poke-byte addr value) - Write single byte to memory
-    void compile_poke_byte(const std::vector<ASTNodePtr>& items) {
+    void compile_poke_byte(const ASTList& items) {
         if (items.size() != 3) {
             throw std::runtime_error("poke-byte requires 2 arguments: address and value");
         }
@@ -1000,7 +1219,7 @@ class LispCompiler {
     }
 
     // (peek32 addr) - Read 32-bit word from memory
-    void compile_peek32(const std::vector<ASTNodePtr>& items) {
+    void compile_peek32(const ASTList& items) {
         if (items.size() != 2) {
             throw std::runtime_error("peek32 requires 1 argument: 32-bit word address");
         }
@@ -1010,7 +1229,7 @@ class LispCompiler {
     }
 
     // (poke32 addr value) - Write 32-bit word to memory
-    void compile_poke32(const std::vector<ASTNodePtr>& items) {
+    void compile_poke32(const ASTList& items) {
         if (items.size() != 3) {
             throw std::runtime_error("poke32 requires 2 arguments: address and value");
         }
@@ -1029,7 +1248,17 @@ class LispCompiler {
     //   3 = close(fd) -> result
     //   4 = lseek(fd, offset, whence) -> position
     //   5 = fsize(fd) -> file_size
-    void compile_c_call(const std::vector<ASTNodePtr>& items) {
+    //   6 = readv(fd, iov_addr, iovcnt) -> bytes_read
+    //   7 = writev(fd, iov_addr, iovcnt) -> bytes_written
+    //   8 = pread(fd, buffer_addr, count, offset) -> bytes_read
+    //   9 = pwrite(fd, buffer_addr, count, offset) -> bytes_written
+    //  10 = mmap(fd, buffer_addr, max_length) -> mapped length
+    //  11 = munmap(buffer_addr, length) -> result
+    //  12 = io-watch(fd, events) -> result
+    //  13 = io-wait(timeout_ms) -> ready count
+    //  14 = io-next(record_addr) -> 1 with [fd, events] written, or 0
+    //  15 = frame-pointer() -> bp of the calling function
+    void compile_c_call(const ASTList& items) {
         if (items.size() < 2) {
             throw std::runtime_error("c-call requires at least 1 argument: func-id");
         }
@@ -1051,6 +1280,61 @@ class LispCompiler {
         emit_opcode(Opcode::C_CALL);
     }
 
+    // (intern str start length id) - Intern a slice of a packed string as a
+    // selector, answering its tagged id. id 0 allocates the next id; a nonzero
+    // id preloads the name at that id. A str of 0 clears the table.
+    void compile_intern(const ASTList& items) {
+        if (items.size() != 5) {
+            throw std::runtime_error("intern requires 4 arguments: string, start, length, id");
+        }
+
+        for (size_t i = 1; i < items.size(); i++) {
+            compile_expr(items[i]);
+        }
+        emit_opcode(Opcode::INTERN);
+    }
+
+    // Bulk memory intrinsics, each three arguments compiled left to right:
+    //   (mem-copy dst src count)       - copy words, ranges must not overlap
+    //   (mem-move dst src count)       - copy words, ranges may overlap
+    //   (mem-set dst value count)      - fill words with value
+    //   (mem-compare a b count)        - compare words as unsigned: -1, 0 or 1
+    // The -bytes forms take byte addresses (word address * 8) and byte counts.
+    // All but the compares answer dst.
+    void compile_mem_op(const ASTList& items, Opcode opcode,
+                        const std::string& name) {
+        if (items.size() != 4) {
+            throw std::runtime_error(name + " requires 3 arguments");
+        }
+
+        for (size_t i = 1; i < items.size(); i++) {
+            compile_expr(items[i]);
+        }
+        emit_opcode(opcode);
+    }
+
+    // Packed string intrinsics (indices are byte offsets into the string):
+    //   (str-equal a b)                - 1 if same length and bytes, else 0
+    //   (str-hash str)                 - DJB2 hash, as hash-string computes it
+    //   (str-index str start char)     - first char at or after start, or -1
+    //   (str-scan str start classes)   - first index at or after start whose
+    //                                    char is outside classes (1 letter,
+    //                                    2 digit, 4 whitespace), or the length
+    //   (tokenize-into str records max) - lex Smalltalk source into up to max
+    //                                    4-word Token records, answer the count
+    void compile_string_op(const ASTList& items, Opcode opcode,
+                           const std::string& name, size_t arity) {
+        if (items.size() != arity + 1) {
+            throw std::runtime_error(name + " requires " + std::to_string(arity) +
+                                     (arity == 1 ? " argument" : " arguments"));
+        }
+
+        for (size_t i = 1; i < items.size(); i++) {
+            compile_expr(items[i]);
+        }
+        emit_opcode(opcode);
+    }
+
     // Add string literal to table (or return existing address if duplicate)
     uint64_t add_string_literal(const std::string& str) {
         // Check if we've already seen this string (deduplication)
@@ -1075,15 +1359,37 @@ class LispCompiler {
 
     // Compile string literal - just push its address
     void compile_string_literal(const std::string& str) {
-        uint64_t addr = add_string_literal(str);
         emit_opcode(Opcode::PUSH);
-        emit(addr);
+        if (unit != nullptr) {
+            unit->strings.emplace_back(current_address(), str);
+            emit(0);
+            return;
+        }
+        emit(add_string_literal(str));
     }
 
-    // Compile function call
-    void compile_function_call(const std::string& func_name, const std::vector<ASTNodePtr>& items) {
-        const Function& func = functions[func_name];
+    // Record a function under its name and its symbol id
+    void add_function(uint32_t id, const std::string& name, const Function& func) {
+        if (incremental) {
+            auto it = functions.find(name);
+            if (it == functions.end()) {
+                undo.functions.emplace_back(name, std::nullopt);
+            } else if (it->second.generation != generation) {
+                undo.functions.emplace_back(name, it->second);
+            }
+        }
+        Function& stored = functions[name];
+        stored = func;
+        stored.generation = generation;
+        if (id >= functions_by_id.size()) {
+            functions_by_id.resize(id + 1, nullptr);
+        }
+        functions_by_id[id] = &stored;
+    }
 
+    // Compile function call
+    void compile_function_call(const std::string& func_name, const Function& func,
+                               const ASTList& items) {
         // Check argument count
         size_t num_args = items.size() - 1;
         if (num_args != func.params.size()) {
@@ -1098,16 +1404,13 @@ class LispCompiler {
         }
 
         // Call the function
-        // Arguments are now on the stack
+        // Arguments are now on the stack; the callee's header says how many
         emit_opcode(Opcode::CALL);
 
         // Placeholder for function address
         size_t call_addr_pos = current_address();
         emit(0);
 
-        // Number of arguments
-        emit(num_args);
-
         // Store label reference for later patching
         label_refs.emplace_back(call_addr_pos, func_name);
 
@@ -1123,110 +1426,211 @@ class LispCompiler {
     }
 
     CompiledProgram compile(const ASTNodePtr& ast) {
-        bytecode.clear();
-        // Don't clear labels - preserve imported function addresses
-        label_refs.clear();
-
-        compile_expr(ast);
-        emit_opcode(Opcode::HALT);
-
-        // Compile functions
-        compile_all_functions();
-
-        // Compile interrupt handlers
-        compile_all_interrupts();
-
-        // Patch function calls
-        patch_function_calls();
-
-        // Return program with bytecode and string data
-        CompiledProgram program;
-        program.bytecode = std::move(bytecode);
-        program.strings.reserve(string_table.size());
-        for (const auto& str_lit : string_table) {
-            program.strings.push_back({str_lit.content, str_lit.address});
+        begin_compile();
+        try {
+            compile_expr(ast);
+            emit_opcode(Opcode::HALT);
+            return finish_compile();
+        } catch (...) {
+            abandon_compile();
+            throw;
         }
-        return program;
     }
 
     // Compile an expression as a callable function (ends with RET instead of HALT)
     // Used by runtime COMPILE opcode to create dynamically callable code
     CompiledProgram compile_as_function(const ASTNodePtr& ast) {
-        bytecode.clear();
-        // Don't clear labels - preserve imported function addresses
-        label_refs.clear();
-
-        compile_expr(ast);
-        // End with RET 0 (no arguments) so this can be called via FUNCALL
-        emit_opcode(Opcode::RET);
-        emit(0);
-
-        // Compile any nested function definitions
-        compile_all_functions();
-
-        // Compile interrupt handlers
-        compile_all_interrupts();
-
-        // Patch function calls
-        patch_function_calls();
-
-        // Return program with bytecode and string data
-        CompiledProgram program;
-        program.bytecode = std::move(bytecode);
-        program.strings.reserve(string_table.size());
-        for (const auto& str_lit : string_table) {
-            program.strings.push_back({str_lit.content, str_lit.address});
+        begin_compile();
+        try {
+            // A function of no arguments, entered past its header at the
+            // program's start + FunctionHeader::SIZE, so FUNCALL can call it
+            emit(FunctionHeader::make(0, 0));
+            compile_expr(ast);
+            emit_opcode(Opcode::RET);
+            return finish_compile();
+        } catch (...) {
+            abandon_compile();
+            throw;
         }
-        return program;
     }
 
     CompiledProgram compile_program(const std::vector<ASTNodePtr>& exprs) {
+        begin_compile();
+        try {
+            for (size_t i = 0; i < exprs.size(); i++) {
+                compile_expr(exprs[i]);
+                if (i < exprs.size() - 1) {
+                    emit_opcode(Opcode::POP); // discard intermediate results
+                }
+            }
+            emit_opcode(Opcode::HALT);
+            return finish_compile();
+        } catch (...) {
+            abandon_compile();
+            throw;
+        }
+    }
+
+    // Compile a file's forms as a relocatable module (see lisp_module.hpp)
+    // that can be linked after whatever defined imports. Not for
+    // incremental mode; the compiler is reset before and after.
+    LispModule compile_module(const std::vector<ASTNodePtr>& forms, const SymbolTable& imports) {
+        if (incremental) {
+            throw std::runtime_error("compile_module can't be used in incremental mode");
+        }
+        reset();
         bytecode.clear();
-        // Don't clear labels - preserve imported function addresses
         label_refs.clear();
+        code_base_address = 0;
+        Unit module_unit;
+        module_unit.module = true;
+        unit = &module_unit;
+        for (const SymbolEntry& entry : imports.all_symbols()) {
+            const uint32_t id = LispSymbols::intern(entry.name);
+            if (entry.is_variable()) {
+                bind(id, {.is_global = true,
+                          .addr = UNIT_IMPORTS + module_unit.import_names.size()});
+                module_unit.import_names.push_back(entry.name);
+            } else {
+                Function func;
+                func.params = entry.params;
+                func.body = nullptr; // Linked, not compiled
+                add_function(id, entry.name, func);
+            }
+        }
 
-        for (size_t i = 0; i < exprs.size(); i++) {
-            compile_expr(exprs[i]);
-            if (i < exprs.size() - 1) {
-                emit_opcode(Opcode::POP); // discard intermediate results
+        try {
+            for (size_t i = 0; i < forms.size(); i++) {
+                compile_expr(forms[i]);
+                if (i < forms.size() - 1) {
+                    emit_opcode(Opcode::POP);
+                }
+            }
+            emit_opcode(Opcode::HALT);
+            compile_all_functions();
+            compile_all_interrupts();
+        } catch (const SerialOnly&) {
+            unit = nullptr;
+            reset();
+            throw std::runtime_error("The symbol-* forms can't be used in a module: they need "
+                                     "the symbols of everything linked before it");
+        } catch (...) {
+            unit = nullptr;
+            reset();
+            throw;
+        }
+        unit = nullptr;
+
+        LispModule module;
+        std::map<std::string, uint64_t> imported; // Name -> index in module.imports
+        auto import = [&](const std::string& name) {
+            if (imported.emplace(name, module.imports.size()).second) {
+                module.imports.push_back(*imports.lookup(name));
+                module.imports.back().address = 0;
+            }
+        };
+        for (auto& [pos, callee] : label_refs) {
+            auto it = functions.find(callee);
+            if (it == functions.end()) {
+                reset();
+                throw std::runtime_error("Undefined function: " + callee);
+            }
+            if (it->second.body != nullptr) {
+                bytecode[pos] = it->second.code_address;
+                module.code_relocs.push_back(pos);
+            } else {
+                import(callee);
+                module.symbol_relocs.emplace_back(pos, callee);
             }
         }
+        for (auto& [pos, name] : module_unit.imports) {
+            import(name);
+            module.symbol_relocs.emplace_back(pos, std::move(name));
+        }
 
-        emit_opcode(Opcode::HALT);
+        std::map<std::string, uint64_t> string_index;
+        for (auto& [pos, str] : module_unit.strings) {
+            auto [it, added] = string_index.emplace(str, module.strings.size());
+            if (added) {
+                module.strings.push_back(std::move(str));
+            }
+            module.string_relocs.emplace_back(pos, it->second);
+        }
 
-        // Compile functions
-        compile_all_functions();
+        module.code_relocs.insert(module.code_relocs.end(), module_unit.code_relocs.begin(),
+                                  module_unit.code_relocs.end());
+        module.global_relocs.assign(module_unit.globals.begin(), module_unit.globals.end());
+        module.global_count = module_unit.global_count;
+        for (const uint32_t id : module_unit.forms) {
+            module.forms.emplace_back(LispSymbols::name(id));
+        }
+        for (const auto& [name, func] : functions) {
+            if (func.body != nullptr) {
+                module.exports.push_back(
+                    {name, SymbolType::FUNCTION, func.code_address, func.params});
+            }
+        }
+        for (SymbolEntry entry : exported_symbols.all_variables()) {
+            entry.address -= UNIT_GLOBALS;
+            module.exports.push_back(std::move(entry));
+        }
+        module.code = std::move(bytecode);
+        reset();
+        return module;
+    }
 
-        // Compile interrupt handlers
-        compile_all_interrupts();
+    // Incremental mode, for a compiler that lives as long as a REPL session
+    // and whose programs all go into one VM. Each compile is a generation:
+    //   - functions and interrupt handlers are compiled once, by the
+    //     generation that defines them, and later programs call the code
+    //     already loaded instead of carrying a copy
+    //   - a program's strings (and write_strings_to_memory) are only the
+    //     literals that generation added
+    //   - a compile that throws is undone: the globals, functions, strings
+    //     and symbols it defined are dropped and redefinitions restored
+    // The symbol table only gains what each generation defines, so the cost
+    // of a compile depends on its input, not on the size of the session.
+    // Code that fails at run time keeps its definitions.
+    void set_incremental(bool enabled) {
+        incremental = enabled;
+    }
 
-        // Patch function calls
-        patch_function_calls();
+    // Threads for compiling function bodies: 0 (the default) for one per
+    // core, 1 to compile serially. Programs with fewer than
+    // PARALLEL_MIN_FUNCTIONS functions are always compiled serially. The
+    // code is the same either way.
+    void set_compile_threads(size_t threads) {
+        compile_threads = threads;
+    }
 
-        // Return program with bytecode and string data
-        CompiledProgram program;
-        program.bytecode = std::move(bytecode);
-        program.strings.reserve(string_table.size());
-        for (const auto& str_lit : string_table) {
-            program.strings.push_back({str_lit.content, str_lit.address});
+    // Undo the last incremental compile, as if it had failed, so the same
+    // code can be compiled again at another base address
+    void retract() {
+        if (!incremental) {
+            throw std::runtime_error("retract needs incremental mode");
         }
-        return program;
+        abandon_compile();
     }
 
     // Reset compiler state for new program
     void reset() {
-        scopes.clear();
+        clear_scopes();
         push_scope(); // Re-establish global scope
         next_var_address = VAR_START;
         next_string_address = STRING_TABLE_START;
         function_local_var_index = 0;
         function_temporary_var_index = 0;
+        function_temporary_var_count = 0;
+        argument_refs.clear();
         is_in_function = false;
         functions.clear();
+        functions_by_id.clear();
         interrupts.clear();
         string_table.clear();
         string_dedup.clear();
         exported_symbols.clear();
+        labels.clear();
+        undo = {};
     }
 
     // ========================================================================
@@ -1245,11 +1649,21 @@ class LispCompiler {
             push_scope();
         }
 
-        auto& global_scope = scopes.front();
-
-        // Import variables
+        // Import variables into the global scope, replacing any global
+        // binding of the same name
         for (const auto& entry : symbols.all_variables()) {
-            global_scope.variables[entry.name] = {.is_global = true, .addr = entry.address};
+            const uint32_t id = LispSymbols::intern(entry.name);
+            const Variable var = {.is_global = true, .addr = entry.address};
+            if (id >= bindings.size()) {
+                bindings.resize(id + 1);
+            }
+            auto& stack = bindings[id];
+            if (!stack.empty() && stack.front().depth == 1) {
+                stack.front().var = var;
+            } else {
+                stack.insert(stack.begin(), {.var = var, .depth = 1});
+                scopes.front().symbols.push_back(id);
+            }
         }
 
         // Import functions
@@ -1258,7 +1672,7 @@ class LispCompiler {
             func.params = entry.params;
             func.body = nullptr; // Already compiled
             func.code_address = entry.address;
-            functions[entry.name] = func;
+            add_function(LispSymbols::intern(entry.name), entry.name, func);
             labels[entry.name] = entry.address;
         }
 
@@ -1301,10 +1715,12 @@ class LispCompiler {
         return bytecode.size();
     }
 
-    // Write string literals to VM memory
+    // Write string literals to VM memory (in incremental mode, only those
+    // the last compile added)
     // Call this AFTER loading bytecode into the VM
     void write_strings_to_memory(StackVM& vm) {
-        for (const auto& str_lit : string_table) {
+        for (size_t i = undo.strings; i < string_table.size(); i++) {
+            const auto& str_lit = string_table[i];
             const std::string& str = str_lit.content;
             uint64_t addr = str_lit.address;
 
@@ -1325,76 +1741,348 @@ class LispCompiler {
     }
 
   private:
+    void begin_compile() {
+        bytecode.clear();
+        // Don't clear labels - preserve imported function addresses
+        label_refs.clear();
+        code_refs.clear();
+
+        undo = {};
+        if (incremental) {
+            generation++;
+            undo.next_var_address = next_var_address;
+            undo.next_string_address = next_string_address;
+            undo.globals = scopes.front().symbols.size();
+            undo.strings = string_table.size();
+        }
+    }
+
+    CompiledProgram finish_compile() {
+        // Compile functions
+        compile_all_functions();
+
+        // Compile interrupt handlers
+        compile_all_interrupts();
+
+        // Patch function calls
+        patch_function_calls();
+
+        // Return program with bytecode and string data
+        CompiledProgram program;
+        program.bytecode = std::move(bytecode);
+        program.code_refs = std::move(code_refs);
+        code_refs.clear();
+        program.strings.reserve(string_table.size() - undo.strings);
+        for (size_t i = undo.strings; i < string_table.size(); i++) {
+            program.strings.push_back({string_table[i].content, string_table[i].address});
+        }
+        return program;
+    }
+
+    // Undo a failed incremental compile (see set_incremental)
+    void abandon_compile() {
+        if (!incremental) {
+            return;
+        }
+
+        while (scopes.size() > 1) {
+            pop_scope();
+        }
+        auto& globals = scopes.front().symbols;
+        while (globals.size() > undo.globals) {
+            const uint32_t id = globals.back();
+            bindings[id].pop_back();
+            exported_symbols.remove(std::string(LispSymbols::name(id)));
+            globals.pop_back();
+        }
+
+        for (auto it = undo.functions.rbegin(); it != undo.functions.rend(); ++it) {
+            const auto& [name, previous] = *it;
+            if (previous) {
+                functions[name] = *previous;
+                labels[name] = previous->code_address;
+                exported_symbols.define_function(name, previous->code_address, previous->params);
+            } else {
+                functions.erase(name);
+                functions_by_id[LispSymbols::intern(name)] = nullptr;
+                labels.erase(name);
+                exported_symbols.remove(name);
+            }
+        }
+        for (auto it = undo.interrupts.rbegin(); it != undo.interrupts.rend(); ++it) {
+            if (it->second) {
+                interrupts[it->first] = *it->second;
+            } else {
+                interrupts.erase(it->first);
+            }
+        }
+
+        while (string_table.size() > undo.strings) {
+            string_dedup.erase(string_table.back().content);
+            string_table.pop_back();
+        }
+        next_var_address = undo.next_var_address;
+        next_string_address = undo.next_string_address;
+        is_in_function = false;
+        function_local_var_index = 0;
+        function_temporary_var_index = 0;
+        function_temporary_var_count = 0;
+        argument_refs.clear();
+        undo = {};
+    }
+
     // Compile all function definitions
     void compile_all_functions() {
+        if (incremental) {
+            // Only this generation's definitions; the list can grow while
+            // compiling if a body defines functions itself
+            if (compile_units(undo.functions.size(), [this](size_t i) -> auto& {
+                    return *functions.find(undo.functions[i].first);
+                })) {
+                return;
+            }
+            for (size_t i = 0; i < undo.functions.size(); i++) {
+                compile_function(undo.functions[i].first, functions.at(undo.functions[i].first));
+            }
+            return;
+        }
+
+        // Skip functions that are already compiled (imported from previous REPL expressions)
+        std::vector<std::map<std::string, Function>::iterator> pending;
+        for (auto it = functions.begin(); it != functions.end(); ++it) {
+            if (it->second.body != nullptr) {
+                pending.push_back(it);
+            }
+        }
+        if (compile_units(pending.size(), [&](size_t i) -> auto& { return *pending[i]; })) {
+            return;
+        }
+
         for (auto& [name, func] : functions) {
-            // Skip functions that are already compiled (imported from previous REPL expressions)
             if (func.body == nullptr) {
                 continue;
             }
+            compile_function(name, func);
+        }
+    }
 
-            // Record function start address (absolute)
-            func.code_address = current_absolute_address();
-            labels[name] = func.code_address;
+    // Compile the count functions entry(i) names on worker threads, then lay
+    // them out in order exactly as compile_function would have, one after
+    // the other. Returns false, having changed nothing, when there are too
+    // few to be worth it or a unit can't be compiled apart (it defines
+    // functions itself, or fails, in which case the serial compile reports
+    // the error).
+    template <typename Entry> bool compile_units(size_t count, const Entry& entry) {
+        size_t threads =
+            compile_threads != 0 ? compile_threads : std::thread::hardware_concurrency();
+        threads = std::min(threads, count / (PARALLEL_MIN_FUNCTIONS / 2));
+        if (count < PARALLEL_MIN_FUNCTIONS || threads < 2 || unit != nullptr) {
+            return false;
+        }
+
+        std::vector<Unit> units(count);
+        std::atomic<size_t> next{0};
+        auto work = [&] {
+            LispCompiler worker(*this);
+            for (size_t i = next++; i < count; i = next++) {
+                worker.compile_unit(entry(i).second, units[i]);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < threads; t++) {
+            pool.emplace_back(work);
+        }
+        work();
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
 
-            // Export function to symbol table
-            exported_symbols.define_function(name, func.code_address, func.params);
+        for (const Unit& u : units) {
+            if (u.state == Unit::State::FAILED) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            auto& [name, func] = entry(i);
+            if (units[i].state == Unit::State::SERIAL) {
+                compile_function(name, func);
+            } else {
+                place_unit(name, func, units[i]);
+            }
+        }
+        return true;
+    }
 
-            push_scope();
+    // A worker for compile_units: the parent's global scope and functions,
+    // nothing else
+    explicit LispCompiler(const LispCompiler& parent)
+        : scopes(parent.scopes), bindings(parent.bindings), next_var_address(0),
+          functions_by_id(parent.functions_by_id), next_string_address(0) {}
 
-            // Now pop arguments and store them
-            std::vector<uint64_t> param_addrs;
-            for (const auto& param : func.params) {
-                define_argument_variable(param);
+    void compile_unit(const Function& func, Unit& result) {
+        unit = &result;
+        bytecode.clear();
+        label_refs.clear();
+        code_refs.clear();
+        try {
+            if (defines_anything(func.body)) {
+                throw std::runtime_error("Nested definitions are compiled serially");
             }
+            emit_function_body(func);
+            result.code = std::move(bytecode);
+            result.calls = std::move(label_refs);
+        } catch (const SerialOnly&) {
+            result.state = Unit::State::SERIAL;
+        } catch (const std::exception&) {
+            result.state = Unit::State::FAILED;
+        }
+        unit = nullptr;
+        is_in_function = false;
+        // A unit that threw may have left its scope open
+        while (scopes.size() > 1) {
+            pop_scope();
+        }
+        function_local_var_index = 0;
+        function_temporary_var_index = 0;
+        function_temporary_var_count = 0;
+        argument_refs.clear();
+    }
 
-            emit_opcode(Opcode::ENTER);
-            uint64_t patch_temporaries = current_address();
-            // placeholder for temporaries
-            emit(0);
+    static bool defines_anything(ASTNodePtr node) {
+        if (node->type != NodeType::LIST) {
+            return false;
+        }
+        const ASTList items = node->as_list();
+        if (!items.empty() && items[0]->type == NodeType::SYMBOL &&
+            (items[0]->symbol_id() == LispSymbols::DEFINE_FUNC ||
+             items[0]->symbol_id() == LispSymbols::DEFINE_INT)) {
+            return true;
+        }
+        return std::any_of(items.begin(), items.end(), defines_anything);
+    }
 
-            // Compile function body
-            compile_expr(func.body);
+    // Append a compiled unit at the current address and resolve its
+    // relocations, allocating strings and globals in the order serial
+    // compilation would have
+    void place_unit(const std::string& name, Function& func, Unit& u) {
+        const uint64_t start = current_absolute_address();
+        func.code_address = start + FunctionHeader::SIZE;
+        labels[name] = func.code_address;
+        exported_symbols.define_function(name, func.code_address, func.params);
 
-            emit_opcode(Opcode::LEAVE);
-            emit(function_temporary_var_index);
-            bytecode[patch_temporaries] = function_temporary_var_index;
+        const size_t offset = bytecode.size();
+        bytecode.insert(bytecode.end(), u.code.begin(), u.code.end());
+        for (size_t pos : u.code_relocs) {
+            bytecode[offset + pos] += start;
+        }
+        for (auto& [pos, callee] : u.calls) {
+            label_refs.emplace_back(offset + pos, std::move(callee));
+        }
+        for (size_t pos : u.code_refs) {
+            code_refs.push_back(offset + pos);
+        }
+        for (const auto& [pos, str] : u.strings) {
+            bytecode[offset + pos] = add_string_literal(str);
+        }
+        for (const auto& [pos, index] : u.globals) {
+            bytecode[offset + pos] = next_var_address + index;
+        }
+        next_var_address += u.global_count;
+    }
 
-            // Return
-            emit_opcode(Opcode::RET);
-            emit(func.params.size());
+    void compile_function(const std::string& name, Function& func) {
+        // Record function entry address (absolute), past its header
+        func.code_address = current_absolute_address() + FunctionHeader::SIZE;
+        labels[name] = func.code_address;
 
-            pop_scope();
+        // Export function to symbol table
+        exported_symbols.define_function(name, func.code_address, func.params);
+
+        emit_function_body(func);
+    }
+
+    // The function's header word, then its code. CALL builds the frame the
+    // header describes and RET takes it down, so the body is all there is.
+    void emit_function_body(const Function& func) {
+        if (func.params.size() > FunctionHeader::MAX_ARITY) {
+            throw std::runtime_error("Function takes too many arguments: " +
+                                     std::to_string(func.params.size()));
+        }
+
+        push_scope();
+
+        for (uint32_t param : func.param_ids) {
+            define_argument_variable(param, func.param_ids.size());
+        }
+
+        // Patched once the frame size is known
+        const size_t header = current_address();
+        emit(0);
+
+        // Compile function body
+        is_in_function = true;
+        compile_expr(func.body);
+        is_in_function = false;
+
+        const uint64_t temporaries = function_temporary_var_count;
+        if (temporaries > FunctionHeader::MAX_TEMPORARIES) {
+            throw std::runtime_error("Function needs too many temporaries: " +
+                                     std::to_string(temporaries));
+        }
 
-            function_local_var_index = 0;
-            function_temporary_var_index = 0;
+        // Arguments come after the temporaries and the return address
+        for (size_t pos : argument_refs) {
+            bytecode[pos] += temporaries;
         }
+        bytecode[header] = FunctionHeader::make(func.params.size(), temporaries);
+
+        emit_opcode(Opcode::RET);
+
+        pop_scope();
+
+        function_local_var_index = 0;
+        function_temporary_var_index = 0;
+        function_temporary_var_count = 0;
+        argument_refs.clear();
     }
 
     // Compile all interrupt handler definitions
     void compile_all_interrupts() {
+        if (incremental) {
+            for (size_t i = 0; i < undo.interrupts.size(); i++) {
+                compile_interrupt(undo.interrupts[i].first,
+                                  interrupts.at(undo.interrupts[i].first));
+            }
+            return;
+        }
+
         for (auto& [signal_num, intr] : interrupts) {
-            // Record interrupt handler start address (absolute)
-            intr.code_address = current_absolute_address();
+            compile_interrupt(signal_num, intr);
+        }
+    }
 
-            push_scope();
+    void compile_interrupt(uint64_t signal_num, Interrupt& intr) {
+        // Record interrupt handler start address (absolute)
+        intr.code_address = current_absolute_address();
 
-            // Compile interrupt handler body
-            compile_expr(intr.body);
+        push_scope();
 
-            pop_scope();
+        // Compile interrupt handler body
+        compile_expr(intr.body);
 
-            // Return from interrupt (re-enables interrupts)
-            emit_opcode(Opcode::IRET);
+        pop_scope();
 
-            // Register the interrupt handler
-            // SIGNAL_REG expects: signal_number, code_address on stack
-            emit_opcode(Opcode::PUSH);
-            emit(intr.code_address);
-            emit_opcode(Opcode::PUSH);
-            emit(signal_num);
-            emit_opcode(Opcode::SIGNAL_REG);
-        }
+        // Return from interrupt (re-enables interrupts)
+        emit_opcode(Opcode::IRET);
+
+        // Register the interrupt handler
+        // SIGNAL_REG expects: signal_number, code_address on stack
+        emit_opcode(Opcode::PUSH);
+        note_code_ref(current_address());
+        emit_code_address(intr.code_address);
+        emit_opcode(Opcode::PUSH);
+        emit(signal_num);
+        emit_opcode(Opcode::SIGNAL_REG);
     }
 
     // Patch all function call addresses
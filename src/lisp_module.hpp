@@ -0,0 +1,448 @@
+#pragma once
+#include "compiled_program.hpp"
+#include "function_header.hpp"
+#include "symbol_table.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// Relocatable Lisp Modules
+// ============================================================================
+// A module is one source file compiled on its own, against the symbols of
+// whatever is loaded before it (LispCompiler::compile_module), into code
+// that can be loaded anywhere. Every word that depends on where things end
+// up is listed in a relocation table instead:
+//   - code addresses inside the module (jumps, calls to its own functions)
+//   - its globals, numbered from 0
+//   - its string literals, by index
+//   - functions and variables of other modules, by name
+// ModuleLinker fills them in for a code address and a place in the globals
+// and string areas, and adds the module's exports to the symbol table.
+//
+// Modules are written to disk by ModuleCache, keyed by a hash of their
+// source. A cached module can be linked as long as every symbol it imports
+// still exists with the same kind and parameters, and no function has since
+// been defined with the name of a form it compiled as a special form or
+// intrinsic (links_against); otherwise it has to be compiled again. Changing
+// a module therefore only recompiles the modules after it whose imports it
+// changed.
+
+struct LispModule {
+    uint64_t source_hash{0};
+
+    // Top-level code from offset 0, ending in HALT, then the function bodies
+    std::vector<uint64_t> code;
+
+    std::vector<uint64_t> code_relocs;                          // Words holding a code offset
+    std::vector<std::pair<uint64_t, uint64_t>> global_relocs;   // Word, global index
+    std::vector<std::pair<uint64_t, uint64_t>> string_relocs;   // Word, index into strings
+    std::vector<std::pair<uint64_t, std::string>> symbol_relocs; // Word, imported symbol
+    uint64_t global_count{0};
+    std::vector<std::string> strings;
+
+    // The symbols in symbol_relocs as the module was compiled against them
+    // (addresses unused), and what it defines: functions at code offsets and
+    // global variables by index
+    std::vector<SymbolEntry> imports;
+    std::vector<SymbolEntry> exports;
+
+    // Names it called as special forms or intrinsics, which a function of
+    // the same name would have taken over
+    std::vector<std::string> forms;
+
+    static constexpr uint64_t MAGIC = 0x4d4c4d54; // "TMLM"
+    // Bumped whenever the bytecode a module holds changes meaning, or the
+    // file layout changes
+    static constexpr uint64_t VERSION = 4;
+
+    // FNV-1a, which is what names a module in the cache
+    static uint64_t hash(std::string_view source) {
+        uint64_t h = 14695981039346656037ULL;
+        for (const char c : source) {
+            h = (h ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+        }
+        return h;
+    }
+
+    // Are all the imports in symbols, as they were when this was compiled,
+    // and none of its forms?
+    [[nodiscard]] bool links_against(const SymbolTable& symbols) const {
+        for (const SymbolEntry& import : imports) {
+            auto entry = symbols.lookup(import.name);
+            if (!entry || entry->type != import.type || entry->params != import.params) {
+                return false;
+            }
+        }
+        for (const std::string& form : forms) {
+            if (symbols.exists(form)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void write(std::ostream& out) const {
+        put(out, MAGIC);
+        put(out, VERSION);
+        put(out, source_hash);
+        put(out, global_count);
+        put_words(out, code);
+        put_words(out, code_relocs);
+        put(out, global_relocs.size());
+        for (const auto& [pos, index] : global_relocs) {
+            put(out, pos);
+            put(out, index);
+        }
+        put(out, string_relocs.size());
+        for (const auto& [pos, index] : string_relocs) {
+            put(out, pos);
+            put(out, index);
+        }
+        put(out, symbol_relocs.size());
+        for (const auto& [pos, name] : symbol_relocs) {
+            put(out, pos);
+            put_string(out, name);
+        }
+        put(out, strings.size());
+        for (const std::string& str : strings) {
+            put_string(out, str);
+        }
+        put_symbols(out, imports);
+        put_symbols(out, exports);
+        put(out, forms.size());
+        for (const std::string& form : forms) {
+            put_string(out, form);
+        }
+    }
+
+    // Throws std::runtime_error if in doesn't hold a module of this version
+    static LispModule read(std::istream& in) {
+        if (get(in) != MAGIC || get(in) != VERSION) {
+            throw std::runtime_error("Not a compiled module (or an old version)");
+        }
+        LispModule module;
+        module.source_hash = get(in);
+        module.global_count = get(in);
+        module.code = get_words(in);
+        module.code_relocs = get_words(in);
+        module.global_relocs.resize(get_count(in));
+        for (auto& [pos, index] : module.global_relocs) {
+            pos = get(in);
+            index = get(in);
+        }
+        module.string_relocs.resize(get_count(in));
+        for (auto& [pos, index] : module.string_relocs) {
+            pos = get(in);
+            index = get(in);
+        }
+        module.symbol_relocs.resize(get_count(in));
+        for (auto& [pos, name] : module.symbol_relocs) {
+            pos = get(in);
+            name = get_string(in);
+        }
+        module.strings.resize(get_count(in));
+        for (std::string& str : module.strings) {
+            str = get_string(in);
+        }
+        module.imports = get_symbols(in);
+        module.exports = get_symbols(in);
+        module.forms.resize(get_count(in));
+        for (std::string& form : module.forms) {
+            form = get_string(in);
+        }
+        module.check();
+        return module;
+    }
+
+  private:
+    // Every relocation must point into the code and at something that exists,
+    // and every export at one of the module's functions or globals
+    void check() const {
+        auto bad = [this](uint64_t pos) { return pos >= code.size(); };
+        for (uint64_t pos : code_relocs) {
+            if (bad(pos)) {
+                throw std::runtime_error("Corrupt module: relocation outside its code");
+            }
+        }
+        for (const auto& [pos, index] : global_relocs) {
+            if (bad(pos) || index >= global_count) {
+                throw std::runtime_error("Corrupt module: bad global relocation");
+            }
+        }
+        for (const auto& [pos, index] : string_relocs) {
+            if (bad(pos) || index >= strings.size()) {
+                throw std::runtime_error("Corrupt module: bad string relocation");
+            }
+        }
+        for (const auto& [pos, name] : symbol_relocs) {
+            if (bad(pos)) {
+                throw std::runtime_error("Corrupt module: bad symbol relocation");
+            }
+        }
+        for (const SymbolEntry& entry : exports) {
+            const bool valid = entry.is_function()
+                                   ? entry.address >= FunctionHeader::SIZE &&
+                                         !bad(entry.address) &&
+                                         FunctionHeader::is_header(
+                                             code[entry.address - FunctionHeader::SIZE])
+                                   : entry.address < global_count;
+            if (!valid) {
+                throw std::runtime_error("Corrupt module: bad export " + entry.name);
+            }
+        }
+    }
+
+    static void put(std::ostream& out, uint64_t word) {
+        out.write(reinterpret_cast<const char*>(&word), sizeof(word));
+    }
+
+    static void put_words(std::ostream& out, const std::vector<uint64_t>& words) {
+        put(out, words.size());
+        out.write(reinterpret_cast<const char*>(words.data()),
+                  static_cast<std::streamsize>(words.size() * sizeof(uint64_t)));
+    }
+
+    static void put_string(std::ostream& out, const std::string& str) {
+        put(out, str.size());
+        out.write(str.data(), static_cast<std::streamsize>(str.size()));
+    }
+
+    static void put_symbols(std::ostream& out, const std::vector<SymbolEntry>& symbols) {
+        put(out, symbols.size());
+        for (const SymbolEntry& entry : symbols) {
+            put_string(out, entry.name);
+            put(out, static_cast<uint64_t>(entry.type));
+            put(out, entry.address);
+            put(out, entry.params.size());
+            for (const std::string& param : entry.params) {
+                put_string(out, param);
+            }
+        }
+    }
+
+    static uint64_t get(std::istream& in) {
+        uint64_t word = 0;
+        if (!in.read(reinterpret_cast<char*>(&word), sizeof(word))) {
+            throw std::runtime_error("Corrupt module: truncated");
+        }
+        return word;
+    }
+
+    // A length, which can't be more than what is left to read
+    static size_t get_count(std::istream& in) {
+        const uint64_t count = get(in);
+        const auto here = in.tellg();
+        in.seekg(0, std::ios::end);
+        const auto left = static_cast<uint64_t>(in.tellg() - here);
+        in.seekg(here);
+        if (count > left) {
+            throw std::runtime_error("Corrupt module: truncated");
+        }
+        return count;
+    }
+
+    static std::vector<uint64_t> get_words(std::istream& in) {
+        std::vector<uint64_t> words(get_count(in));
+        if (!in.read(reinterpret_cast<char*>(words.data()),
+                     static_cast<std::streamsize>(words.size() * sizeof(uint64_t)))) {
+            throw std::runtime_error("Corrupt module: truncated");
+        }
+        return words;
+    }
+
+    static std::string get_string(std::istream& in) {
+        std::string str(get_count(in), '\0');
+        if (!in.read(str.data(), static_cast<std::streamsize>(str.size()))) {
+            throw std::runtime_error("Corrupt module: truncated");
+        }
+        return str;
+    }
+
+    static std::vector<SymbolEntry> get_symbols(std::istream& in) {
+        std::vector<SymbolEntry> symbols(get_count(in));
+        for (SymbolEntry& entry : symbols) {
+            entry.name = get_string(in);
+            const uint64_t type = get(in);
+            if (type > static_cast<uint64_t>(SymbolType::FUNCTION)) {
+                throw std::runtime_error("Corrupt module: bad symbol type");
+            }
+            entry.type = static_cast<SymbolType>(type);
+            entry.address = get(in);
+            entry.params.resize(get_count(in));
+            for (std::string& param : entry.params) {
+                param = get_string(in);
+            }
+        }
+        return symbols;
+    }
+};
+
+// ============================================================================
+// Module Linker
+// ============================================================================
+// Places modules one after another in the globals and string areas, from
+// the addresses it starts with, and at whatever code address each is given.
+
+class ModuleLinker {
+  public:
+    ModuleLinker(uint64_t next_var_address, uint64_t next_string_address)
+        : next_var_address(next_var_address), next_string_address(next_string_address) {}
+
+    // The module's code with every relocation filled in for code_address,
+    // and the strings it adds. Imports are resolved in symbols and the
+    // module's exports added to it.
+    CompiledProgram link(const LispModule& module, uint64_t code_address, SymbolTable& symbols) {
+        if (!module.links_against(symbols)) {
+            for (const SymbolEntry& import : module.imports) {
+                if (!symbols.exists(import.name)) {
+                    throw std::runtime_error("Module imports undefined symbol: " + import.name);
+                }
+            }
+            for (const std::string& form : module.forms) {
+                if (symbols.exists(form)) {
+                    throw std::runtime_error("Module was compiled before " + form +
+                                             " was defined");
+                }
+            }
+            throw std::runtime_error("Module was compiled against different definitions");
+        }
+        for (const SymbolEntry& entry : module.exports) {
+            auto existing = symbols.lookup(entry.name);
+            if (existing && (entry.is_variable() || existing->is_variable())) {
+                throw std::runtime_error("Symbol already defined: " + entry.name);
+            }
+        }
+
+        CompiledProgram program;
+        program.bytecode = module.code;
+        std::vector<uint64_t>& code = program.bytecode;
+        for (uint64_t pos : module.code_relocs) {
+            code[pos] += code_address;
+            program.code_refs.push_back(pos);
+        }
+        for (const auto& [pos, index] : module.global_relocs) {
+            code[pos] = next_var_address + index;
+        }
+        for (const auto& [pos, name] : module.symbol_relocs) {
+            const std::optional<SymbolEntry> entry = symbols.lookup(name);
+            code[pos] = entry->address;
+            if (entry->is_function()) {
+                program.code_refs.push_back(pos);
+            }
+        }
+
+        std::vector<uint64_t> string_addresses;
+        string_addresses.reserve(module.strings.size());
+        for (const std::string& str : module.strings) {
+            auto [it, added] = strings.emplace(str, next_string_address);
+            if (added) {
+                program.strings.push_back({str, next_string_address});
+                next_string_address += 1 + (str.length() + 7) / 8; // Length, then 8 chars a word
+            }
+            string_addresses.push_back(it->second);
+        }
+        for (const auto& [pos, index] : module.string_relocs) {
+            code[pos] = string_addresses[index];
+        }
+
+        for (const SymbolEntry& entry : module.exports) {
+            if (entry.is_function()) {
+                symbols.define_function(entry.name, code_address + entry.address, entry.params);
+            } else {
+                symbols.define_variable(entry.name, next_var_address + entry.address);
+            }
+        }
+        next_var_address += module.global_count;
+        return program;
+    }
+
+    [[nodiscard]] uint64_t get_next_var_address() const {
+        return next_var_address;
+    }
+
+    [[nodiscard]] uint64_t get_next_string_address() const {
+        return next_string_address;
+    }
+
+  private:
+    uint64_t next_var_address;
+    uint64_t next_string_address;
+    std::map<std::string, uint64_t> strings; // Content -> address, across modules
+};
+
+// ============================================================================
+// Module Cache
+// ============================================================================
+// Compiled modules on disk, one file per source hash.
+
+class ModuleCache {
+  public:
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+    };
+
+    explicit ModuleCache(std::filesystem::path dir) : dir(std::move(dir)) {
+        std::filesystem::create_directories(this->dir);
+    }
+
+    // The module compiled from source with this hash, if there is one that
+    // links against symbols. Unreadable files count as misses.
+    std::optional<LispModule> load(uint64_t source_hash, const SymbolTable& symbols) {
+        std::ifstream in(path(source_hash), std::ios::binary);
+        if (in) {
+            try {
+                LispModule module = LispModule::read(in);
+                if (module.source_hash == source_hash && module.links_against(symbols)) {
+                    stats.hits++;
+                    return module;
+                }
+            } catch (const std::runtime_error&) {
+            }
+        }
+        stats.misses++;
+        return std::nullopt;
+    }
+
+    // Written to a temporary file first, so readers never see half a module
+    void store(const LispModule& module) const {
+        const std::filesystem::path file = path(module.source_hash);
+        std::filesystem::path temp = file;
+        temp += ".tmp";
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            module.write(out);
+            if (!out) {
+                throw std::runtime_error("Cannot write module cache file: " + temp.string());
+            }
+        }
+        std::filesystem::rename(temp, file);
+    }
+
+    [[nodiscard]] const Stats& get_stats() const {
+        return stats;
+    }
+
+  private:
+    std::filesystem::path dir;
+    Stats stats;
+
+    [[nodiscard]] std::filesystem::path path(uint64_t source_hash) const {
+        static const char* digits = "0123456789abcdef";
+        std::string name(16, '0');
+        for (int i = 15; i >= 0; i--, source_hash >>= 4) {
+            name[i] = digits[source_hash & 15];
+        }
+        return dir / (name + ".mtm");
+    }
+};
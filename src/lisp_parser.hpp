@@ -1,71 +1,284 @@
 #pragma once
-#include <cctype>
+#include "lisp_symbols.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
 #include <memory>
-#include <sstream>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
-#include <variant>
 #include <vector>
 
-// AST Node types
+// ============================================================================
+// Arena-allocated AST
+// ============================================================================
+// Nodes are bump-allocated from an ASTArena and never freed individually;
+// the whole tree goes away with its arena. A LispParser owns the arena for
+// the trees it parses, so nodes stay valid as long as the parser does.
+//
+// Nodes are immutable and trivially destructible. Symbols are interned
+// (see lisp_symbols.hpp) and carry their id, strings are views into the
+// source when they have no escapes, and a list's children are one
+// contiguous array of node pointers.
+
 struct ASTNode;
-using ASTNodePtr = std::shared_ptr<ASTNode>;
+using ASTNodePtr = const ASTNode*;
 
 enum class NodeType { NUMBER, SYMBOL, LIST, STRING };
 
+// Children of a LIST node
+class ASTList {
+  public:
+    ASTList() = default;
+    ASTList(const ASTNodePtr* items, size_t count) : items(items), count(count) {}
+
+    [[nodiscard]] const ASTNodePtr* begin() const {
+        return items;
+    }
+    [[nodiscard]] const ASTNodePtr* end() const {
+        return items + count;
+    }
+    [[nodiscard]] size_t size() const {
+        return count;
+    }
+    [[nodiscard]] bool empty() const {
+        return count == 0;
+    }
+    const ASTNodePtr& operator[](size_t i) const {
+        return items[i];
+    }
+    [[nodiscard]] const ASTNodePtr& back() const {
+        return items[count - 1];
+    }
+
+  private:
+    const ASTNodePtr* items{nullptr};
+    size_t count{0};
+};
+
 struct ASTNode {
     NodeType type;
-    std::variant<int64_t, std::string, std::vector<ASTNodePtr>> value;
 
-    static ASTNodePtr make_number(int64_t n) {
-        auto node = std::make_shared<ASTNode>();
-        node->type = NodeType::NUMBER;
-        node->value = n;
+    [[nodiscard]] int64_t as_number() const {
+        expect(NodeType::NUMBER, "number");
+        return number;
+    }
+
+    [[nodiscard]] std::string_view as_symbol() const {
+        expect(NodeType::SYMBOL, "symbol");
+        return {text, size};
+    }
+
+    // Interned id of a symbol, see LispSymbols
+    [[nodiscard]] uint32_t symbol_id() const {
+        expect(NodeType::SYMBOL, "symbol");
+        return id;
+    }
+
+    [[nodiscard]] std::string_view as_string() const {
+        expect(NodeType::STRING, "string");
+        return {text, size};
+    }
+
+    [[nodiscard]] ASTList as_list() const {
+        expect(NodeType::LIST, "list");
+        return {items, size};
+    }
+
+  private:
+    friend class ASTArena;
+
+    uint32_t id{0}; // SYMBOL; sits in the padding after type
+    union {
+        int64_t number;          // NUMBER
+        const char* text;        // SYMBOL, STRING
+        const ASTNodePtr* items; // LIST
+    };
+    size_t size{0}; // Text length or child count
+
+    void expect(NodeType wanted, const char* what) const {
+        if (type != wanted) {
+            throw std::runtime_error(std::string("AST node is not a ") + what);
+        }
+    }
+};
+
+static_assert(std::is_trivially_destructible_v<ASTNode>, "arena nodes are never destroyed");
+static_assert(sizeof(ASTNode) == 24, "symbol ids fit in the padding after type");
+
+class ASTArena {
+  public:
+    ASTArena() = default;
+    ASTArena(const ASTArena&) = delete;
+    ASTArena& operator=(const ASTArena&) = delete;
+    ASTArena(ASTArena&&) = default;
+    ASTArena& operator=(ASTArena&&) = default;
+
+    ASTNodePtr make_number(int64_t n) {
+        ASTNode* node = new_node(NodeType::NUMBER);
+        node->number = n;
         return node;
     }
 
-    static ASTNodePtr make_symbol(const std::string& s) {
-        auto node = std::make_shared<ASTNode>();
-        node->type = NodeType::SYMBOL;
-        node->value = s;
+    // Symbols point at their interned text. String text must outlive the
+    // arena; use store() for text that does not come from arena memory
+    // already.
+    ASTNodePtr make_symbol(std::string_view s) {
+        const LispSymbols::Symbol symbol = LispSymbols::intern_symbol(s);
+        ASTNode* node = make_text(NodeType::SYMBOL, symbol.name);
+        node->id = symbol.id;
         return node;
     }
 
-    static ASTNodePtr make_list(const std::vector<ASTNodePtr>& items) {
-        auto node = std::make_shared<ASTNode>();
-        node->type = NodeType::LIST;
-        node->value = items;
+    ASTNodePtr make_symbol(uint32_t id) {
+        ASTNode* node = make_text(NodeType::SYMBOL, LispSymbols::name(id));
+        node->id = id;
         return node;
     }
 
-    static ASTNodePtr make_string(const std::string& s) {
-        auto node = std::make_shared<ASTNode>();
-        node->type = NodeType::STRING;
-        node->value = s;
+    ASTNodePtr make_string(std::string_view s) {
+        return make_text(NodeType::STRING, s);
+    }
+
+    ASTNodePtr make_list(const ASTNodePtr* items, size_t count) {
+        auto* copy = allocate<ASTNodePtr>(count);
+        std::copy(items, items + count, copy);
+        ASTNode* node = new_node(NodeType::LIST);
+        node->items = copy;
+        node->size = count;
         return node;
     }
 
-    [[nodiscard]] int64_t as_number() const {
-        return std::get<int64_t>(value);
+    ASTNodePtr make_list(const std::vector<ASTNodePtr>& items) {
+        return make_list(items.data(), items.size());
     }
 
-    [[nodiscard]] std::string as_symbol() const {
-        return std::get<std::string>(value);
+    // Copy text into the arena
+    std::string_view store(std::string_view text) {
+        char* copy = allocate<char>(text.size());
+        std::copy(text.begin(), text.end(), copy);
+        return {copy, text.size()};
     }
 
-    [[nodiscard]] std::string as_string() const {
-        return std::get<std::string>(value);
+    // Deep copy of a tree from another arena, text included
+    ASTNodePtr copy_tree(ASTNodePtr node) {
+        switch (node->type) {
+            case NodeType::NUMBER:
+                return make_number(node->number);
+            case NodeType::SYMBOL: {
+                ASTNode* symbol = make_text(NodeType::SYMBOL, {node->text, node->size});
+                symbol->id = node->id;
+                return symbol;
+            }
+            case NodeType::STRING:
+                return make_text(NodeType::STRING, store({node->text, node->size}));
+            case NodeType::LIST:
+                break;
+        }
+        auto* items = allocate<ASTNodePtr>(node->size);
+        for (size_t i = 0; i < node->size; i++) {
+            items[i] = copy_tree(node->items[i]);
+        }
+        ASTNode* list = new_node(NodeType::LIST);
+        list->items = items;
+        list->size = node->size;
+        return list;
+    }
+
+    // Bytes handed out so far, for measuring parses
+    [[nodiscard]] size_t bytes_used() const {
+        return used;
+    }
+
+  private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<unsigned char[]>> blocks;
+    unsigned char* cursor{nullptr};
+    size_t remaining{0};
+    size_t used{0};
+
+    template <typename T> T* allocate(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "arena memory is never destroyed");
+        return static_cast<T*>(allocate_bytes(count * sizeof(T), alignof(T)));
+    }
+
+    void* allocate_bytes(size_t bytes, size_t align) {
+        size_t pad = (align - (reinterpret_cast<uintptr_t>(cursor) & (align - 1))) & (align - 1);
+        if (cursor == nullptr || pad + bytes > remaining) {
+            // Oversized requests get a block of their own
+            const size_t block = std::max(BLOCK_SIZE, bytes + align);
+            blocks.push_back(std::make_unique<unsigned char[]>(block));
+            cursor = blocks.back().get();
+            remaining = block;
+            pad = (align - (reinterpret_cast<uintptr_t>(cursor) & (align - 1))) & (align - 1);
+        }
+        void* result = cursor + pad;
+        cursor += pad + bytes;
+        remaining -= pad + bytes;
+        used += bytes;
+        return result;
     }
 
-    [[nodiscard]] const std::vector<ASTNodePtr>& as_list() const {
-        return std::get<std::vector<ASTNodePtr>>(value);
+    ASTNode* new_node(NodeType type) {
+        auto* node = new (allocate_bytes(sizeof(ASTNode), alignof(ASTNode))) ASTNode();
+        node->type = type;
+        return node;
+    }
+
+    ASTNode* make_text(NodeType type, std::string_view s) {
+        ASTNode* node = new_node(type);
+        node->text = s.data();
+        node->size = s.size();
+        return node;
     }
 };
 
+// Character classes for the lexer, one bit per class, for every byte value
+namespace LispChars {
+
+constexpr uint8_t SPACE = 1;     // What std::isspace accepts in the C locale
+constexpr uint8_t DELIMITER = 2; // Ends a symbol or number: space, parens, NUL
+constexpr uint8_t DIGIT = 4;
+constexpr uint8_t LETTER = 8;
+
+constexpr std::array<uint8_t, 256> make_classes() {
+    std::array<uint8_t, 256> classes{};
+    for (int c = '0'; c <= '9'; c++) {
+        classes[c] = DIGIT;
+    }
+    for (int c = 'A'; c <= 'Z'; c++) {
+        classes[c] = LETTER;
+        classes[c + ('a' - 'A')] = LETTER;
+    }
+    for (const char c : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+        classes[static_cast<uint8_t>(c)] = SPACE | DELIMITER;
+    }
+    for (const char c : {'(', ')', '\0'}) {
+        classes[static_cast<uint8_t>(c)] = DELIMITER;
+    }
+    return classes;
+}
+
+inline constexpr std::array<uint8_t, 256> CLASSES = make_classes();
+
+inline bool is(char c, uint8_t cls) {
+    return (CLASSES[static_cast<uint8_t>(c)] & cls) != 0;
+}
+
+} // namespace LispChars
+
 class LispParser {
   private:
-    std::string input;
+    // Heap-allocated so node views stay put if the parser is moved
+    std::unique_ptr<ASTArena> arena;
+    std::string_view input; // Copy of the source in the arena
     size_t pos{0};
+    std::vector<ASTNodePtr> pending; // Children of the lists being parsed
 
     [[nodiscard]] char peek() const {
         return pos < input.size() ? input[pos] : '\0';
@@ -77,19 +290,13 @@ class LispParser {
 
     void skip_whitespace() {
         while (pos < input.size()) {
-            // Skip whitespace
-            if (std::isspace(input[pos]) != 0) {
+            if (LispChars::is(input[pos], LispChars::SPACE)) {
                 pos++;
             }
-            // Skip comments (from ; to end of line)
+            // Skip comments (from ; to end of line, including the newline)
             else if (input[pos] == ';') {
-                while (pos < input.size() && input[pos] != '\n') {
-                    pos++;
-                }
-                // Skip the newline itself
-                if (pos < input.size() && input[pos] == '\n') {
-                    pos++;
-                }
+                const size_t newline = input.find('\n', pos);
+                pos = newline == std::string_view::npos ? input.size() : newline + 1;
             } else {
                 break;
             }
@@ -97,11 +304,24 @@ class LispParser {
     }
 
     [[nodiscard]] static bool is_delimiter(char c) {
-        return c == '(' || c == ')' || (std::isspace(c) != 0) || c == '\0';
+        return LispChars::is(c, LispChars::DELIMITER);
+    }
+
+    // Convert digits (already validated for radix) in place; a value that
+    // does not fit in 64 bits is an error rather than a silent wrap
+    [[nodiscard]] int64_t to_integer(std::string_view digits, int radix) const {
+        int64_t value = 0;
+        const auto [end, ec] =
+            std::from_chars(digits.data(), digits.data() + digits.size(), value, radix);
+        if (ec != std::errc() || end != digits.data() + digits.size()) {
+            throw std::runtime_error("Number out of range: " + std::string(digits));
+        }
+        return value;
     }
 
     ASTNodePtr parse_number() {
-        std::string num_str;
+        using LispChars::DIGIT;
+        using LispChars::LETTER;
         bool negative = false;
 
         if (peek() == '-') {
@@ -109,35 +329,39 @@ class LispParser {
             next();
         }
 
-        // Parse initial digits (could be radix or the number itself)
-        while (std::isdigit(peek()) != 0) {
-            num_str += next();
+        // Initial digits: the radix, or the number itself
+        const size_t start = pos;
+        while (LispChars::is(peek(), DIGIT)) {
+            pos++;
         }
 
-        if (num_str.empty()) {
+        if (pos == start) {
             throw std::runtime_error("Invalid number");
         }
+        std::string_view digits = input.substr(start, pos - start);
 
         // Check for radix notation: <radix>r<digits>
         // e.g., 16rFF, 2r1010, 8r77
         if (peek() == 'r' || peek() == 'R') {
             next(); // consume 'r'
 
-            int radix = std::stoi(num_str);
-            if (radix < 2 || radix > 36) {
+            int radix = 0;
+            const auto [end, ec] =
+                std::from_chars(digits.data(), digits.data() + digits.size(), radix);
+            if (ec != std::errc() || radix < 2 || radix > 36) {
                 throw std::runtime_error("Radix must be between 2 and 36");
             }
 
-            // Parse digits in the specified radix
-            std::string digits;
+            // Validate each digit here for the error messages; from_chars
+            // would just stop at the first bad one
+            const size_t digits_start = pos;
             while (!is_delimiter(peek())) {
-                char c = peek();
-                // Check if character is valid for this radix
+                const char c = peek();
                 int digit_value;
-                if (std::isdigit(c)) {
+                if (LispChars::is(c, DIGIT)) {
                     digit_value = c - '0';
-                } else if (std::isalpha(c)) {
-                    digit_value = std::toupper(c) - 'A' + 10;
+                } else if (LispChars::is(c, LETTER)) {
+                    digit_value = (c | 0x20) - 'a' + 10;
                 } else {
                     throw std::runtime_error("Invalid digit in radix notation");
                 }
@@ -147,35 +371,33 @@ class LispParser {
                                              std::to_string(radix));
                 }
 
-                digits += next();
+                pos++;
             }
 
-            if (digits.empty()) {
+            if (pos == digits_start) {
                 throw std::runtime_error("Missing digits after radix notation");
             }
 
-            // Convert from specified radix to int64_t
-            int64_t value = std::stoll(digits, nullptr, radix);
-            return ASTNode::make_number(negative ? -value : value);
+            const int64_t value = to_integer(input.substr(digits_start, pos - digits_start), radix);
+            return arena->make_number(negative ? -value : value);
         }
 
         // Normal decimal number
-        int64_t value = std::stoll(num_str);
-        return ASTNode::make_number(negative ? -value : value);
+        const int64_t value = to_integer(digits, 10);
+        return arena->make_number(negative ? -value : value);
     }
 
     ASTNodePtr parse_symbol() {
-        std::string sym;
-
+        const size_t start = pos;
         while (!is_delimiter(peek())) {
-            sym += next();
+            pos++;
         }
 
-        if (sym.empty()) {
+        if (pos == start) {
             throw std::runtime_error("Invalid symbol");
         }
 
-        return ASTNode::make_symbol(sym);
+        return arena->make_symbol(input.substr(start, pos - start));
     }
 
     ASTNodePtr parse_string() {
@@ -183,8 +405,17 @@ class LispParser {
             throw std::runtime_error("Expected '\"'");
         }
 
-        std::string str;
+        // Without escapes the literal is a view of the source
+        const size_t start = pos;
+        while (peek() != '"' && peek() != '\\' && peek() != '\0') {
+            pos++;
+        }
+        if (peek() == '"') {
+            pos++;
+            return arena->make_string(input.substr(start, pos - 1 - start));
+        }
 
+        std::string str(input.substr(start, pos - start));
         while (peek() != '"' && peek() != '\0') {
             char c = next();
             if (c == '\\' && peek() != '\0') {
@@ -219,7 +450,7 @@ class LispParser {
             throw std::runtime_error("Expected closing '\"'");
         }
 
-        return ASTNode::make_string(str);
+        return arena->make_string(arena->store(str));
     }
 
     ASTNodePtr parse_list() {
@@ -227,11 +458,14 @@ class LispParser {
             throw std::runtime_error("Expected '('");
         }
 
-        std::vector<ASTNodePtr> items;
+        // Children collect on the shared pending stack and move into the
+        // arena as one array when the list closes
+        const size_t first = pending.size();
         skip_whitespace();
 
         while (peek() != ')' && peek() != '\0') {
-            items.push_back(parse_expr());
+            ASTNodePtr item = parse_expr();
+            pending.push_back(item);
             skip_whitespace();
         }
 
@@ -239,7 +473,9 @@ class LispParser {
             throw std::runtime_error("Expected ')'");
         }
 
-        return ASTNode::make_list(items);
+        ASTNodePtr list = arena->make_list(pending.data() + first, pending.size() - first);
+        pending.resize(first);
+        return list;
     }
 
     ASTNodePtr parse_expr() {
@@ -259,8 +495,9 @@ class LispParser {
             return parse_string();
         }
 
-        if ((std::isdigit(c) != 0) ||
-            (c == '-' && pos + 1 < input.size() && (std::isdigit(input[pos + 1]) != 0))) {
+        const bool negative_number = c == '-' && pos + 1 < input.size() &&
+                                     LispChars::is(input[pos + 1], LispChars::DIGIT);
+        if (LispChars::is(c, LispChars::DIGIT) || negative_number) {
             return parse_number();
         }
 
@@ -268,7 +505,13 @@ class LispParser {
     }
 
   public:
-    LispParser(std::string src) : input(std::move(src)) {}
+    LispParser(std::string_view src)
+        : arena(std::make_unique<ASTArena>()), input(arena->store(src)) {}
+
+    // Arena holding every node this parser has produced
+    [[nodiscard]] const ASTArena& nodes() const {
+        return *arena;
+    }
 
     ASTNodePtr parse() {
         return parse_expr();
@@ -0,0 +1,191 @@
+#pragma once
+#include "lisp_parser.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+// ============================================================================
+// Streaming Lisp Reader
+// ============================================================================
+// Reads Lisp source from a file descriptor in fixed-size chunks and hands
+// out one top-level form at a time, so a program of any length is parsed
+// (and can be compiled and run) form by form while the rest is still being
+// read. Only the form in progress and the unread rest of the last chunk are
+// buffered.
+//
+// A small scanner finds where each top-level form ends: it tracks list
+// depth, strings (with escapes), comments and bare atoms, carrying its state
+// across chunk boundaries so every byte is looked at once. The complete form
+// is then parsed by a LispParser of its own, whose arena holds the nodes
+// until the next call to next().
+//
+// The reader does not own the file descriptor.
+
+class LispReader {
+  public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    explicit LispReader(int fd, size_t chunk_size = DEFAULT_CHUNK_SIZE)
+        : fd(fd), chunk_size(chunk_size == 0 ? 1 : chunk_size) {}
+
+    // The next top-level form, or nullptr at end of input. The node stays
+    // valid until the following call.
+    ASTNodePtr next() {
+        while (ready.empty()) {
+            const size_t end = scan();
+            if (end != NONE) {
+                take(end);
+            } else if (!fill()) {
+                finish();
+                if (ready.empty()) {
+                    return nullptr;
+                }
+            }
+        }
+        ASTNodePtr form = ready.front();
+        ready.pop_front();
+        return form;
+    }
+
+    // Bytes currently held for the form in progress and the unscanned input
+    [[nodiscard]] size_t buffered() const {
+        return buffer.size() - form_start;
+    }
+
+  private:
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+    int fd;
+    size_t chunk_size;
+    bool eof{false};
+
+    std::string buffer;
+    size_t form_start{0}; // First byte of the form in progress
+    size_t scan_pos{0};   // First byte the scanner has not looked at
+
+    // Scanner state, carried across chunks
+    bool in_form{false};
+    bool in_atom{false};
+    bool in_string{false};
+    bool in_escape{false};
+    bool in_comment{false};
+    size_t depth{0};
+
+    // Parser for the last complete form, and the forms it produced
+    std::unique_ptr<LispParser> parser;
+    std::deque<ASTNodePtr> ready;
+
+    // Advance the scanner; returns the end of a complete top-level form, or
+    // NONE when the buffered input runs out first
+    size_t scan() {
+        while (scan_pos < buffer.size()) {
+            const char c = buffer[scan_pos];
+            if (in_comment) {
+                in_comment = c != '\n';
+            } else if (in_string) {
+                if (in_escape) {
+                    in_escape = false;
+                } else if (c == '\\') {
+                    in_escape = true;
+                } else if (c == '"') {
+                    in_string = false;
+                    if (depth == 0) {
+                        return ++scan_pos;
+                    }
+                }
+            } else if (in_atom) {
+                // Atoms run to a delimiter, which belongs to what follows
+                if (LispChars::is(c, LispChars::DELIMITER)) {
+                    in_atom = false;
+                    if (depth == 0) {
+                        return scan_pos;
+                    }
+                    continue;
+                }
+            } else if (c == ';') {
+                in_comment = true;
+            } else if (c == '(') {
+                start_form();
+                depth++;
+            } else if (c == ')') {
+                if (depth == 0) {
+                    throw std::runtime_error("Unexpected ')'");
+                }
+                if (--depth == 0) {
+                    return ++scan_pos;
+                }
+            } else if (c == '"') {
+                start_form();
+                in_string = true;
+            } else if (!LispChars::is(c, LispChars::DELIMITER)) {
+                start_form();
+                in_atom = true;
+            }
+            scan_pos++;
+            // Nothing before the next form needs keeping
+            if (!in_form) {
+                form_start = scan_pos;
+            }
+        }
+        return NONE;
+    }
+
+    void start_form() {
+        if (!in_form) {
+            in_form = true;
+            form_start = scan_pos;
+        }
+    }
+
+    // Parse buffer[form_start, end) and queue its forms. A bare atom can
+    // hold more than one ("12abc" is 12 then abc), hence parse_all.
+    void take(size_t end) {
+        parser = std::make_unique<LispParser>(
+            std::string_view(buffer).substr(form_start, end - form_start));
+        for (ASTNodePtr form : parser->parse_all()) {
+            ready.push_back(form);
+        }
+        in_form = false;
+        form_start = end;
+    }
+
+    // Read the next chunk, dropping what has already been consumed; returns
+    // false at end of input
+    bool fill() {
+        if (eof) {
+            return false;
+        }
+        buffer.erase(0, form_start);
+        scan_pos -= form_start;
+        form_start = 0;
+
+        const size_t old_size = buffer.size();
+        buffer.resize(old_size + chunk_size);
+        ssize_t n;
+        do {
+            n = read(fd, buffer.data() + old_size, chunk_size);
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) {
+            buffer.resize(old_size);
+            throw std::runtime_error(std::string("read failed: ") + std::strerror(errno));
+        }
+        buffer.resize(old_size + static_cast<size_t>(n));
+        eof = n == 0;
+        return !eof;
+    }
+
+    // End of input: a trailing atom is complete, anything else open is not
+    void finish() {
+        if (in_atom && depth == 0) {
+            in_atom = false;
+            take(buffer.size());
+        } else if (in_form) {
+            throw std::runtime_error("Unexpected end of input");
+        }
+    }
+};
@@ -0,0 +1,258 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ============================================================================
+// Interned Lisp Symbols
+// ============================================================================
+// The parser interns every symbol it reads to a small integer id, and the
+// compiler binds variables, finds functions and dispatches special forms by
+// id instead of by string compare.
+//
+// The table is process-wide and only grows. Ids stay valid and names are
+// never freed, so a symbol's text outlives any AST that refers to it.
+// Looking up a name that is already there takes no lock; only adding one
+// does.
+// The compiler's special forms are interned first, in the order of Form, so
+// their ids are constants it can switch on.
+
+namespace LispSymbols {
+
+enum Form : uint32_t {
+    // Definitions and binding
+    DEFINE_FUNC,
+    DEFINE_INT,
+    DEFINE_VAR,
+    SET,
+    LET,
+    // Loops
+    WHILE,
+    FOR,
+    // Memory primitives
+    PEEK,
+    POKE,
+    PEEK_BYTE,
+    POKE_BYTE,
+    PEEK32,
+    POKE32,
+    C_CALL,
+    INTERN,
+    // Bulk memory
+    MEM_COPY,
+    MEM_MOVE,
+    MEM_SET,
+    MEM_COMPARE,
+    MEM_COPY_BYTES,
+    MEM_MOVE_BYTES,
+    MEM_SET_BYTES,
+    MEM_COMPARE_BYTES,
+    // Packed strings
+    STR_EQUAL,
+    STR_HASH,
+    STR_INDEX,
+    STR_SCAN,
+    TOKENIZE_INTO,
+    // Arithmetic and comparison
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MOD,
+    EQ,
+    LT,
+    GT,
+    LTE,
+    GTE,
+    // Control flow and output
+    IF,
+    DO,
+    PRINT,
+    PRINT_INT,
+    PRINT_STRING,
+    ABORT,
+    // Bitwise
+    BIT_AND,
+    BIT_OR,
+    BIT_XOR,
+    BIT_SHL,
+    BIT_SHR,
+    BIT_ASHR,
+    // Functions, symbols and runtime code
+    FUNCTION_ADDRESS,
+    FUNCALL,
+    SYMBOL_COUNT,
+    SYMBOL_BOUND,
+    SYMBOL_ADDRESS,
+    SYMBOL_VALUE,
+    SYMBOL_SET,
+    EVAL,
+    COMPILE,
+    QUOTE,
+    // Names the compiler binds itself
+    FOR_END,
+
+    FORM_COUNT
+};
+
+inline constexpr std::array<std::string_view, FORM_COUNT> FORM_NAMES = {
+    "define-func", "define-int", "define-var", "set", "let",
+    "while", "for",
+    "peek", "poke", "peek-byte", "poke-byte", "peek32", "poke32", "c-call", "intern",
+    "mem-copy", "mem-move", "mem-set", "mem-compare",
+    "mem-copy-bytes", "mem-move-bytes", "mem-set-bytes", "mem-compare-bytes",
+    "str-equal", "str-hash", "str-index", "str-scan", "tokenize-into",
+    "+", "-", "*", "/", "%", "=", "<", ">", "<=", ">=",
+    "if", "do", "print", "print-int", "print-string", "abort",
+    "bit-and", "bit-or", "bit-xor", "bit-shl", "bit-shr", "bit-ashr",
+    "function-address", "funcall", "symbol-count", "symbol-bound?", "symbol-address",
+    "symbol-value", "symbol-set!", "eval", "compile", "quote",
+    "__for_end__"};
+
+constexpr bool all_named() {
+    for (std::string_view name : FORM_NAMES) {
+        if (name.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(all_named(), "every Form needs an entry in FORM_NAMES");
+
+// An interned symbol: its id and the table's copy of its text
+struct Symbol {
+    uint32_t id;
+    std::string_view name;
+};
+
+class Table {
+  public:
+    Table() : slots(new_slots(INITIAL_SLOTS)) {
+        for (std::string_view name : FORM_NAMES) {
+            add(name, std::hash<std::string_view>{}(name));
+        }
+    }
+
+    // Names already in the table are found without the lock
+    Symbol intern(std::string_view name) {
+        const size_t hash = std::hash<std::string_view>{}(name);
+        if (const Entry* entry = find(*slots.load(std::memory_order_acquire), name, hash)) {
+            return {entry->id, entry->name};
+        }
+
+        const std::lock_guard<std::mutex> lock(mutex);
+        const Entry* entry = find(*slots.load(std::memory_order_relaxed), name, hash);
+        if (entry == nullptr) {
+            entry = add(name, hash);
+        }
+        return {entry->id, entry->name};
+    }
+
+    std::string_view name(uint32_t id) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        return entries.at(id).name;
+    }
+
+    size_t size() {
+        const std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+  private:
+    struct Entry {
+        std::string name;
+        uint32_t id;
+        size_t hash;
+    };
+
+    // Open-addressed, at most half full. A slot is written once, after its
+    // entry is complete, so readers need no lock. Growing publishes a bigger
+    // copy; a reader still on the old one misses the newest names and takes
+    // the lock to look again.
+    struct Slots {
+        size_t mask;
+        std::unique_ptr<std::atomic<const Entry*>[]> slot;
+    };
+    static constexpr size_t INITIAL_SLOTS = 1024;
+
+    std::mutex mutex;
+    std::deque<Entry> entries; // Deque, so the names stay put
+    std::vector<std::unique_ptr<Slots>> retired; // Readers may still be on these
+    std::atomic<Slots*> slots;
+
+    static Slots* new_slots(size_t count) {
+        auto* table = new Slots{count - 1, std::make_unique<std::atomic<const Entry*>[]>(count)};
+        for (size_t i = 0; i < count; i++) {
+            table->slot[i].store(nullptr, std::memory_order_relaxed);
+        }
+        return table;
+    }
+
+    static const Entry* find(const Slots& table, std::string_view name, size_t hash) {
+        for (size_t i = hash & table.mask;; i = (i + 1) & table.mask) {
+            const Entry* entry = table.slot[i].load(std::memory_order_acquire);
+            if (entry == nullptr || (entry->hash == hash && entry->name == name)) {
+                return entry;
+            }
+        }
+    }
+
+    static void place(Slots& table, const Entry* entry) {
+        size_t i = entry->hash & table.mask;
+        while (table.slot[i].load(std::memory_order_relaxed) != nullptr) {
+            i = (i + 1) & table.mask;
+        }
+        table.slot[i].store(entry, std::memory_order_release);
+    }
+
+    // Called with the lock held
+    const Entry* add(std::string_view name, size_t hash) {
+        entries.push_back({std::string(name), static_cast<uint32_t>(entries.size()), hash});
+        Slots* table = slots.load(std::memory_order_relaxed);
+        if (entries.size() * 2 > table->mask + 1) {
+            Slots* bigger = new_slots((table->mask + 1) * 2);
+            for (const Entry& entry : entries) {
+                place(*bigger, &entry);
+            }
+            retired.emplace_back(table);
+            slots.store(bigger, std::memory_order_release);
+            return &entries.back();
+        }
+        place(*table, &entries.back());
+        return &entries.back();
+    }
+};
+
+inline Table& table() {
+    static Table instance;
+    return instance;
+}
+
+// Id of name, interning it on first use
+inline uint32_t intern(std::string_view name) {
+    return table().intern(name).id;
+}
+
+// Id and interned text of name in one lookup
+inline Symbol intern_symbol(std::string_view name) {
+    return table().intern(name);
+}
+
+// Text of an interned id; valid for the life of the process
+inline std::string_view name(uint32_t id) {
+    return table().name(id);
+}
+
+// Number of symbols interned so far; every id is below this
+inline size_t count() {
+    return table().size();
+}
+
+} // namespace LispSymbols
@@ -1,6 +1,7 @@
 #pragma once
 #include "lisp_parser.hpp"
 #include <algorithm>
+#include <cctype>
 #include <map>
 #include <set>
 #include <sstream>
@@ -72,7 +73,7 @@ class LispToCppCompiler {
         return result;
     }
 
-    static std::string escape_string(const std::string& str) {
+    static std::string escape_string(std::string_view str) {
         std::string result;
         for (char c : str) {
             if (c == '"') {
@@ -142,7 +143,7 @@ class LispToCppCompiler {
                 return "std::string";
 
             case NodeType::SYMBOL: {
-                std::string sym = node->as_symbol();
+                std::string sym(node->as_symbol());
                 // Check if it's a known variable
                 if (variable_types.find(sym) != variable_types.end()) {
                     return variable_types[sym];
@@ -158,7 +159,7 @@ class LispToCppCompiler {
 
                 if (list[0]->type != NodeType::SYMBOL)
                     return "int64_t";
-                std::string op = list[0]->as_symbol();
+                std::string op(list[0]->as_symbol());
 
                 // String operations return string
                 if (op == "string-concat" || op == "substring") {
@@ -185,7 +186,7 @@ class LispToCppCompiler {
 
                 // set returns the type of the variable being set
                 if (op == "set" && list.size() == 3 && list[1]->type == NodeType::SYMBOL) {
-                    std::string var_name = list[1]->as_symbol();
+                    std::string var_name(list[1]->as_symbol());
                     if (variable_types.find(var_name) != variable_types.end()) {
                         return variable_types[var_name];
                     }
@@ -243,7 +244,7 @@ class LispToCppCompiler {
             }
 
             case NodeType::SYMBOL: {
-                std::string sym = node->as_symbol();
+                std::string sym(node->as_symbol());
                 if (variables.find(sym) != variables.end()) {
                     return variables[sym];
                 }
@@ -260,7 +261,7 @@ class LispToCppCompiler {
                     throw std::runtime_error("First element of list must be a symbol");
                 }
 
-                std::string op = list[0]->as_symbol();
+                std::string op(list[0]->as_symbol());
 
                 // Arithmetic operations
                 if (op == "+")
@@ -321,7 +322,7 @@ class LispToCppCompiler {
                 }
                 if (op == "set") {
                     compile_set(list);
-                    return variables[list[1]->as_symbol()];
+                    return variables[std::string(list[1]->as_symbol())];
                 }
                 if (op == "let")
                     return compile_let(list);
@@ -351,7 +352,7 @@ class LispToCppCompiler {
                     if (list.size() != 2 || list[1]->type != NodeType::STRING) {
                         throw std::runtime_error("c++ requires a string argument: (c++ \"code\")");
                     }
-                    return "(" + list[1]->as_string() + ")";
+                    return "(" + std::string(list[1]->as_string()) + ")";
                 }
 
                 // FFI - Add custom C++ include
@@ -360,7 +361,7 @@ class LispToCppCompiler {
                         throw std::runtime_error(
                             "c++-include requires a string argument: (c++-include \"header.h\")");
                     }
-                    custom_includes.insert(list[1]->as_string());
+                    custom_includes.emplace(list[1]->as_string());
                     return "0LL";
                 }
 
@@ -425,7 +426,7 @@ class LispToCppCompiler {
         return "";
     }
 
-    std::string compile_binary_op(const std::vector<ASTNodePtr>& list, const std::string& cpp_op,
+    std::string compile_binary_op(const ASTList& list, const std::string& cpp_op,
                                   bool multi_arg) {
         if (multi_arg) {
             // Support multi-argument like (+ 1 2 3)
@@ -447,7 +448,7 @@ class LispToCppCompiler {
         }
     }
 
-    std::string compile_if(const std::vector<ASTNodePtr>& list) {
+    std::string compile_if(const ASTList& list) {
         if (list.size() != 4) {
             throw std::runtime_error("if requires 3 arguments: (if cond then else)");
         }
@@ -474,7 +475,7 @@ class LispToCppCompiler {
         return result_var;
     }
 
-    std::string compile_while(const std::vector<ASTNodePtr>& list) {
+    std::string compile_while(const ASTList& list) {
         if (list.size() < 2) {
             throw std::runtime_error("while requires at least 1 argument: (while cond body...)");
         }
@@ -504,7 +505,7 @@ class LispToCppCompiler {
         return "0LL";
     }
 
-    std::string compile_for(const std::vector<ASTNodePtr>& list) {
+    std::string compile_for(const ASTList& list) {
         if (list.size() < 3) {
             throw std::runtime_error(
                 "for requires at least 2 arguments: (for (var start end) body...)");
@@ -515,7 +516,7 @@ class LispToCppCompiler {
         }
 
         const auto& spec = list[1]->as_list();
-        std::string loop_var = spec[0]->as_symbol();
+        std::string loop_var(spec[0]->as_symbol());
         std::string cpp_var = sanitize_name(loop_var);
 
         std::string start = compile_expr(spec[1]);
@@ -553,7 +554,7 @@ class LispToCppCompiler {
         return "0LL";
     }
 
-    std::string compile_do(const std::vector<ASTNodePtr>& list) {
+    std::string compile_do(const ASTList& list) {
         if (list.size() < 2) {
             throw std::runtime_error("do requires at least 1 expression");
         }
@@ -569,7 +570,7 @@ class LispToCppCompiler {
         return result;
     }
 
-    void compile_define(const std::vector<ASTNodePtr>& list) {
+    void compile_define(const ASTList& list) {
         if (list.size() < 3) {
             throw std::runtime_error("define requires at least 2 arguments");
         }
@@ -585,7 +586,7 @@ class LispToCppCompiler {
             throw std::runtime_error("define requires a symbol as first argument");
         }
 
-        std::string var_name = list[1]->as_symbol();
+        std::string var_name(list[1]->as_symbol());
         std::string cpp_var = sanitize_name(var_name);
 
         // Infer type from the expression BEFORE compiling it
@@ -605,7 +606,7 @@ class LispToCppCompiler {
         }
     }
 
-    void compile_set(const std::vector<ASTNodePtr>& list) {
+    void compile_set(const ASTList& list) {
         if (list.size() != 3) {
             throw std::runtime_error("set requires 2 arguments: (set var value)");
         }
@@ -614,7 +615,7 @@ class LispToCppCompiler {
             throw std::runtime_error("set requires a symbol as first argument");
         }
 
-        std::string var_name = list[1]->as_symbol();
+        std::string var_name(list[1]->as_symbol());
 
         if (variables.find(var_name) == variables.end()) {
             throw std::runtime_error("Cannot set undefined variable: " + var_name);
@@ -624,7 +625,7 @@ class LispToCppCompiler {
         code << get_indent() << variables[var_name] << " = " << value << ";\n";
     }
 
-    void compile_function_def(const std::vector<ASTNodePtr>& list) {
+    void compile_function_def(const ASTList& list) {
         // Syntax options:
         // (define (name param1 param2...) body)                    - untyped (backward compatible)
         // (define (name (param1 type1) (param2 type2)) body)      - typed params, inferred return
@@ -635,7 +636,7 @@ class LispToCppCompiler {
             throw std::runtime_error("Function definition requires a name");
         }
 
-        std::string func_name = sig[0]->as_symbol();
+        std::string func_name(sig[0]->as_symbol());
         std::string cpp_func = sanitize_function_name(func_name);
 
         function_names.insert(func_name);
@@ -647,7 +648,7 @@ class LispToCppCompiler {
         for (size_t i = 1; i < sig.size(); i++) {
             if (sig[i]->type == NodeType::SYMBOL) {
                 // Untyped parameter: just a symbol
-                std::string param = sig[i]->as_symbol();
+                std::string param(sig[i]->as_symbol());
                 param_names.push_back(param);
                 param_types.emplace_back("int64_t"); // default type
             } else if (sig[i]->type == NodeType::LIST) {
@@ -657,8 +658,8 @@ class LispToCppCompiler {
                     param_def[1]->type != NodeType::SYMBOL) {
                     throw std::runtime_error("Typed parameter must be (name type)");
                 }
-                std::string param = param_def[0]->as_symbol();
-                std::string type = param_def[1]->as_symbol();
+                std::string param(param_def[0]->as_symbol());
+                std::string type(param_def[1]->as_symbol());
                 param_names.push_back(param);
                 param_types.push_back(lisp_type_to_cpp(type));
             } else {
@@ -688,7 +689,7 @@ class LispToCppCompiler {
             variable_types = old_types;
         } else if (list.size() == 4 && list[2]->type == NodeType::SYMBOL) {
             // (define (name ...) type body) - explicit return type
-            return_type = lisp_type_to_cpp(list[2]->as_symbol());
+            return_type = lisp_type_to_cpp(std::string(list[2]->as_symbol()));
             body_index = 3;
         } else {
             return_type = "int64_t";
@@ -751,8 +752,8 @@ class LispToCppCompiler {
         functions << func_code.str();
     }
 
-    std::string compile_function_call(const std::vector<ASTNodePtr>& list) {
-        std::string func_name = list[0]->as_symbol();
+    std::string compile_function_call(const ASTList& list) {
+        std::string func_name(list[0]->as_symbol());
         std::string cpp_func = sanitize_function_name(func_name);
 
         std::ostringstream call;
@@ -768,7 +769,7 @@ class LispToCppCompiler {
     }
 
     // Let bindings: (let ((var1 val1) (var2 val2)) body...)
-    std::string compile_let(const std::vector<ASTNodePtr>& list) {
+    std::string compile_let(const ASTList& list) {
         if (list.size() < 3) {
             throw std::runtime_error(
                 "let requires at least 2 arguments: (let ((bindings...)) body...)");
@@ -804,7 +805,7 @@ class LispToCppCompiler {
                 throw std::runtime_error("Let binding variable must be a symbol");
             }
 
-            std::string var_name = bind_list[0]->as_symbol();
+            std::string var_name(bind_list[0]->as_symbol());
             std::string cpp_var = sanitize_name(var_name);
             std::string value = compile_expr(bind_list[1]);
 
@@ -848,7 +849,7 @@ class LispToCppCompiler {
     }
 
     // String operations
-    std::string compile_string_length(const std::vector<ASTNodePtr>& list) {
+    std::string compile_string_length(const ASTList& list) {
         if (list.size() != 2) {
             throw std::runtime_error("string-length requires 1 argument");
         }
@@ -856,7 +857,7 @@ class LispToCppCompiler {
         return "(int64_t)" + str + ".length()";
     }
 
-    std::string compile_char_at(const std::vector<ASTNodePtr>& list) {
+    std::string compile_char_at(const ASTList& list) {
         if (list.size() != 3) {
             throw std::runtime_error("char-at requires 2 arguments: (char-at string index)");
         }
@@ -865,7 +866,7 @@ class LispToCppCompiler {
         return "(int64_t)" + str + "[" + index + "]";
     }
 
-    std::string compile_substring(const std::vector<ASTNodePtr>& list) {
+    std::string compile_substring(const ASTList& list) {
         if (list.size() != 4) {
             throw std::runtime_error(
                 "substring requires 3 arguments: (substring string start end)");
@@ -878,7 +879,7 @@ class LispToCppCompiler {
         return "(" + str + ".substr(" + start + ", " + end + " - " + start + "))";
     }
 
-    std::string compile_string_concat(const std::vector<ASTNodePtr>& list) {
+    std::string compile_string_concat(const ASTList& list) {
         if (list.size() < 2) {
             throw std::runtime_error("string-concat requires at least 1 argument");
         }
@@ -897,7 +898,7 @@ class LispToCppCompiler {
     }
 
     // List/Array operations (using std::vector<int64_t>)
-    std::string compile_list(const std::vector<ASTNodePtr>& list) {
+    std::string compile_list(const ASTList& list) {
         std::string vec_var = "vec_" + std::to_string(var_counter++);
 
         code << get_indent() << "std::vector<int64_t> " << vec_var << " = {";
@@ -911,7 +912,7 @@ class LispToCppCompiler {
         return vec_var;
     }
 
-    std::string compile_list_ref(const std::vector<ASTNodePtr>& list) {
+    std::string compile_list_ref(const ASTList& list) {
         if (list.size() != 3) {
             throw std::runtime_error("list-ref requires 2 arguments: (list-ref list index)");
         }
@@ -920,7 +921,7 @@ class LispToCppCompiler {
         return vec + "[" + index + "]";
     }
 
-    std::string compile_list_length(const std::vector<ASTNodePtr>& list) {
+    std::string compile_list_length(const ASTList& list) {
         if (list.size() != 2) {
             throw std::runtime_error("list-length requires 1 argument");
         }
@@ -928,7 +929,7 @@ class LispToCppCompiler {
         return "(int64_t)" + vec + ".size()";
     }
 
-    std::string compile_list_set(const std::vector<ASTNodePtr>& list) {
+    std::string compile_list_set(const ASTList& list) {
         if (list.size() != 4) {
             throw std::runtime_error(
                 "list-set! requires 3 arguments: (list-set! list index value)");
@@ -942,7 +943,7 @@ class LispToCppCompiler {
     }
 
     // Struct operations
-    void compile_struct_def(const std::vector<ASTNodePtr>& list) {
+    void compile_struct_def(const ASTList& list) {
         // (define-struct token (type start end length))
         if (list.size() != 3) {
             throw std::runtime_error(
@@ -957,7 +958,7 @@ class LispToCppCompiler {
             throw std::runtime_error("Struct fields must be a list");
         }
 
-        std::string struct_name = list[1]->as_symbol();
+        std::string struct_name(list[1]->as_symbol());
         const auto& field_nodes = list[2]->as_list();
 
         StructDef def;
@@ -967,7 +968,7 @@ class LispToCppCompiler {
             if (field->type != NodeType::SYMBOL) {
                 throw std::runtime_error("Struct fields must be symbols");
             }
-            def.fields.push_back(field->as_symbol());
+            def.fields.emplace_back(field->as_symbol());
         }
 
         struct_defs[struct_name] = def;
@@ -1009,7 +1010,7 @@ class LispToCppCompiler {
         struct_decls << "};\n\n";
     }
 
-    std::string compile_make_struct(const std::vector<ASTNodePtr>& list,
+    std::string compile_make_struct(const ASTList& list,
                                     const std::string& struct_name) {
         // (make-token 1 0 5 5)
         const auto& def = struct_defs[struct_name];
@@ -1036,7 +1037,7 @@ class LispToCppCompiler {
         return var_name;
     }
 
-    std::string compile_struct_accessor(const std::vector<ASTNodePtr>& list,
+    std::string compile_struct_accessor(const ASTList& list,
                                         const std::string& struct_name, const std::string& field) {
         // (token-type tok)
         if (list.size() != 2) {
@@ -1047,7 +1048,7 @@ class LispToCppCompiler {
         return obj + "." + field;
     }
 
-    std::string compile_struct_mutator(const std::vector<ASTNodePtr>& list,
+    std::string compile_struct_mutator(const ASTList& list,
                                        const std::string& struct_name, const std::string& field) {
         // (set-token-type! tok 2)
         if (list.size() != 3) {
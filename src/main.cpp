@@ -1,12 +1,18 @@
+#include "code_space.hpp"
 #include "eval_context.hpp"
 #include "lisp_compiler.hpp"
+#include "lisp_module.hpp"
 #include "lisp_parser.hpp"
+#include "lisp_reader.hpp"
 #include "stack_vm.hpp"
 #include "symbol_table.hpp"
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // ============================================================================
 // Persistent REPL State
@@ -14,24 +20,27 @@
 
 struct REPLState {
     StackVM vm;
-    SymbolTable symbols;
-    uint64_t next_var_address;
-    uint64_t next_string_address;
-    uint64_t next_code_address; // Track where to load next bytecode
-    EvalContext eval_ctx;       // Context for runtime eval/compile
-
-    static constexpr uint64_t GLOBALS_BASE = 134217728;
-    static constexpr uint64_t STRING_TABLE_START = GLOBALS_BASE;
-    static constexpr uint64_t VAR_START = GLOBALS_BASE + 100000000;
-
-    REPLState()
-        : next_var_address(VAR_START), next_string_address(STRING_TABLE_START),
-          next_code_address(0) {
-        // Initialize eval context
-        eval_ctx.symbols = &symbols;
-        eval_ctx.next_var_address = &next_var_address;
-        eval_ctx.next_string_address = &next_string_address;
-        eval_ctx.next_code_address = &next_code_address;
+    // One compiler for the whole session, in incremental mode: it keeps the
+    // globals, functions and strings of everything compiled so far, so each
+    // new form only compiles (and loads) what it adds
+    LispCompiler compiler;
+    CodeSpace code;       // Where each compiled program is loaded
+    EvalContext eval_ctx; // Context for runtime eval/compile
+
+    // Look for dead code after this many words have been loaded, as well as
+    // whenever the code segment is full
+    static constexpr uint64_t CODE_COLLECT_INTERVAL = 1 << 20;
+
+    REPLState() : code(MemoryLayout::CODE_SIZE) {
+        compiler.set_incremental(true);
+
+        // Initialize eval context; data addresses are owned by the compiler
+        // and code addresses by the code space. The compiler's symbol table
+        // lets the VM cache eval/compile results.
+        eval_ctx.symbols = &compiler.get_symbol_table();
+        eval_ctx.next_var_address = nullptr;
+        eval_ctx.next_string_address = nullptr;
+        eval_ctx.next_code_address = nullptr;
 
         // Set up callback for EVAL opcode (compile with RET for execution)
         eval_ctx.compile_for_eval = [this](StackVM& /*vm*/, const std::string& code) -> uint64_t {
@@ -48,103 +57,169 @@ struct REPLState {
         vm.set_eval_context(&eval_ctx);
     }
 
+    [[nodiscard]] const SymbolTable& symbols() const {
+        return compiler.get_symbol_table();
+    }
+
     void reset() {
         vm.reset();
-        symbols.clear();
-        next_var_address = VAR_START;
-        next_string_address = STRING_TABLE_START;
-        next_code_address = 0;
+        compiler.reset();
+        code.clear();
+        eval_ctx.eval_cache.clear();
+        eval_ctx.compile_cache.clear();
         // Re-establish eval context on VM after reset
         vm.set_eval_context(&eval_ctx);
     }
 
-    // Helper: compile code that can be called (ends with RET 0)
+    // Helper: compile code that can be called (ends with RET), answering
+    // its entry point past the function header
     uint64_t compile_code_for_call(const std::string& code) {
         LispParser parser(code);
         auto ast = parser.parse();
 
-        LispCompiler compiler;
-        compiler.import_symbols(symbols);
-        compiler.set_next_var_address(next_var_address);
-        compiler.set_next_string_address(next_string_address);
-        compiler.set_code_base_address(next_code_address);
+        CompiledProgram program;
+        return load([&] { return compiler.compile_as_function(ast); }, program) +
+               FunctionHeader::SIZE;
+    }
 
-        // Compile as function (ends with RET 0)
-        auto program = compiler.compile_as_function(ast);
+    // Compile with compile() and load the result into a block of the code
+    // space, returning its address. The compiler needs the address up front,
+    // so code is compiled for the top of the used area and compiled again
+    // if the block it gets is a free one lower down.
+    template <typename Compile> uint64_t load(const Compile& compile, CompiledProgram& program) {
+        if (code.get_allocated_since_collect() >= CODE_COLLECT_INTERVAL) {
+            collect_code();
+        }
+        compiler.set_code_base_address(code.get_top());
+        program = compile();
+
+        std::optional<uint64_t> addr = allocate_code(program.bytecode.size());
+        if (!addr) {
+            compiler.retract();
+            throw VMException::ProgramTooLarge(program.bytecode.size(),
+                                               MemoryLayout::CODE_SIZE - code.used());
+        }
+        if (*addr != compiler.get_code_base_address()) {
+            compiler.retract();
+            compiler.set_code_base_address(*addr);
+            program = compile();
+        }
 
-        uint64_t code_addr = next_code_address;
-        vm.load_program_at(program, code_addr);
+        vm.load_program_at(program, *addr);
+        code.set_refs(*addr, code_addresses(program));
         compiler.write_strings_to_memory(vm);
+        return *addr;
+    }
 
-        // Update state with new symbols
-        symbols.merge(compiler.get_symbol_table());
-        next_var_address = compiler.get_next_var_address();
-        next_string_address = compiler.get_next_string_address();
-        next_code_address += program.bytecode.size();
+    // The code addresses program holds: call, jump and fallback targets and
+    // the words listed in code_refs
+    static std::vector<uint64_t> code_addresses(const CompiledProgram& program) {
+        const std::vector<uint64_t>& words = program.bytecode;
+        std::vector<uint64_t> addrs;
+        for (size_t pos = 0; pos < words.size();) {
+            const auto op = static_cast<Opcode>(words[pos] & 0xFF);
+            if (FunctionHeader::is_header(words[pos]) || opcode_operand_count(op) == 0) {
+                pos++;
+                continue;
+            }
+            if (ByteCode::takes_code_address(op) && pos + 1 < words.size()) {
+                addrs.push_back(words[pos + 1]);
+            }
+            pos += 2;
+        }
+        for (size_t pos : program.code_refs) {
+            addrs.push_back(words[pos]);
+        }
+        return addrs;
+    }
+
+    // A block of the code space, collecting first if it is full
+    std::optional<uint64_t> allocate_code(uint64_t size) {
+        std::optional<uint64_t> addr = code.allocate(size);
+        if (!addr) {
+            collect_code();
+            addr = code.allocate(size);
+        }
+        return addr;
+    }
+
+    // Link a module into the code space after everything loaded so far and
+    // make its symbols visible to later compiles, returning the address of
+    // its top-level code. Modules need no recompiling to go wherever there
+    // is room.
+    uint64_t link_module(const LispModule& module) {
+        const std::optional<uint64_t> addr = allocate_code(module.code.size());
+        if (!addr) {
+            throw VMException::ProgramTooLarge(module.code.size(),
+                                               MemoryLayout::CODE_SIZE - code.used());
+        }
 
-        return code_addr;
+        ModuleLinker linker(compiler.get_next_var_address(), compiler.get_next_string_address());
+        SymbolTable linked = symbols();
+        CompiledProgram program;
+        try {
+            program = linker.link(module, *addr, linked);
+        } catch (...) {
+            collect_code(); // Nothing refers to the block yet
+            throw;
+        }
+        vm.load_program_at(program, *addr);
+        code.set_refs(*addr, code_addresses(program));
+        compiler.import_symbols(linked);
+        compiler.set_next_var_address(linker.get_next_var_address());
+        compiler.set_next_string_address(linker.get_next_string_address());
+        return *addr;
+    }
+
+    // Free the code blocks nothing refers to: not a function, a global's
+    // value, the VM's ip or stack, a signal handler or another live block
+    void collect_code() {
+        std::vector<uint64_t> roots = vm.code_roots();
+        for (const auto& entry : symbols().all_symbols()) {
+            roots.push_back(entry.is_function() ? entry.address
+                                                : vm.read_memory(entry.address));
+        }
+        code.collect(roots);
+
+        auto live = [this](uint64_t addr) { return code.contains(addr); };
+        eval_ctx.eval_cache.retain(live);
+        eval_ctx.compile_cache.retain(live);
     }
 
     bool compile_and_execute(const std::string& source, bool verbose = false);
+    bool execute_form(ASTNodePtr ast, bool verbose = false);
+    void run(uint64_t start_addr, bool verbose);
 };
 
 bool REPLState::compile_and_execute(const std::string& source, bool verbose) {
     try {
-        // Parse
         LispParser parser(source);
-        auto ast = parser.parse();
-
-        // Create a new compiler for this expression
-        LispCompiler compiler;
-
-        // Import existing symbols from previous compilations
-        compiler.import_symbols(symbols);
-        compiler.set_next_var_address(next_var_address);
-        compiler.set_next_string_address(next_string_address);
-        compiler.set_code_base_address(next_code_address);
+        return execute_form(parser.parse(), verbose);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return false;
+    }
+}
 
-        // Compile
-        auto program = compiler.compile(ast);
+// Compile and run one parsed top-level form
+bool REPLState::execute_form(ASTNodePtr ast, bool verbose) {
+    try {
+        // Compile against everything defined so far (a form that fails to
+        // compile leaves no definitions behind) and load it into its own
+        // block, which nested compile_for_eval calls won't reuse while it runs
+        CompiledProgram program;
+        const uint64_t start_addr = load([&] { return compiler.compile(ast); }, program);
 
         if (verbose) {
-            std::cout << "Bytecode (" << program.bytecode.size() << " words) @ "
-                      << next_code_address << ":" << '\n';
+            std::cout << "Bytecode (" << program.bytecode.size() << " words) @ " << start_addr
+                      << ":" << '\n';
             for (size_t i = 0; i < program.bytecode.size(); i++) {
-                std::cout << "  " << (next_code_address + i) << ": " << program.bytecode[i] << '\n';
+                std::cout << "  " << (start_addr + i) << ": " << program.bytecode[i] << '\n';
             }
             std::cout << std::flush;
         }
 
-        // Reset VM IP to start of new code (preserves memory contents)
-        vm.reset();
-
-        // Load at the code base address (appending to existing code)
-        vm.load_program_at(program, next_code_address);
-        compiler.write_strings_to_memory(vm);
-
-        // Update next_code_address BEFORE execute so that any nested
-        // compile_for_eval calls don't overwrite the current program
-        uint64_t start_addr = next_code_address;
-        next_code_address += program.bytecode.size();
-
-        // Set IP to start of this code block
-        vm.set_ip(start_addr);
-
-        if (verbose) {
-            std::cout << "Starting execution at IP=" << start_addr << '\n';
-            std::cout << std::flush;
-        }
-
-        // Execute with instruction limit for safety (prevent infinite loops)
-        vm.execute(1000000);
-
-        // Update persistent state with new symbols
-        symbols.merge(compiler.get_symbol_table());
-        next_var_address = compiler.get_next_var_address();
-        next_string_address = compiler.get_next_string_address();
-
-        // Print result
-        std::cout << "=> " << static_cast<int64_t>(vm.get_top()) << '\n';
+        run(start_addr, verbose);
         return true;
 
     } catch (const std::exception& e) {
@@ -153,6 +228,26 @@ bool REPLState::compile_and_execute(const std::string& source, bool verbose) {
     }
 }
 
+// Run the code loaded at start_addr and print what it leaves on the stack
+void REPLState::run(uint64_t start_addr, bool verbose) {
+    // Reset VM IP to start of new code (preserves memory contents)
+    vm.reset();
+
+    // Set IP to start of this code block
+    vm.set_ip(start_addr);
+
+    if (verbose) {
+        std::cout << "Starting execution at IP=" << start_addr << '\n';
+        std::cout << std::flush;
+    }
+
+    // Execute with instruction limit for safety (prevent infinite loops)
+    vm.execute(1000000);
+
+    // Print result
+    std::cout << "=> " << static_cast<int64_t>(vm.get_top()) << '\n';
+}
+
 // ============================================================================
 // REPL Command Handlers
 // ============================================================================
@@ -165,13 +260,15 @@ void cmd_help() {
     std::cout << "  :funcs         - List functions with signatures" << '\n';
     std::cout << "  :eval <name>   - Print value of variable" << '\n';
     std::cout << "  :set <name> <value>  - Set variable to new value" << '\n';
+    std::cout << "  :cache         - Show eval/compile cache statistics" << '\n';
+    std::cout << "  :gc            - Free unreferenced code and show code space usage" << '\n';
     std::cout << "  :reset         - Clear all state" << '\n';
     std::cout << "  :verbose       - Toggle verbose mode (show bytecode)" << '\n';
     std::cout << "  quit / exit    - Exit the REPL" << '\n';
 }
 
 void cmd_symbols(const REPLState& state) {
-    auto all = state.symbols.all_symbols();
+    auto all = state.symbols().all_symbols();
     if (all.empty()) {
         std::cout << "No symbols defined." << '\n';
         return;
@@ -194,7 +291,7 @@ void cmd_symbols(const REPLState& state) {
 }
 
 void cmd_vars(REPLState& state) {
-    auto vars = state.symbols.all_variables();
+    auto vars = state.symbols().all_variables();
     if (vars.empty()) {
         std::cout << "No variables defined." << '\n';
         return;
@@ -208,7 +305,7 @@ void cmd_vars(REPLState& state) {
 }
 
 void cmd_funcs(const REPLState& state) {
-    auto funcs = state.symbols.all_functions();
+    auto funcs = state.symbols().all_functions();
     if (funcs.empty()) {
         std::cout << "No functions defined." << '\n';
         return;
@@ -225,7 +322,7 @@ void cmd_funcs(const REPLState& state) {
 }
 
 void cmd_eval(REPLState& state, const std::string& name) {
-    auto entry = state.symbols.lookup(name);
+    auto entry = state.symbols().lookup(name);
     if (!entry.has_value()) {
         std::cerr << "Error: Unknown symbol: " << name << '\n';
         return;
@@ -241,7 +338,7 @@ void cmd_eval(REPLState& state, const std::string& name) {
 }
 
 void cmd_set(REPLState& state, const std::string& name, const std::string& value_str) {
-    auto entry = state.symbols.lookup(name);
+    auto entry = state.symbols().lookup(name);
     if (!entry.has_value()) {
         std::cerr << "Error: Unknown symbol: " << name << '\n';
         return;
@@ -261,6 +358,30 @@ void cmd_set(REPLState& state, const std::string& name, const std::string& value
     }
 }
 
+void cmd_cache(const REPLState& state) {
+    auto show = [](const char* name, const EvalCache& cache) {
+        const auto& stats = cache.get_stats();
+        std::cout << "  " << name << cache.size() << " entries, " << stats.hits << " hits, "
+                  << stats.misses << " misses (" << stats.invalidations << " stale), "
+                  << static_cast<int>(cache.hit_rate() * 100) << "% hit rate" << '\n';
+    };
+    std::cout << "Eval/compile cache:" << '\n';
+    show("eval:    ", state.eval_ctx.eval_cache);
+    show("compile: ", state.eval_ctx.compile_cache);
+}
+
+void cmd_gc(REPLState& state) {
+    const uint64_t freed = state.code.get_stats().words_freed;
+    state.collect_code();
+    const auto& stats = state.code.get_stats();
+    std::cout << "Freed " << stats.words_freed - freed << " words of code" << '\n';
+    std::cout << "Code space: " << state.code.used() << " words in " << state.code.block_count()
+              << " blocks, top " << state.code.get_top() << ", " << state.code.free_block_count()
+              << " free blocks" << '\n';
+    std::cout << "Collections: " << stats.collections << ", " << stats.blocks_freed
+              << " blocks and " << stats.words_freed << " words freed in total" << '\n';
+}
+
 // ============================================================================
 // Command Parsing and Dispatch
 // ============================================================================
@@ -298,6 +419,12 @@ bool handle_command(REPLState& state, const std::string& line, bool& verbose) {
             std::cerr << "Usage: :set <name> <value>" << '\n';
         }
         return true;
+    } else if (cmd == ":cache") {
+        cmd_cache(state);
+        return true;
+    } else if (cmd == ":gc") {
+        cmd_gc(state);
+        return true;
     } else if (cmd == ":reset") {
         state.reset();
         std::cout << "REPL state cleared." << '\n';
@@ -352,23 +479,74 @@ void run_demo(REPLState& state) {
 // Main Entry Point
 // ============================================================================
 
-// Load and execute a file, returns true on success
+// Load and execute a file, returns true on success. The file is read in
+// chunks and each top-level form runs as soon as it has been read.
 bool load_file(REPLState& state, const std::string& filename, bool verbose = false) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
         std::cerr << "Error: Cannot open file: " << filename << '\n';
         return false;
     }
 
+    if (verbose) {
+        struct stat info {};
+        fstat(fd, &info);
+        std::cout << "Loading: " << filename << " (" << info.st_size << " bytes)" << '\n';
+    }
+
+    bool ok = true;
+    try {
+        LispReader reader(fd);
+        while (ASTNodePtr form = reader.next()) {
+            if (!state.execute_form(form, verbose)) {
+                ok = false;
+                break;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        ok = false;
+    }
+    close(fd);
+    return ok;
+}
+
+// Load a file as a module (see lisp_module.hpp): taken from the cache if
+// it has been compiled before against the same imports, else compiled and
+// cached. Its top-level forms then run as one program.
+bool load_module(REPLState& state, ModuleCache& cache, const std::string& filename,
+                 bool verbose = false) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open file: " << filename << '\n';
+        return false;
+    }
     std::stringstream buffer;
     buffer << file.rdbuf();
-    std::string content = buffer.str();
+    const std::string source = buffer.str();
 
-    if (verbose) {
-        std::cout << "Loading: " << filename << " (" << content.size() << " bytes)" << '\n';
-    }
+    try {
+        const uint64_t hash = LispModule::hash(source);
+        std::optional<LispModule> module = cache.load(hash, state.symbols());
+        const bool cached = module.has_value();
+        if (!cached) {
+            LispParser parser(source);
+            LispCompiler compiler;
+            module = compiler.compile_module(parser.parse_all(), state.symbols());
+            module->source_hash = hash;
+            cache.store(*module);
+        }
+        if (verbose) {
+            std::cout << "Module: " << filename << " (" << module->code.size() << " words, "
+                      << (cached ? "cached" : "compiled") << ")" << '\n';
+        }
 
-    return state.compile_and_execute(content, verbose);
+        state.run(state.link_module(*module), verbose);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << filename << ": " << e.what() << '\n';
+        return false;
+    }
 }
 
 int main(int argc, char* argv[]) {
@@ -377,14 +555,19 @@ int main(int argc, char* argv[]) {
 
     // Check for flags and files
     std::vector<std::string> files;
+    std::optional<ModuleCache> modules;
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
         if (arg == "-v" || arg == "--verbose") {
             verbose = true;
+        } else if ((arg == "-m" || arg == "--modules") && i + 1 < argc) {
+            modules.emplace(argv[++i]);
         } else if (arg == "-h" || arg == "--help") {
             std::cout << "Usage: " << argv[0] << " [options] [file1.lisp file2.lisp ...]" << '\n';
             std::cout << "Options:" << '\n';
             std::cout << "  -v, --verbose  Show bytecode during execution" << '\n';
+            std::cout << "  -m, --modules <dir>" << '\n';
+            std::cout << "                 Compile each file as a module, cached in dir" << '\n';
             std::cout << "  -h, --help     Show this help message" << '\n';
             std::cout << '\n';
             std::cout << "If no files are provided, runs interactive REPL." << '\n';
@@ -397,7 +580,9 @@ int main(int argc, char* argv[]) {
     // If files provided, execute them in order
     if (!files.empty()) {
         for (const auto& filename : files) {
-            if (!load_file(state, filename, verbose)) {
+            const bool ok = modules ? load_module(state, *modules, filename, verbose)
+                                    : load_file(state, filename, verbose);
+            if (!ok) {
                 return 1;
             }
         }
@@ -130,28 +130,30 @@ class MicrocodeCompiler {
             throw std::runtime_error("defmicro: params must be a list");
         }
 
-        std::string name = items[1]->as_symbol();
+        std::string name(items[1]->as_symbol());
         const auto& params = items[2]->as_list();
         ASTNodePtr body = items[3];
 
         // Create a function that implements the microcode
         // (define (name param1 param2 ...) body)
+        // The new nodes go in a local arena; the rest are the parser's
+        ASTArena arena;
         std::vector<ASTNodePtr> func_def;
-        func_def.push_back(ASTNode::make_symbol("define-func"));
+        func_def.push_back(arena.make_symbol("define-func"));
 
         // Function signature
         std::vector<ASTNodePtr> signature;
-        signature.push_back(ASTNode::make_symbol(name));
+        signature.push_back(items[1]);
         for (const auto& param : params) {
             if (param->type != NodeType::SYMBOL) {
                 throw std::runtime_error("defmicro: all params must be symbols");
             }
             signature.push_back(param);
         }
-        func_def.push_back(ASTNode::make_list(signature));
+        func_def.push_back(arena.make_list(signature));
         func_def.push_back(body);
 
-        auto func_ast = ASTNode::make_list(func_def);
+        auto func_ast = arena.make_list(func_def);
 
         // Compile the function
         LispCompiler compiler;
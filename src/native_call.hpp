@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+class StackVM;
+
+// ============================================================================
+// Native Function Interface
+// ============================================================================
+// C_CALL dispatches through a flat table of native functions indexed by id
+// (see StackVM::register_native). A native receives the VM and a view of its
+// arguments straight over the VM stack, and answers one word.
+
+// Arguments of a native call, read in place from the VM stack. The stack
+// grows down, so the first argument pushed sits at the highest address;
+// args[0] is still the first argument.
+class NativeArgs {
+  public:
+    NativeArgs(const uint64_t* top, size_t count) : top(top), count(count) {}
+
+    uint64_t operator[](size_t i) const {
+        return top[count - 1 - i];
+    }
+
+    [[nodiscard]] size_t size() const {
+        return count;
+    }
+
+  private:
+    const uint64_t* top; // Last argument pushed (lowest address)
+    size_t count;
+};
+
+using NativeFn = uint64_t (*)(StackVM& vm, NativeArgs args);
+
+struct NativeEntry {
+    NativeFn fn{nullptr};
+    size_t arity{0};
+    const char* name{nullptr};
+};
@@ -9,51 +9,75 @@
 
 enum class Opcode : uint8_t {
     HALT = 0,
-    PUSH,       // Push immediate 64-bit value
-    POP,        // Pop and discard
-    DUP,        // Duplicate top
-    SWAP,       // Swap top two elements
-    ADD,        // Pop two, push sum
-    SUB,        // Pop two, push difference
-    MUL,        // Pop two, push product
-    DIV,        // Pop two, push quotient
-    MOD,        // Pop two, push remainder
-    EQ,         // Pop two, push 1 if equal, 0 otherwise
-    LT,         // Pop two, push 1 if less than, 0 otherwise
-    GT,         // Pop two, push 1 if greater than, 0 otherwise
-    LTE,        // Pop two, push 1 if less than or equal, 0 otherwise
-    GTE,        // Pop two, push 1 if greater than or equal, 0 otherwise
-    JMP,        // Unconditional jump to address
-    JZ,         // Jump if top of stack is zero
-    ENTER,      // Save previous BP to the stack set it to SP
-    LEAVE,      // Restore BP from the stack
-    CALL,       // Call function at address
-    RET,        // Return from function
-    IRET,       // Return from interruption
-    LOAD,       // Load 64-bit word from memory address on stack
-    STORE,      // Store 64-bit word to memory address
-    LOAD_BYTE,  // Load byte from memory (address on stack)
-    STORE_BYTE, // Store byte to memory (value, address on stack)
-    LOAD32,     // Load 32-bit word from memory
-    STORE32,    // Store 32-bit word to memory
-    BP_LOAD,    // Load from base pointer offset
-    BP_STORE,   // Store to base pointer offset
-    PRINT,      // Debug: print top of stack as integer
-    PRINT_STR,  // Debug: print string at address on stack
-    AND,        // Bitwise AND
-    OR,         // Bitwise OR
-    XOR,        // Bitwise XOR
-    SHL,        // Shift left
-    SHR,        // Shift right (logical)
-    ASHR,       // Arithmetic shift right
-    CLI,        // Clear interrupt flag
-    STI,        // Set interrupt flag
-    SIGNAL_REG, // Register signal handler
-    ABORT,      // Abort with error message (address on stack)
-    FUNCALL,    // Call function at address on stack (address, arg_count on stack)
-    EVAL,       // Pop string addr, compile+execute, push result
-    COMPILE,    // Pop string addr, compile, push code address
-    C_CALL,     // Call C function: [func_id, arg_count, args...] -> [result]
+    PUSH,         // Push immediate 64-bit value
+    POP,          // Pop and discard
+    DUP,          // Duplicate top
+    SWAP,         // Swap top two elements
+    ADD,          // Pop two, push sum
+    SUB,          // Pop two, push difference
+    MUL,          // Pop two, push product
+    DIV,          // Pop two, push quotient
+    MOD,          // Pop two, push remainder
+    EQ,           // Pop two, push 1 if equal, 0 otherwise
+    LT,           // Pop two, push 1 if less than, 0 otherwise
+    GT,           // Pop two, push 1 if greater than, 0 otherwise
+    LTE,          // Pop two, push 1 if less than or equal, 0 otherwise
+    GTE,          // Pop two, push 1 if greater than or equal, 0 otherwise
+    JMP,          // Unconditional jump to address
+    JZ,           // Jump if top of stack is zero
+    ENTER,        // Reserve zeroed temporaries, save BP and set it to SP
+    LEAVE,        // Drop the temporaries and restore BP, keeping the result
+    CALL,         // Call function at address, entering the frame its header describes
+    RET,          // Return from function, dropping its frame and arguments
+    IRET,         // Return from interruption
+    LOAD,         // Load 64-bit word from memory address on stack
+    STORE,        // Store 64-bit word to memory address
+    LOAD_BYTE,    // Load byte from memory (address on stack)
+    STORE_BYTE,   // Store byte to memory (value, address on stack)
+    LOAD32,       // Load 32-bit word from memory
+    STORE32,      // Store 32-bit word to memory
+    BP_LOAD,      // Load from base pointer offset
+    BP_STORE,     // Store to base pointer offset
+    PRINT,        // Debug: print top of stack as integer
+    PRINT_STR,    // Debug: print string at address on stack
+    AND,          // Bitwise AND
+    OR,           // Bitwise OR
+    XOR,          // Bitwise XOR
+    SHL,          // Shift left
+    SHR,          // Shift right (logical)
+    ASHR,         // Arithmetic shift right
+    CLI,          // Clear interrupt flag
+    STI,          // Set interrupt flag
+    SIGNAL_REG,   // Register signal handler
+    ABORT,        // Abort with error message (address on stack)
+    FUNCALL,      // Call function at address on stack (address, arg_count on stack)
+    EVAL,         // Pop string addr, compile+execute, push result
+    COMPILE,      // Pop string addr, compile, push code address
+    C_CALL,       // Call C function: [func_id, arg_count, args...] -> [result]
+    SEND_CACHED,  // Message send through a per-site polymorphic inline cache
+    TADD,         // SmallInteger add, jump to the send fallback on non-int/overflow
+    TSUB,         // SmallInteger subtract, jump to the send fallback on non-int/overflow
+    TMUL,         // SmallInteger multiply, jump to the send fallback on non-int/overflow
+    TEQ,          // SmallInteger =, jump to the send fallback on non-int
+    TLT,          // SmallInteger <, jump to the send fallback on non-int
+    TGT,          // SmallInteger >, jump to the send fallback on non-int
+    TLTE,         // SmallInteger <=, jump to the send fallback on non-int
+    TGTE,         // SmallInteger >=, jump to the send fallback on non-int
+    INTERN,       // Intern string slice as a selector: [str, start, len, id] -> [tagged id]
+    MEMCPY,       // Copy words, ranges must not overlap: [dst, src, count] -> [dst]
+    MEMMOVE,      // Copy words, ranges may overlap: [dst, src, count] -> [dst]
+    MEMSET,       // Fill words: [dst, value, count] -> [dst]
+    MEMCMP,       // Compare words as unsigned: [a, b, count] -> [-1/0/1]
+    MEMCPY_BYTE,  // MEMCPY on byte addresses and byte counts
+    MEMMOVE_BYTE, // MEMMOVE on byte addresses and byte counts
+    MEMSET_BYTE,  // MEMSET on byte addresses with the low byte of value
+    MEMCMP_BYTE,  // MEMCMP on byte addresses, bytes compared as unsigned
+    STR_EQ,       // Packed strings equal: [a, b] -> [1/0]
+    STR_HASH,     // DJB2 hash of a packed string: [str] -> [hash]
+    STR_INDEX,    // First char at or after start: [str, start, char] -> [index or -1]
+    STR_SCAN,     // Skip a character class: [str, start, classes] -> [end index]
+    TOKENIZE,     // Lex Smalltalk source into token records: [str, records, max] -> [count]
+    FUNCTION,     // Function header in front of an entry point (function_header.hpp); no-op
 };
 
 // ============================================================================
@@ -155,7 +179,79 @@ inline const char* opcode_name(Opcode op) {
             return "COMPILE";
         case Opcode::C_CALL:
             return "C_CALL";
+        case Opcode::SEND_CACHED:
+            return "SEND_CACHED";
+        case Opcode::TADD:
+            return "TADD";
+        case Opcode::TSUB:
+            return "TSUB";
+        case Opcode::TMUL:
+            return "TMUL";
+        case Opcode::TEQ:
+            return "TEQ";
+        case Opcode::TLT:
+            return "TLT";
+        case Opcode::TGT:
+            return "TGT";
+        case Opcode::TLTE:
+            return "TLTE";
+        case Opcode::TGTE:
+            return "TGTE";
+        case Opcode::INTERN:
+            return "INTERN";
+        case Opcode::MEMCPY:
+            return "MEMCPY";
+        case Opcode::MEMMOVE:
+            return "MEMMOVE";
+        case Opcode::MEMSET:
+            return "MEMSET";
+        case Opcode::MEMCMP:
+            return "MEMCMP";
+        case Opcode::MEMCPY_BYTE:
+            return "MEMCPY_BYTE";
+        case Opcode::MEMMOVE_BYTE:
+            return "MEMMOVE_BYTE";
+        case Opcode::MEMSET_BYTE:
+            return "MEMSET_BYTE";
+        case Opcode::MEMCMP_BYTE:
+            return "MEMCMP_BYTE";
+        case Opcode::STR_EQ:
+            return "STR_EQ";
+        case Opcode::STR_HASH:
+            return "STR_HASH";
+        case Opcode::STR_INDEX:
+            return "STR_INDEX";
+        case Opcode::STR_SCAN:
+            return "STR_SCAN";
+        case Opcode::TOKENIZE:
+            return "TOKENIZE";
+        case Opcode::FUNCTION:
+            return "FUNCTION";
         default:
             return "UNKNOWN";
     }
 }
+
+// Immediate operands that follow the opcode in the instruction stream
+inline int opcode_operand_count(Opcode op) {
+    switch (op) {
+        case Opcode::PUSH:
+        case Opcode::JMP:
+        case Opcode::JZ:
+        case Opcode::ENTER:
+        case Opcode::LEAVE:
+        case Opcode::CALL:
+        case Opcode::SEND_CACHED:
+        case Opcode::TADD:
+        case Opcode::TSUB:
+        case Opcode::TMUL:
+        case Opcode::TEQ:
+        case Opcode::TLT:
+        case Opcode::TGT:
+        case Opcode::TLTE:
+        case Opcode::TGTE:
+            return 1;
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Send site layout for the SEND_CACHED opcode
+//
+// Every SEND_CACHED instruction carries the address of a send site: a small
+// block of words in the heap, allocated by the Smalltalk compiler, that holds
+// a polymorphic inline cache for that single call site.
+//
+// [SELECTOR]  Tagged selector id (used by the miss handler)
+// [NARGS]     Number of arguments, not counting the receiver
+// [HANDLER]   Code address of the miss handler for this arity
+// [STATE]     Number of filled entries (0..MAX_ENTRIES) or MEGAMORPHIC
+// [HITS]      Sends resolved by the cache
+// [MISSES]    Sends that went through the miss handler
+// [NEXT]      Next site in the runtime's chain for this selector (for flushing)
+// [CLASS0][TARGET0] ... [CLASS3][TARGET3]
+//
+// The layout is mirrored by the SEND_SITE_* constants in
+// lisp/smalltalk/03-methods.lisp.
+
+namespace SendSite {
+constexpr size_t SELECTOR = 0;
+constexpr size_t NARGS = 1;
+constexpr size_t HANDLER = 2;
+constexpr size_t STATE = 3;
+constexpr size_t HITS = 4;
+constexpr size_t MISSES = 5;
+constexpr size_t NEXT = 6;
+constexpr size_t ENTRIES = 7;
+
+constexpr uint64_t MAX_ENTRIES = 4;
+constexpr uint64_t MEGAMORPHIC = MAX_ENTRIES + 1;
+constexpr size_t SIZE = ENTRIES + 2 * MAX_ENTRIES;
+
+// Class keys: tagged SmallIntegers share one key, NULL has its own, and
+// heap objects are keyed by their behavior word (the class pointer)
+constexpr uint64_t SMALL_INTEGER_KEY = 1;
+constexpr uint64_t NIL_KEY = 0;
+
+inline constexpr size_t entry_class(uint64_t i) {
+    return ENTRIES + 2 * i;
+}
+
+inline constexpr size_t entry_target(uint64_t i) {
+    return ENTRIES + 2 * i + 1;
+}
+
+// Aggregate counters over the send sites seen while profiling
+struct Stats {
+    uint64_t sites{0};
+    uint64_t unused{0};
+    uint64_t monomorphic{0};
+    uint64_t polymorphic{0};
+    uint64_t megamorphic{0};
+    uint64_t hits{0};
+    uint64_t misses{0};
+};
+} // namespace SendSite
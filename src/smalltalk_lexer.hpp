@@ -0,0 +1,114 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================================
+// Native Smalltalk Lexer
+// ============================================================================
+// The lexer behind the TOKENIZE opcode, which `tokenize` in
+// lisp/smalltalk/04-tokenizer.lisp runs over method source. One token per
+// call to next():
+//
+//   NUMBER      decimal digits, value is the number
+//   IDENTIFIER  letter then letters/digits, value is the start index
+//   KEYWORD     identifier followed by ':', which the token includes
+//   BINARY_OP   one of + - * / < > =, or <= / >= packed low byte first
+//   END         end of input, a NUL byte, or a character that starts no
+//               token; start == end and value is 0
+//
+// Every byte is classified through one 256-entry table, so each step of
+// the scan is a table load and a mask test.
+
+// Character classes, one bit per class, for every byte value
+namespace SmalltalkChars {
+
+constexpr uint8_t SPACE = 1;
+constexpr uint8_t DIGIT = 2;
+constexpr uint8_t LETTER = 4;
+constexpr uint8_t BINARY = 8;
+
+constexpr std::array<uint8_t, 256> make_classes() {
+    std::array<uint8_t, 256> classes{};
+    for (int c = '0'; c <= '9'; c++) {
+        classes[c] = DIGIT;
+    }
+    for (int c = 'A'; c <= 'Z'; c++) {
+        classes[c] = LETTER;
+        classes[c + ('a' - 'A')] = LETTER;
+    }
+    for (const char c : {' ', '\t', '\n', '\r'}) {
+        classes[static_cast<uint8_t>(c)] = SPACE;
+    }
+    for (const char c : {'+', '-', '*', '/', '<', '>', '='}) {
+        classes[static_cast<uint8_t>(c)] = BINARY;
+    }
+    return classes;
+}
+
+inline constexpr std::array<uint8_t, 256> CLASSES = make_classes();
+
+} // namespace SmalltalkChars
+
+class SmalltalkLexer {
+  public:
+    // Token types, matching TOK_* in 04-tokenizer.lisp
+    static constexpr uint64_t NUMBER = 1;
+    static constexpr uint64_t IDENTIFIER = 2;
+    static constexpr uint64_t KEYWORD = 3;
+    static constexpr uint64_t BINARY_OP = 5;
+    static constexpr uint64_t END = 99;
+
+    struct Token {
+        uint64_t type;
+        uint64_t value;
+        size_t start;
+        size_t end;
+    };
+
+    SmalltalkLexer(const uint8_t* source, size_t length) : source(source), length(length) {}
+
+    Token next() {
+        using namespace SmalltalkChars;
+        while (pos < length && (CLASSES[source[pos]] & SPACE) != 0) {
+            pos++;
+        }
+        const size_t start = pos;
+        const uint8_t c = pos < length ? source[pos] : 0;
+        const uint8_t cls = CLASSES[c];
+
+        if ((cls & DIGIT) != 0) {
+            uint64_t number = 0;
+            while (pos < length && (CLASSES[source[pos]] & DIGIT) != 0) {
+                number = (number * 10) + (source[pos] - '0');
+                pos++;
+            }
+            return {NUMBER, number, start, pos};
+        }
+        if ((cls & LETTER) != 0) {
+            while (pos < length && (CLASSES[source[pos]] & (LETTER | DIGIT)) != 0) {
+                pos++;
+            }
+            if (pos < length && source[pos] == ':') {
+                pos++;
+                return {KEYWORD, start, start, pos};
+            }
+            return {IDENTIFIER, start, start, pos};
+        }
+        if ((cls & BINARY) != 0) {
+            pos++;
+            uint64_t op = c;
+            if ((c == '<' || c == '>') && pos < length && source[pos] == '=') {
+                pos++;
+                op |= static_cast<uint64_t>('=') << 8;
+            }
+            return {BINARY_OP, op, start, pos};
+        }
+        return {END, 0, start, start};
+    }
+
+  private:
+    const uint8_t* source;
+    size_t length;
+    size_t pos{0};
+};
@@ -2,23 +2,34 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <climits>
 #include <cstdint>
 #include <cstring>
 #include <fcntl.h>
 #include <iomanip>
 #include <iostream>
+#include <set>
 #include <stdexcept>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <utility>
 #include <vector>
 
+#include "byte_code.hpp"
 #include "compiled_program.hpp"
 #include "eval_context.hpp"
+#include "function_header.hpp"
+#include "intern_table.hpp"
 #include "interrupt.hpp"
+#include "io_poller.hpp"
 #include "memory_layout.hpp"
+#include "native_call.hpp"
 #include "opcodes.hpp"
+#include "send_cache.hpp"
+#include "smalltalk_lexer.hpp"
+#include "string_ops.hpp"
 #include "vm_checks.hpp"
 #include "vm_exception.hpp"
 
@@ -64,6 +75,17 @@ class StackVM {
     bool profiling_enabled{false};
     std::array<uint64_t, 256> opcode_counts{0}; // Count execution of each opcode
     uint64_t total_instructions{0};             // Total instructions executed
+    std::set<uint64_t> send_sites;              // SEND_CACHED sites executed while profiling
+
+    // Selector symbols interned by the INTERN opcode
+    InternTable selectors;
+
+    // Watched file descriptors for the event-loop C_CALLs (see io_poller.hpp)
+    IoPoller io;
+    static constexpr uint64_t IO_POLL_INTERVAL = 1024; // Instructions between polls
+
+    // Words per TOKENIZE record: the four slots of a Token
+    static constexpr uint64_t TOKEN_RECORD_WORDS = 4;
 
     // Runtime code generation support (for EVAL and COMPILE opcodes)
     EvalContext* eval_ctx{nullptr};
@@ -85,6 +107,124 @@ class StackVM {
         return result;
     }
 
+    // Compile code through an EVAL or COMPILE callback, reusing what an
+    // earlier call loaded for the same text (see EvalCache). Code that
+    // defines symbols is not cached: compiling it again is what defines them,
+    // or reports that they already exist.
+    uint64_t compile_cached(EvalCache& cache,
+                            const std::function<uint64_t(StackVM&, const std::string&)>& compile,
+                            const std::string& code) {
+        const SymbolTable* symbols = eval_ctx->symbols;
+        if (symbols == nullptr) {
+            return compile(*this, code);
+        }
+
+        const uint64_t generation = symbols->generation();
+        if (auto address = cache.lookup(code, generation)) {
+            return *address;
+        }
+        const size_t defined = symbols->size();
+        const uint64_t address = compile(*this, code);
+        if (symbols->size() == defined && symbols->generation() == generation) {
+            cache.insert(code, generation, address);
+        }
+        return address;
+    }
+
+    // C_CALL buffers are byte addresses into VM memory. Words are stored
+    // little-endian, so byte n of a packed buffer is byte n of the mapping and
+    // syscalls can read or write it in place after one range check. Buffers
+    // the kernel writes into must not overlap the code segment.
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                  "C_CALL byte buffers assume little-endian words");
+
+    [[nodiscard]] uint8_t* io_buffer(uint64_t byte_addr, uint64_t count, bool writable) const {
+        VMChecks::check_memory_bounds(byte_addr / BYTES_PER_WORD, ip, sp, bp, hp);
+        if (count > 0) {
+            // Clamp so the end address cannot wrap; an oversized count still fails
+            const uint64_t span = std::min<uint64_t>(count, (MEMORY_SIZE * BYTES_PER_WORD) + 1);
+            VMChecks::check_memory_bounds((byte_addr + span - 1) / BYTES_PER_WORD, ip, sp, bp, hp);
+        }
+        if (writable) {
+            VMChecks::check_code_segment_protection(byte_addr / BYTES_PER_WORD, ip, sp, bp, hp);
+        }
+        return reinterpret_cast<uint8_t*>(memory) + byte_addr;
+    }
+
+    // readv/writev vectors: iovcnt [buffer_addr, count] word pairs at iov_addr
+    [[nodiscard]] std::vector<struct iovec> io_vectors(uint64_t iov_addr, uint64_t iovcnt,
+                                                       bool writable) const {
+        if (iovcnt > IOV_MAX) {
+            throw std::runtime_error("C_CALL: at most " + std::to_string(IOV_MAX) +
+                                     " io vectors");
+        }
+        if (iovcnt > 0) {
+            VMChecks::check_memory_bounds(iov_addr + (2 * iovcnt) - 1, ip, sp, bp, hp);
+        }
+        std::vector<struct iovec> iov(iovcnt);
+        for (size_t i = 0; i < iovcnt; i++) {
+            const uint64_t buffer_addr = memory[iov_addr + (2 * i)];
+            const uint64_t count = memory[iov_addr + (2 * i) + 1];
+            iov[i].iov_base = io_buffer(buffer_addr, count, writable);
+            iov[i].iov_len = count;
+        }
+        return iov;
+    }
+
+    // Word range [addr, addr + count) for the bulk memory opcodes. The whole
+    // range is checked once, like io_buffer does for byte ranges.
+    [[nodiscard]] uint64_t* word_range(uint64_t addr, uint64_t count, bool writable) const {
+        if (count == 0) {
+            return memory;
+        }
+        VMChecks::check_memory_bounds(addr, ip, sp, bp, hp);
+        const uint64_t span = std::min<uint64_t>(count, MEMORY_SIZE + 1);
+        VMChecks::check_memory_bounds(addr + span - 1, ip, sp, bp, hp);
+        if (writable) {
+            VMChecks::check_code_segment_protection(addr, ip, sp, bp, hp);
+        }
+        return memory + addr;
+    }
+
+    // memcpy is undefined for overlapping ranges, so MEMCPY refuses them
+    static void check_disjoint(const char* what, uint64_t dst, uint64_t src, uint64_t count) {
+        if (count > 0 && dst < src + count && src < dst + count) {
+            throw std::runtime_error(std::string(what) + ": overlapping ranges (use MEMMOVE)");
+        }
+    }
+
+    // -1, 0 or 1 as a VM word
+    static uint64_t compare_result(int c) {
+        return static_cast<uint64_t>(static_cast<int64_t>((c > 0) - (c < 0)));
+    }
+
+    // Bytes of the packed string at addr ([length][bytes...]), checked once
+    [[nodiscard]] const uint8_t* string_bytes(uint64_t addr, uint64_t& length) const {
+        VMChecks::check_memory_bounds(addr, ip, sp, bp, hp);
+        length = memory[addr];
+        return io_buffer((addr + 1) * BYTES_PER_WORD, length, false);
+    }
+
+    // mmap/munmap replace whole pages of the VM mapping, so unlike io_buffer
+    // the range is always checked: it must be page aligned and lie in the heap.
+    // Callers reserve the range rounded up to whole pages.
+    [[nodiscard]] void* heap_mapping(uint64_t byte_addr, uint64_t length, const char* what) const {
+        const auto page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        const uint64_t heap_bytes = (STACK_START - HEAP_START) * BYTES_PER_WORD;
+        if (byte_addr % page != 0) {
+            throw std::runtime_error(std::string("C_CALL ") + what +
+                                     ": address must be page aligned");
+        }
+        // The kernel maps whole pages, so check the rounded-up span
+        const uint64_t span = length > heap_bytes ? length : (length + page - 1) / page * page;
+        if (byte_addr < HEAP_START * BYTES_PER_WORD || span > heap_bytes ||
+            byte_addr - (HEAP_START * BYTES_PER_WORD) > heap_bytes - span) {
+            throw std::runtime_error(std::string("C_CALL ") + what +
+                                     ": range must lie in the heap");
+        }
+        return reinterpret_cast<uint8_t*>(memory) + byte_addr;
+    }
+
     inline void push(uint64_t value) {
         VMChecks::check_stack_overflow(sp, hp, ip, bp);
         memory[--sp] = value;
@@ -100,6 +240,299 @@ class StackVM {
         return memory[sp];
     }
 
+    // Operands of the tagged SmallInteger opcodes are read in place: they stay
+    // on the stack until the fast path succeeds so the send fallback still sees
+    // [receiver, argument]. Returns true when both carry the SmallInteger tag.
+    [[nodiscard]] inline bool tagged_operands(int64_t& a, int64_t& b) const {
+        VMChecks::check_stack_underflow(sp + 1, ip, bp, hp);
+        b = static_cast<int64_t>(memory[sp]);
+        a = static_cast<int64_t>(memory[sp + 1]);
+        return (a & b & 1) != 0;
+    }
+
+    // Replace both tagged operands with the result
+    inline void tagged_result(int64_t value) {
+        memory[++sp] = static_cast<uint64_t>(value);
+    }
+
+    // The instruction encodings the dispatch loop is instantiated for: one
+    // word per opcode and immediate, or bytes (byte_code.hpp)
+    enum class Encoding : uint8_t { WORDS, BYTES };
+
+    template <Encoding E> static constexpr uint64_t code_end() {
+        return E == Encoding::WORDS ? MEMORY_SIZE : CODE_SIZE * BYTES_PER_WORD;
+    }
+
+    // Where the byte code was loaded and, by offset, where its functions start
+    uint64_t byte_code_start{0};
+    std::vector<bool> byte_code_entries;
+
+    [[nodiscard]] const uint8_t* code_bytes() const {
+        return reinterpret_cast<const uint8_t*>(memory);
+    }
+
+    template <Encoding E> inline void check_ip() const {
+        if constexpr (E == Encoding::WORDS) {
+            VMChecks::check_ip_bounds(ip, sp, bp, hp);
+        } else {
+            VMChecks::check_byte_ip_bounds(ip, sp, bp, hp);
+        }
+    }
+
+    template <Encoding E> inline uint8_t fetch_opcode() {
+        if constexpr (E == Encoding::WORDS) {
+            return static_cast<uint8_t>(memory[ip++]);
+        } else {
+            return code_bytes()[ip++];
+        }
+    }
+
+    template <Encoding E> inline uint64_t fetch_operand() {
+        if constexpr (E == Encoding::WORDS) {
+            return memory[ip++];
+        } else {
+            return ByteCode::read_immediate(code_bytes(), ip);
+        }
+    }
+
+    // Header of the function entered at target. CHECKED verifies it in every
+    // build, for targets that are only known at run time (FUNCALL,
+    // SEND_CACHED); CALL and EVAL targets come from the compiler.
+    template <Encoding E = Encoding::WORDS, bool CHECKED = false>
+    [[nodiscard]] inline uint64_t function_header(uint64_t target) const {
+        uint64_t header = 0;
+        if constexpr (E == Encoding::WORDS) {
+            if constexpr (CHECKED) {
+                if (target < FunctionHeader::SIZE) {
+                    throw VMException::InvalidCall(target, "no function header", ip, sp, bp, hp);
+                }
+            }
+            VMChecks::check_memory_bounds(target - FunctionHeader::SIZE, ip, sp, bp, hp);
+            header = memory[target - FunctionHeader::SIZE];
+        } else {
+            // Always checked: a word address from code compiled at run time
+            // (a cached method, a COMPILE result) is no byte code to run
+            const uint64_t offset = target - byte_code_start;
+            if (target < byte_code_start || offset >= byte_code_entries.size() ||
+                !byte_code_entries[offset]) {
+                throw VMException::InvalidCall(target, "not a function of the loaded byte code",
+                                               ip, sp, bp, hp);
+            }
+            header = ByteCode::read_header(code_bytes(), target);
+        }
+        if constexpr (CHECKED) {
+            VMChecks::require_function_header(target, header, ip, sp, bp, hp);
+        } else {
+            VMChecks::check_function_header(target, header, ip, sp, bp, hp);
+        }
+        return header;
+    }
+
+    // Enter a function whose arguments are already pushed: save the return
+    // address and build the frame its header describes in one step
+    inline void enter_function(uint64_t target, uint64_t header) {
+        const uint64_t temp_size = FunctionHeader::temporaries(header);
+        VMChecks::check_stack_room(sp, temp_size + 2, hp, ip, bp);
+
+        memory[--sp] = ip;
+        sp -= temp_size;
+        std::memset(&memory[sp], 0, temp_size * sizeof(uint64_t));
+        memory[--sp] = FunctionHeader::link(bp, header);
+        bp = sp;
+        ip = target;
+    }
+
+    // Tagged booleans answered by the SmallInteger comparisons
+    static constexpr int64_t TAGGED_TRUE = (1 << 1) | 1;
+    static constexpr int64_t TAGGED_FALSE = (0 << 1) | 1;
+
+    static bool tagged_boolean(bool value, int64_t& result) {
+        result = value ? TAGGED_TRUE : TAGGED_FALSE;
+        return true;
+    }
+
+    // TADD ... TGTE: the operand is the address of the out-of-line send to
+    // take instead. op computes the tagged result of [a, b] and answers
+    // whether it fits; when both operands are SmallIntegers and it does,
+    // [a, b] -> [result], otherwise the stack is unchanged and control
+    // jumps to the fallback.
+    template <Encoding E, typename Op> inline void tagged_op(Op op) {
+        check_ip<E>();
+        const uint64_t fallback = fetch_operand<E>();
+        int64_t a = 0;
+        int64_t b = 0;
+        int64_t result = 0;
+        if (tagged_operands(a, b) && op(a, b, result)) {
+            tagged_result(result);
+        } else {
+            ip = fallback;
+            check_ip<E>();
+        }
+    }
+
+    // ===== Native functions (C_CALL) =====
+    // buffer_addr arguments are byte addresses into VM memory (word address * 8);
+    // iov_addr is a word address of iovcnt [buffer_addr, count] pairs.
+
+    static constexpr size_t MAX_NATIVES = 256;
+    std::array<NativeEntry, MAX_NATIVES> natives{};
+
+    // read(fd, buffer_addr, count) -> bytes_read
+    static uint64_t native_read(StackVM& vm, NativeArgs args) {
+        uint8_t* buffer = vm.io_buffer(args[1], args[2], true);
+        return static_cast<uint64_t>(read(static_cast<int>(args[0]), buffer, args[2]));
+    }
+
+    // write(fd, buffer_addr, count) -> bytes_written
+    static uint64_t native_write(StackVM& vm, NativeArgs args) {
+        const uint8_t* buffer = vm.io_buffer(args[1], args[2], false);
+        return static_cast<uint64_t>(write(static_cast<int>(args[0]), buffer, args[2]));
+    }
+
+    // open(path_addr, flags) -> fd
+    static uint64_t native_open(StackVM& vm, NativeArgs args) {
+        const std::string path = vm.read_packed_string(args[0]);
+        return static_cast<uint64_t>(open(path.c_str(), static_cast<int>(args[1])));
+    }
+
+    // close(fd) -> result
+    static uint64_t native_close(StackVM& vm, NativeArgs args) {
+        const int fd = static_cast<int>(args[0]);
+        vm.io.forget(fd);
+        return static_cast<uint64_t>(close(fd));
+    }
+
+    // lseek(fd, offset, whence) -> position
+    static uint64_t native_lseek(StackVM& /*vm*/, NativeArgs args) {
+        return static_cast<uint64_t>(lseek(static_cast<int>(args[0]),
+                                           static_cast<off_t>(args[1]),
+                                           static_cast<int>(args[2])));
+    }
+
+    // fsize(fd) -> file_size
+    static uint64_t native_fsize(StackVM& /*vm*/, NativeArgs args) {
+        struct stat st;
+        if (fstat(static_cast<int>(args[0]), &st) != 0) {
+            return static_cast<uint64_t>(-1);
+        }
+        return static_cast<uint64_t>(st.st_size);
+    }
+
+    // readv(fd, iov_addr, iovcnt) -> bytes_read
+    static uint64_t native_readv(StackVM& vm, NativeArgs args) {
+        const std::vector<struct iovec> iov = vm.io_vectors(args[1], args[2], true);
+        return static_cast<uint64_t>(
+            readv(static_cast<int>(args[0]), iov.data(), static_cast<int>(iov.size())));
+    }
+
+    // writev(fd, iov_addr, iovcnt) -> bytes_written
+    static uint64_t native_writev(StackVM& vm, NativeArgs args) {
+        const std::vector<struct iovec> iov = vm.io_vectors(args[1], args[2], false);
+        return static_cast<uint64_t>(
+            writev(static_cast<int>(args[0]), iov.data(), static_cast<int>(iov.size())));
+    }
+
+    // pread(fd, buffer_addr, count, offset) -> bytes_read
+    static uint64_t native_pread(StackVM& vm, NativeArgs args) {
+        uint8_t* buffer = vm.io_buffer(args[1], args[2], true);
+        return static_cast<uint64_t>(
+            pread(static_cast<int>(args[0]), buffer, args[2], static_cast<off_t>(args[3])));
+    }
+
+    // pwrite(fd, buffer_addr, count, offset) -> bytes_written
+    static uint64_t native_pwrite(StackVM& vm, NativeArgs args) {
+        const uint8_t* buffer = vm.io_buffer(args[1], args[2], false);
+        return static_cast<uint64_t>(
+            pwrite(static_cast<int>(args[0]), buffer, args[2], static_cast<off_t>(args[3])));
+    }
+
+    // mmap(fd, buffer_addr, max_length) -> mapped length
+    static uint64_t native_mmap(StackVM& vm, NativeArgs args) {
+        const int fd = static_cast<int>(args[0]);
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            return static_cast<uint64_t>(-1);
+        }
+        const uint64_t length = std::min(static_cast<uint64_t>(st.st_size), args[2]);
+        if (length == 0) {
+            return 0;
+        }
+        void* target = vm.heap_mapping(args[1], length, "mmap");
+        void* mapped = mmap(target, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            return static_cast<uint64_t>(-1);
+        }
+        // Past EOF the last page already reads as zero; do the same when
+        // max_length cut the file short
+        const auto page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        if (length < static_cast<uint64_t>(st.st_size) && length % page != 0) {
+            memset(static_cast<uint8_t*>(mapped) + length, 0, page - (length % page));
+        }
+        return length;
+    }
+
+    // munmap(buffer_addr, length) -> result
+    static uint64_t native_munmap(StackVM& vm, NativeArgs args) {
+        if (args[1] == 0) {
+            return 0;
+        }
+        // Put fresh zero pages back so the range is ordinary heap again
+        void* target = vm.heap_mapping(args[0], args[1], "munmap");
+        void* mapped = mmap(target, args[1], PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+        return static_cast<uint64_t>(mapped == MAP_FAILED ? -1 : 0);
+    }
+
+    // io-watch(fd, events) -> result (events: 1 readable, 2 writable, 0 off)
+    static uint64_t native_io_watch(StackVM& vm, NativeArgs args) {
+        return static_cast<uint64_t>(vm.io.watch(static_cast<int>(args[0]), args[1]));
+    }
+
+    // io-wait(timeout_ms) -> ready count
+    static uint64_t native_io_wait(StackVM& vm, NativeArgs args) {
+        return vm.io.poll(static_cast<int>(args[0]));
+    }
+
+    // io-next(record_addr) -> 1 with [fd, events] written, or 0
+    static uint64_t native_io_next(StackVM& vm, NativeArgs args) {
+        const uint64_t record = args[0];
+        VMChecks::check_memory_bounds(record + 1, vm.ip, vm.sp, vm.bp, vm.hp);
+        VMChecks::check_code_segment_protection(record, vm.ip, vm.sp, vm.bp, vm.hp);
+        int fd = -1;
+        uint64_t events = 0;
+        if (!vm.io.next(fd, events)) {
+            return 0;
+        }
+        vm.memory[record] = static_cast<uint64_t>(fd);
+        vm.memory[record + 1] = events;
+        return 1;
+    }
+
+    // frame-pointer() -> bp of the function making the call, whose link word
+    // leads to its callers' frames (function_header.hpp)
+    static uint64_t native_frame_pointer(StackVM& vm, NativeArgs /*args*/) {
+        return vm.bp;
+    }
+
+    void register_builtin_natives() {
+        register_native(0, native_read, 3, "read");
+        register_native(1, native_write, 3, "write");
+        register_native(2, native_open, 2, "open");
+        register_native(3, native_close, 1, "close");
+        register_native(4, native_lseek, 3, "lseek");
+        register_native(5, native_fsize, 1, "fsize");
+        register_native(6, native_readv, 3, "readv");
+        register_native(7, native_writev, 3, "writev");
+        register_native(8, native_pread, 4, "pread");
+        register_native(9, native_pwrite, 4, "pwrite");
+        register_native(10, native_mmap, 3, "mmap");
+        register_native(11, native_munmap, 2, "munmap");
+        register_native(12, native_io_watch, 2, "io-watch");
+        register_native(13, native_io_wait, 1, "io-wait");
+        register_native(14, native_io_next, 1, "io-next");
+        register_native(15, native_frame_pointer, 0, "frame-pointer");
+    }
+
   public:
     StackVM() : sp(STACK_BASE), bp(STACK_BASE), hp(HEAP_START) {
         // Allocate memory using mmap
@@ -111,6 +544,7 @@ class StackVM {
         }
 
         memory = static_cast<uint64_t*>(ptr);
+        register_builtin_natives();
         reset();
     }
 
@@ -164,6 +598,24 @@ class StackVM {
         program.write_strings(*this);
     }
 
+    // Load byte code (byte_code.hpp) at a byte address in the code segment.
+    // Calls from byte code may only enter functions of the last one loaded.
+    void load_byte_program(const std::vector<uint8_t>& code, uint64_t byte_offset = 0) {
+        const uint64_t end = byte_offset + code.size();
+        if (end > CODE_SIZE * BYTES_PER_WORD) {
+            throw VMException::ProgramTooLarge(MemoryLayout::bytes_to_words(end), CODE_SIZE);
+        }
+        memcpy(reinterpret_cast<uint8_t*>(memory) + byte_offset, code.data(), code.size());
+        byte_code_start = byte_offset;
+        byte_code_entries = ByteCode::entry_points(code);
+    }
+
+    // Load compiled program converted to byte code, at byte address 0
+    void load_byte_program(const CompiledProgram& program) {
+        load_byte_program(ByteCode::encode(program.bytecode, program.code_refs));
+        program.write_strings(*this);
+    }
+
     void reset() {
         ip = 0;
         sp = STACK_BASE;
@@ -178,12 +630,38 @@ class StackVM {
         ip = new_ip;
     }
 
+    // Install fn as C_CALL function id, replacing any previous entry. Calls
+    // must pass exactly arity arguments.
+    void register_native(uint64_t id, NativeFn fn, size_t arity, const char* name = "native") {
+        if (id >= MAX_NATIVES) {
+            throw std::runtime_error("register_native: id " + std::to_string(id) +
+                                     " out of range (max " + std::to_string(MAX_NATIVES - 1) +
+                                     ")");
+        }
+        if (fn == nullptr) {
+            throw std::runtime_error("register_native: null function for id " +
+                                     std::to_string(id));
+        }
+        natives[id] = NativeEntry{fn, arity, name};
+    }
+
     // Execute the loaded program
     // max_instructions: Maximum number of instructions to execute (default: unlimited)
     //                   Provides protection against infinite loops
     void execute(uint64_t max_instructions = UINT64_MAX) {
+        run<Encoding::WORDS>(max_instructions);
+    }
+
+    // Execute byte code (byte_code.hpp) loaded by load_byte_program; ip and
+    // every code address are byte addresses
+    void execute_byte_code(uint64_t max_instructions = UINT64_MAX) {
+        run<Encoding::BYTES>(max_instructions);
+    }
+
+  private:
+    template <Encoding E> void run(uint64_t max_instructions) {
         uint64_t instruction_count = 0;
-        while (running && ip < MEMORY_SIZE && instruction_count < max_instructions) {
+        while (running && ip < code_end<E>() && instruction_count < max_instructions) {
             instruction_count++;
             if (interrupt_flag && interruptHandling.has_event()) {
                 for (int sig = MIN_SIGNAL; sig <= MAX_SIGNAL; sig++) {
@@ -197,9 +675,12 @@ class StackVM {
                     }
                 }
             }
+            // Readiness found here is raised as SIGIO and taken above
+            if (instruction_count % IO_POLL_INTERVAL == 0) {
+                io.poll(0);
+            }
 
-            const uint64_t instruction = memory[ip++];
-            const auto op = static_cast<Opcode>(instruction & 0xFF);
+            const auto op = static_cast<Opcode>(fetch_opcode<E>());
 
             if (trace_mode) {
                 std::cerr << "IP=" << (ip - 1) << " OP=" << opcode_name(op) << " SP=" << sp
@@ -208,19 +689,29 @@ class StackVM {
 
             // Computed goto dispatch table for faster branch prediction
             static const void* dispatch_table[] = {
-                &&op_halt,       &&op_push,      &&op_pop,     &&op_dup,     &&op_swap,
-                &&op_add,        &&op_sub,       &&op_mul,     &&op_div,     &&op_mod,
-                &&op_eq,         &&op_lt,        &&op_gt,      &&op_lte,     &&op_gte,
-                &&op_jmp,        &&op_jz,        &&op_enter,   &&op_leave,   &&op_call,
-                &&op_ret,        &&op_iret,      &&op_load,    &&op_store,   &&op_load_byte,
-                &&op_store_byte, &&op_load32,    &&op_store32, &&op_bp_load, &&op_bp_store,
-                &&op_print,      &&op_print_str, &&op_and,     &&op_or,      &&op_xor,
-                &&op_shl,        &&op_shr,       &&op_ashr,    &&op_cli,     &&op_sti,
-                &&op_signal_reg, &&op_abort,     &&op_funcall, &&op_eval,    &&op_compile,
-                &&op_c_call};
+                &&op_halt,        &&op_push,         &&op_pop,         &&op_dup,
+                &&op_swap,        &&op_add,          &&op_sub,         &&op_mul,
+                &&op_div,         &&op_mod,          &&op_eq,          &&op_lt,
+                &&op_gt,          &&op_lte,          &&op_gte,         &&op_jmp,
+                &&op_jz,          &&op_enter,        &&op_leave,       &&op_call,
+                &&op_ret,         &&op_iret,         &&op_load,        &&op_store,
+                &&op_load_byte,   &&op_store_byte,   &&op_load32,      &&op_store32,
+                &&op_bp_load,     &&op_bp_store,     &&op_print,       &&op_print_str,
+                &&op_and,         &&op_or,           &&op_xor,         &&op_shl,
+                &&op_shr,         &&op_ashr,         &&op_cli,         &&op_sti,
+                &&op_signal_reg,  &&op_abort,        &&op_funcall,     &&op_eval,
+                &&op_compile,     &&op_c_call,       &&op_send_cached, &&op_tadd,
+                &&op_tsub,        &&op_tmul,         &&op_teq,         &&op_tlt,
+                &&op_tgt,         &&op_tlte,         &&op_tgte,        &&op_intern,
+                &&op_memcpy,      &&op_memmove,      &&op_memset,      &&op_memcmp,
+                &&op_memcpy_byte, &&op_memmove_byte, &&op_memset_byte, &&op_memcmp_byte,
+                &&op_str_eq,      &&op_str_hash,     &&op_str_index,   &&op_str_scan,
+                &&op_tokenize,    &&op_function};
+            static constexpr size_t OPCODE_COUNT =
+                sizeof(dispatch_table) / sizeof(dispatch_table[0]);
 
             const uint8_t opcode_idx = static_cast<uint8_t>(op);
-            if (opcode_idx >= 46) {
+            if (opcode_idx >= OPCODE_COUNT) {
                 throw VMException::UnknownOpcode(opcode_idx, ip - 1, sp, bp, hp);
             }
 
@@ -237,8 +728,8 @@ class StackVM {
             continue;
 
         op_push:
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
-            push(memory[ip++]);
+            check_ip<E>();
+            push(fetch_operand<E>());
             continue;
 
         op_pop:
@@ -332,90 +823,85 @@ class StackVM {
         }
 
         op_jmp:
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
-            ip = memory[ip];
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
+            check_ip<E>();
+            ip = fetch_operand<E>();
+            check_ip<E>();
             continue;
 
         op_jz: {
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
+            check_ip<E>();
             uint64_t cond = pop();
-            uint64_t addr = memory[ip++];
+            uint64_t addr = fetch_operand<E>();
             if (cond == 0) {
                 ip = addr;
-                VMChecks::check_ip_bounds(ip, sp, bp, hp);
+                check_ip<E>();
             }
             continue;
         }
 
+        // A frame, from high addresses to low:
+        //   [arg0 .. argN-1] [return address] [temporaries] [link] <- bp
+        // The caller's arguments are addressed where it pushed them, so
+        // BP_LOAD i reads temporary i for i < t, the return address at t and
+        // the arguments above it, the last one nearest. The calls build the
+        // frame from the callee's header and the link word keeps the saved bp
+        // with the header's counts for RET (function_header.hpp). ENTER and
+        // LEAVE nest a frame with a plain saved bp inside one.
         op_enter: {
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
-            const size_t temp_size = memory[ip++];
+            check_ip<E>();
+            const uint64_t temp_size = fetch_operand<E>();
+            VMChecks::check_stack_room(sp, temp_size + 1, hp, ip, bp);
 
-            for (uint64_t i = 0; i < temp_size; i++) {
-                push(0);
-            }
-            push(bp);
+            sp -= temp_size;
+            std::memset(&memory[sp], 0, temp_size * sizeof(uint64_t));
+            memory[--sp] = bp;
             bp = sp;
 
             continue;
         }
 
         op_leave: {
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
-            const size_t temp_size = memory[ip++];
-            const uint64_t result = pop();
-
-            bp = pop();
+            check_ip<E>();
+            const uint64_t temp_size = fetch_operand<E>();
+            VMChecks::check_stack_empty(sp, ip, bp, hp);
+            VMChecks::check_stack_underflow(bp + temp_size, ip, bp, hp);
 
-            for (uint64_t i = 0; i < temp_size; i++) {
-                pop();
-            }
+            // The result takes the frame's highest word, under the return address
+            const uint64_t result = memory[sp];
+            sp = bp + temp_size;
+            bp = memory[bp];
+            memory[sp] = result;
 
-            push(result);
             continue;
         }
 
         op_call: {
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
-            const uint64_t target = memory[ip++]; // Read target and advance IP
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
-            const uint64_t nb_args = memory[ip++]; // Arguments
-
-            const uint64_t base = sp;
+            check_ip<E>();
+            const uint64_t target = fetch_operand<E>(); // Read target and advance IP
 
-            push(ip);    // Save return address (now past the operand)
-            ip = target; // Jump to function
+            // The compiler checked the argument count against the callee
+            enter_function(target, function_header<E>(target));
 
-            for (uint64_t i = nb_args; i > 0; i--) {
-                push(memory[base + nb_args - i]);
-            }
-
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
+            check_ip<E>();
             continue;
         }
 
         op_ret: {
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
-            const size_t nb_args = memory[ip++];
-
-            const uint64_t result = pop();
-
-            for (uint64_t i = 0; i < nb_args; i++) {
-                pop();
-            }
-
-            const uint64_t ret_addr = pop(); // Pop return address
-
-            for (uint64_t i = 0; i < nb_args; i++) {
-                pop();
-            }
-
-            push(result);
-
-            ip = ret_addr; // Return to caller
-
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
+            VMChecks::check_stack_empty(sp, ip, bp, hp);
+            VMChecks::check_stack_underflow(bp, ip, bp, hp);
+            const uint64_t link = memory[bp];
+            const uint64_t ret_slot = bp + FunctionHeader::temporaries(link) + 1;
+            const uint64_t nb_args = FunctionHeader::arity(link);
+            VMChecks::check_stack_underflow(ret_slot + nb_args, ip, bp, hp);
+
+            // Drop the frame and arguments under the result at once
+            const uint64_t result = memory[sp];
+            ip = memory[ret_slot]; // Return to caller
+            sp = ret_slot + nb_args;
+            bp = FunctionHeader::link_bp(link);
+            memory[sp] = result;
+
+            check_ip<E>();
 
             continue;
         }
@@ -423,7 +909,7 @@ class StackVM {
         op_iret: {
             ip = pop();
 
-            VMChecks::check_ip_bounds(ip, sp, bp, hp);
+            check_ip<E>();
 
             interrupt_flag = true;
 
@@ -537,7 +1023,6 @@ class StackVM {
             const uint64_t value = pop();
             const uint64_t adr = bp + idx + 1; // with SP ++ IP on the stack
             VMChecks::check_memory_bounds(adr, ip, sp, bp, hp);
-            VMChecks::check_bp_store_index(idx, ip, sp, bp, hp);
             VMChecks::check_stack_frame_bounds(adr, sp, ip, bp, hp);
             VMChecks::check_code_segment_protection(adr, ip, sp, bp, hp);
             memory[adr] = value;
@@ -614,12 +1099,15 @@ class StackVM {
                 throw VMException::InvalidSignal(signal, MIN_SIGNAL, MAX_SIGNAL, ip - 1, sp, bp,
                                                  hp);
 
-            if (code_ptr >= MEMORY_SIZE) {
+            if (code_ptr >= code_end<E>()) {
                 throw VMException::InvalidAddress("Interrupt handler", code_ptr, ip - 1, sp, bp,
                                                   hp);
             }
 
             signal_handlers[signal - MIN_SIGNAL] = code_ptr;
+            if (signal == SIGIO) {
+                io.set_signaling(true);
+            }
 
             continue;
         }
@@ -644,18 +1132,12 @@ class StackVM {
             const uint64_t target = pop();
             const uint64_t nb_args = pop();
 
-            if (target >= MEMORY_SIZE)
+            if (target >= code_end<E>())
                 throw VMException::InvalidAddress("FUNCALL target", target, ip - 1, sp, bp, hp);
 
-            const uint64_t base = sp;
-
-            push(ip);    // Save return address
-            ip = target; // Jump to function
-
-            // Push arguments to new frame
-            for (uint64_t i = nb_args; i > 0; i--) {
-                push(memory[base + nb_args - i]);
-            }
+            const uint64_t header = function_header<E, true>(target);
+            VMChecks::check_call_arity(target, header, nb_args, ip, sp, bp, hp);
+            enter_function(target, header);
 
             continue;
         }
@@ -666,24 +1148,20 @@ class StackVM {
             if (!eval_ctx || !eval_ctx->compile_for_eval) {
                 throw std::runtime_error("EVAL: no eval context configured");
             }
+            if constexpr (E == Encoding::BYTES) {
+                throw std::runtime_error("EVAL: compiles word code, which byte code can't call");
+            }
 
             uint64_t str_addr = pop();
             std::string code = read_packed_string(str_addr);
 
             // Compile the code (ends with HALT)
-            uint64_t code_addr = eval_ctx->compile_for_eval(*this, code);
-
-            // Save current IP as return address
-            push(ip);
-
-            // Jump to compiled code
-            // Note: The compiled code ends with HALT, which will stop execution.
-            // The caller should handle this by saving/restoring state or use
-            // a recursive execute call.
+            uint64_t code_addr =
+                compile_cached(eval_ctx->eval_cache, eval_ctx->compile_for_eval, code);
 
-            // We use a different approach: compile code ending with RET 0 for eval
-            // and then call it like a function with no arguments
-            ip = code_addr;
+            // The code is compiled as a function of no arguments ending with
+            // RET, so it is called like one and returns here
+            enter_function(code_addr, function_header<E>(code_addr));
 
             continue;
         }
@@ -694,12 +1172,16 @@ class StackVM {
             if (!eval_ctx || !eval_ctx->compile_for_funcall) {
                 throw std::runtime_error("COMPILE: no eval context configured");
             }
+            if constexpr (E == Encoding::BYTES) {
+                throw std::runtime_error("COMPILE: compiles word code, which byte code can't call");
+            }
 
             uint64_t str_addr = pop();
             std::string code = read_packed_string(str_addr);
 
             // Compile the code (ends with RET for funcall)
-            uint64_t code_addr = eval_ctx->compile_for_funcall(*this, code);
+            uint64_t code_addr =
+                compile_cached(eval_ctx->compile_cache, eval_ctx->compile_for_funcall, code);
 
             // Push the code address - caller can use funcall to invoke it
             push(code_addr);
@@ -708,135 +1190,393 @@ class StackVM {
         }
 
         op_c_call: {
-            // C_CALL: Call C/system function by ID
+            // C_CALL: Call a native function by ID
             // Stack: [arg1, arg2, ..., argN, arg_count, func_id] -> [result]
             //
-            // Function IDs:
-            //   0 = read(fd, buffer_addr, count) -> bytes_read
-            //   1 = write(fd, buffer_addr, count) -> bytes_written
-            //   2 = open(path_addr, flags) -> fd
-            //   3 = close(fd) -> result
-            //   4 = lseek(fd, offset, whence) -> position
-            //   5 = fsize(fd) -> file_size
-            //
-            uint64_t func_id = pop();
-            uint64_t arg_count = pop();
+            // The native reads its arguments in place from the stack and they
+            // are dropped afterwards. Built-in IDs are listed with
+            // register_builtin_natives(); programs add more with register_native().
+            const uint64_t func_id = pop();
+            const uint64_t arg_count = pop();
+
+            if (func_id >= MAX_NATIVES || natives[func_id].fn == nullptr) {
+                throw std::runtime_error("C_CALL: unknown function ID " +
+                                         std::to_string(func_id));
+            }
+            const NativeEntry& native = natives[func_id];
+            // Registration fixes the arity, but this call's count and id are
+            // stack values (c-call takes a computed id), so only here can they
+            // be matched; a mismatch would have the native read, and the VM
+            // drop, the wrong stack words.
+            if (arg_count != native.arity) {
+                throw std::runtime_error("C_CALL " + std::string(native.name) + ": expected " +
+                                         std::to_string(native.arity) + " arguments");
+            }
+            if (arg_count > 0) {
+                VMChecks::check_stack_underflow(sp + arg_count - 1, ip, bp, hp);
+            }
+
+            const uint64_t result = native.fn(*this, NativeArgs(memory + sp, arg_count));
+            sp += arg_count;
+            push(result);
+            continue;
+        }
 
-            // Pop arguments into array (reverse order on stack)
-            std::vector<uint64_t> args(arg_count);
-            for (size_t i = 0; i < arg_count; i++) {
-                args[arg_count - 1 - i] = pop();
+        op_send_cached: {
+            // SEND_CACHED: Message send through the site's polymorphic inline cache
+            // Operand: send site address (layout in send_cache.hpp)
+            // Stack: [receiver, arg1, ..., argN] -> [result]
+            //
+            // A hit calls the cached target with (receiver, args...). A miss, or
+            // any send at a megamorphic site, calls the site's handler with
+            // (receiver, args..., site) so it can do a full lookup and refill.
+            const uint64_t send_ip = ip - 1; // The opcode is one word or one byte
+            check_ip<E>();
+            const uint64_t site = fetch_operand<E>();
+            VMChecks::check_memory_bounds(site + SendSite::SIZE - 1, ip, sp, bp, hp);
+            VMChecks::check_code_segment_protection(site, ip, sp, bp, hp);
+
+            const uint64_t nb_args = memory[site + SendSite::NARGS];
+            const uint64_t receiver = memory[sp + nb_args];
+
+            uint64_t class_key = SendSite::NIL_KEY;
+            if (receiver & 1) {
+                class_key = SendSite::SMALL_INTEGER_KEY;
+            } else if (receiver != 0) {
+                VMChecks::check_memory_bounds(receiver, ip, sp, bp, hp);
+                class_key = memory[receiver];
             }
 
-            uint64_t result = 0;
+            const uint64_t state = memory[site + SendSite::STATE];
+            const uint64_t entries = state <= SendSite::MAX_ENTRIES ? state : 0;
 
-            switch (func_id) {
-                case 0: { // read(fd, buffer_addr, count)
-                    if (arg_count != 3) {
-                        throw std::runtime_error("C_CALL read: expected 3 arguments");
-                    }
-                    int fd = static_cast<int>(args[0]);
-                    uint64_t buffer_addr = args[1];
-                    size_t count = args[2];
-
-                    auto* temp_buffer = new uint8_t[count];
-                    ssize_t bytes_read = read(fd, temp_buffer, count);
-
-                    if (bytes_read > 0) {
-                        for (ssize_t i = 0; i < bytes_read; i++) {
-                            uint64_t byte_addr = buffer_addr + i;
-                            uint64_t word_idx = byte_addr / 8;
-                            uint64_t byte_offset = byte_addr % 8;
-
-                            VMChecks::check_memory_bounds(word_idx, ip, sp, bp, hp);
-                            VMChecks::check_code_segment_protection(word_idx, ip, sp, bp, hp);
-
-                            uint64_t mask = ~(0xFFULL << (byte_offset * 8));
-                            memory[word_idx] =
-                                (memory[word_idx] & mask) |
-                                (static_cast<uint64_t>(temp_buffer[i]) << (byte_offset * 8));
-                        }
-                    }
-                    delete[] temp_buffer;
-                    result = static_cast<uint64_t>(bytes_read);
+            bool hit = false;
+            uint64_t target = 0;
+            for (uint64_t i = 0; i < entries; i++) {
+                if (memory[site + SendSite::entry_class(i)] == class_key) {
+                    target = memory[site + SendSite::entry_target(i)];
+                    hit = true;
                     break;
                 }
+            }
 
-                case 1: { // write(fd, buffer_addr, count)
-                    if (arg_count != 3) {
-                        throw std::runtime_error("C_CALL write: expected 3 arguments");
-                    }
-                    int fd = static_cast<int>(args[0]);
-                    uint64_t buffer_addr = args[1];
-                    size_t count = args[2];
-
-                    auto* temp_buffer = new uint8_t[count];
-                    for (size_t i = 0; i < count; i++) {
-                        uint64_t byte_addr = buffer_addr + i;
-                        uint64_t word_idx = byte_addr / 8;
-                        uint64_t byte_offset = byte_addr % 8;
-
-                        VMChecks::check_memory_bounds(word_idx, ip, sp, bp, hp);
-                        temp_buffer[i] = (memory[word_idx] >> (byte_offset * 8)) & 0xFF;
-                    }
+            uint64_t call_args = nb_args + 1;
+            if (hit) {
+                memory[site + SendSite::HITS]++;
+            } else {
+                memory[site + SendSite::MISSES]++;
+                target = memory[site + SendSite::HANDLER];
+                push(site);
+                call_args++;
+            }
 
-                    ssize_t bytes_written = write(fd, temp_buffer, count);
-                    delete[] temp_buffer;
-                    result = static_cast<uint64_t>(bytes_written);
-                    break;
-                }
+            if (target >= code_end<E>())
+                throw VMException::InvalidAddress("SEND_CACHED target", target, send_ip, sp, bp,
+                                                  hp);
 
-                case 2: { // open(path_addr, flags) -> fd
-                    if (arg_count != 2) {
-                        throw std::runtime_error("C_CALL open: expected 2 arguments");
-                    }
-                    std::string path = read_packed_string(args[0]);
-                    int flags = static_cast<int>(args[1]);
-                    result = static_cast<uint64_t>(open(path.c_str(), flags));
-                    break;
-                }
+            if (profiling_enabled) {
+                send_sites.insert(site);
+            }
 
-                case 3: { // close(fd)
-                    if (arg_count != 1) {
-                        throw std::runtime_error("C_CALL close: expected 1 argument");
-                    }
-                    result = static_cast<uint64_t>(close(static_cast<int>(args[0])));
-                    break;
-                }
+            // Method or miss handler
+            const uint64_t header = function_header<E, true>(target);
+            VMChecks::check_call_arity(target, header, call_args, ip, sp, bp, hp);
+            enter_function(target, header);
 
-                case 4: { // lseek(fd, offset, whence)
-                    if (arg_count != 3) {
-                        throw std::runtime_error("C_CALL lseek: expected 3 arguments");
-                    }
-                    int fd = static_cast<int>(args[0]);
-                    off_t offset = static_cast<off_t>(args[1]);
-                    int whence = static_cast<int>(args[2]);
-                    result = static_cast<uint64_t>(lseek(fd, offset, whence));
-                    break;
-                }
+            continue;
+        }
 
-                case 5: { // fsize(fd) -> file size
-                    if (arg_count != 1) {
-                        throw std::runtime_error("C_CALL fsize: expected 1 argument");
-                    }
-                    int fd = static_cast<int>(args[0]);
-                    struct stat st;
-                    if (fstat(fd, &st) == 0) {
-                        result = static_cast<uint64_t>(st.st_size);
-                    } else {
-                        result = static_cast<uint64_t>(-1);
-                    }
-                    break;
+        // Tagged SmallInteger arithmetic and comparisons, see tagged_op
+        op_tadd:
+            // (2x+1) + 2y = 2(x+y)+1
+            tagged_op<E>([](int64_t a, int64_t b, int64_t& result) {
+                return !__builtin_add_overflow(a, b - 1, &result);
+            });
+            continue;
+
+        op_tsub:
+            // (2x+1) - 2y = 2(x-y)+1
+            tagged_op<E>([](int64_t a, int64_t b, int64_t& result) {
+                return !__builtin_sub_overflow(a, b - 1, &result);
+            });
+            continue;
+
+        op_tmul:
+            // 2x * y + 1 = 2xy+1; 2xy is even, so adding the tag cannot overflow
+            tagged_op<E>([](int64_t a, int64_t b, int64_t& result) {
+                if (__builtin_mul_overflow(a - 1, b >> 1, &result)) {
+                    return false;
                 }
+                result += 1;
+                return true;
+            });
+            continue;
 
-                default:
-                    throw std::runtime_error("C_CALL: unknown function ID " +
-                                             std::to_string(func_id));
+        op_teq:
+            tagged_op<E>([](int64_t a, int64_t b, int64_t& result) {
+                return tagged_boolean(a == b, result);
+            });
+            continue;
+
+        op_tlt:
+            tagged_op<E>([](int64_t a, int64_t b, int64_t& result) {
+                return tagged_boolean(a < b, result);
+            });
+            continue;
+
+        op_tgt:
+            tagged_op<E>([](int64_t a, int64_t b, int64_t& result) {
+                return tagged_boolean(a > b, result);
+            });
+            continue;
+
+        op_tlte:
+            tagged_op<E>([](int64_t a, int64_t b, int64_t& result) {
+                return tagged_boolean(a <= b, result);
+            });
+            continue;
+
+        op_tgte:
+            tagged_op<E>([](int64_t a, int64_t b, int64_t& result) {
+                return tagged_boolean(a >= b, result);
+            });
+            continue;
+
+        op_intern: {
+            // INTERN: Intern a slice of a packed string as a selector symbol
+            // Stack: [str_addr, start, length, id] -> [tagged symbol id]
+            //
+            // The slice is hashed in place, so callers can intern an
+            // identifier straight out of source text. id is 0 to answer the
+            // existing id or allocate the next one, or a fixed id to preload
+            // bootstrap selectors. A str_addr of 0 clears the table.
+            const uint64_t id = pop();
+            const uint64_t length = pop();
+            const uint64_t start = pop();
+            const uint64_t str_addr = pop();
+
+            if (str_addr == 0) {
+                selectors.clear();
+                push(0);
+                continue;
             }
 
-            push(result);
+            uint64_t str_length = 0;
+            const uint8_t* bytes = string_bytes(str_addr, str_length);
+            if (start > str_length || length > str_length - start) {
+                throw std::runtime_error("INTERN: " + std::to_string(length) + " bytes at " +
+                                         std::to_string(start) + " outside a string of " +
+                                         std::to_string(str_length));
+            }
+            const std::string_view name(reinterpret_cast<const char*>(bytes) + start, length);
+
+            const uint64_t symbol =
+                id == 0 ? selectors.intern(name) : selectors.intern_as(name, id);
+            if (symbol == InternTable::NO_ID) {
+                throw VMException::InvalidSymbol(std::string(name), id, ip - 1, sp, bp, hp);
+            }
+            push((symbol << 1) | 1);
+            continue;
+        }
+
+        // Bulk memory: each operation checks its ranges once and then runs
+        // libc's vectorized memcpy/memmove/memset/memcmp over the whole span.
+        // The word forms take word addresses and counts, the _BYTE forms byte
+        // addresses (word address * 8) and byte counts. All but MEMCMP answer
+        // the destination.
+
+        op_memcpy: {
+            // MEMCPY: Stack: [dst, src, count] -> [dst]
+            const uint64_t count = pop();
+            const uint64_t src = pop();
+            const uint64_t dst = pop();
+            check_disjoint("MEMCPY", dst, src, count);
+            uint64_t* to = word_range(dst, count, true);
+            const uint64_t* from = word_range(src, count, false);
+            memcpy(to, from, count * sizeof(uint64_t));
+            push(dst);
+            continue;
+        }
+
+        op_memmove: {
+            // MEMMOVE: Stack: [dst, src, count] -> [dst]
+            const uint64_t count = pop();
+            const uint64_t src = pop();
+            const uint64_t dst = pop();
+            uint64_t* to = word_range(dst, count, true);
+            const uint64_t* from = word_range(src, count, false);
+            memmove(to, from, count * sizeof(uint64_t));
+            push(dst);
             continue;
         }
+
+        op_memset: {
+            // MEMSET: Stack: [dst, value, count] -> [dst]
+            const uint64_t count = pop();
+            const uint64_t value = pop();
+            const uint64_t dst = pop();
+            uint64_t* to = word_range(dst, count, true);
+            if (value == 0) {
+                memset(to, 0, count * sizeof(uint64_t));
+            } else {
+                std::fill_n(to, count, value);
+            }
+            push(dst);
+            continue;
+        }
+
+        op_memcmp: {
+            // MEMCMP: Stack: [a, b, count] -> [-1/0/1], words compared as unsigned
+            const uint64_t count = pop();
+            const uint64_t b = pop();
+            const uint64_t a = pop();
+            const uint64_t* left = word_range(a, count, false);
+            const uint64_t* right = word_range(b, count, false);
+            int c = 0;
+            // Equal spans are the common case; only look for the first
+            // differing word when there is one
+            if (count > 0 && memcmp(left, right, count * sizeof(uint64_t)) != 0) {
+                const auto diff = std::mismatch(left, left + count, right);
+                c = *diff.first < *diff.second ? -1 : 1;
+            }
+            push(compare_result(c));
+            continue;
+        }
+
+        op_memcpy_byte: {
+            // MEMCPY_BYTE: Stack: [dst, src, count] -> [dst]
+            const uint64_t count = pop();
+            const uint64_t src = pop();
+            const uint64_t dst = pop();
+            check_disjoint("MEMCPY_BYTE", dst, src, count);
+            uint8_t* to = io_buffer(dst, count, true);
+            const uint8_t* from = io_buffer(src, count, false);
+            memcpy(to, from, count);
+            push(dst);
+            continue;
+        }
+
+        op_memmove_byte: {
+            // MEMMOVE_BYTE: Stack: [dst, src, count] -> [dst]
+            const uint64_t count = pop();
+            const uint64_t src = pop();
+            const uint64_t dst = pop();
+            uint8_t* to = io_buffer(dst, count, true);
+            const uint8_t* from = io_buffer(src, count, false);
+            memmove(to, from, count);
+            push(dst);
+            continue;
+        }
+
+        op_memset_byte: {
+            // MEMSET_BYTE: Stack: [dst, value, count] -> [dst]
+            const uint64_t count = pop();
+            const uint64_t value = pop();
+            const uint64_t dst = pop();
+            memset(io_buffer(dst, count, true), static_cast<int>(value & 0xFF), count);
+            push(dst);
+            continue;
+        }
+
+        op_memcmp_byte: {
+            // MEMCMP_BYTE: Stack: [a, b, count] -> [-1/0/1]
+            const uint64_t count = pop();
+            const uint64_t b = pop();
+            const uint64_t a = pop();
+            push(compare_result(memcmp(io_buffer(a, count, false), io_buffer(b, count, false),
+                                       count)));
+            continue;
+        }
+
+        // Packed strings: the loops live in string_ops.hpp, so tokenizer
+        // scans and symbol hashing run as one instruction instead of one
+        // LOAD_BYTE per character. Indices are byte offsets into the string.
+
+        op_str_eq: {
+            // STR_EQ: Stack: [a, b] -> [1/0]
+            const uint64_t b = pop();
+            const uint64_t a = pop();
+            uint64_t a_length = 0;
+            uint64_t b_length = 0;
+            const uint8_t* left = string_bytes(a, a_length);
+            const uint8_t* right = string_bytes(b, b_length);
+            push(a_length == b_length && StringOps::equal(left, right, a_length) ? 1 : 0);
+            continue;
+        }
+
+        op_str_hash: {
+            // STR_HASH: Stack: [str] -> [hash]
+            uint64_t length = 0;
+            const uint8_t* bytes = string_bytes(pop(), length);
+            push(StringOps::hash(bytes, length));
+            continue;
+        }
+
+        op_str_index: {
+            // STR_INDEX: Stack: [str, start, char] -> [index or -1]
+            const uint64_t c = pop();
+            const uint64_t start = pop();
+            uint64_t length = 0;
+            const uint8_t* bytes = string_bytes(pop(), length);
+            const size_t index = c > 0xFF || start >= length
+                                     ? length
+                                     : StringOps::index_of(bytes, length, start,
+                                                           static_cast<uint8_t>(c));
+            push(index == length ? static_cast<uint64_t>(-1) : index);
+            continue;
+        }
+
+        op_str_scan: {
+            // STR_SCAN: Stack: [str, start, classes] -> [index of the first
+            // char at or after start outside classes, or the length]
+            const uint64_t classes = pop();
+            const uint64_t start = pop();
+            uint64_t length = 0;
+            const uint8_t* bytes = string_bytes(pop(), length);
+            push(start >= length ? length : StringOps::scan(bytes, length, start, classes));
+            continue;
+        }
+
+        op_tokenize: {
+            // TOKENIZE: Lex a packed Smalltalk source string natively
+            // Stack: [str, records, max] -> [count]
+            //
+            // Writes up to max records of TOKEN_RECORD_WORDS words, laid out
+            // like the slots of a Token ([tagged type, value, tagged start,
+            // tagged end]), and answers how many it wrote. The last record
+            // is the END token unless max ran out first; length + 1 records
+            // always suffice.
+            // Clamped so the record span cannot wrap; an oversized max still fails
+            const uint64_t max = std::min<uint64_t>(pop(), MEMORY_SIZE);
+            const uint64_t records = pop();
+            uint64_t length = 0;
+            const uint8_t* bytes = string_bytes(pop(), length);
+            uint64_t* out = word_range(records, max * TOKEN_RECORD_WORDS, true);
+
+            SmalltalkLexer lexer(bytes, length);
+            uint64_t count = 0;
+            while (count < max) {
+                const SmalltalkLexer::Token token = lexer.next();
+                uint64_t* record = out + (count * TOKEN_RECORD_WORDS);
+                record[0] = (token.type << 1) | 1;
+                record[1] = token.type == SmalltalkLexer::END ? 0 : (token.value << 1) | 1;
+                record[2] = (static_cast<uint64_t>(token.start) << 1) | 1;
+                record[3] = (static_cast<uint64_t>(token.end) << 1) | 1;
+                count++;
+                if (token.type == SmalltalkLexer::END) {
+                    break;
+                }
+            }
+            push(count);
+            continue;
+        }
+
+        op_function:
+            // Headers are read by the calls and skipped on entry
+            if constexpr (E == Encoding::BYTES) {
+                ip += ByteCode::HEADER_SIZE - 1;
+            }
+            continue;
         }
 
         // Check if we stopped due to instruction limit
@@ -844,6 +1584,7 @@ class StackVM {
         running = true;
     }
 
+  public:
     // Debug accessors
     [[nodiscard]] uint64_t get_top() const {
         return peek();
@@ -872,6 +1613,25 @@ class StackVM {
         return signal_handlers[signal - MIN_SIGNAL];
     }
 
+    // Code addresses the program can still reach: ip, every stack word that
+    // points into the code segment (return addresses among them) and the
+    // registered signal handlers. Stack words are not typed, so this is
+    // conservative: a number that happens to look like a code address counts.
+    [[nodiscard]] std::vector<uint64_t> code_roots() const {
+        std::vector<uint64_t> roots{ip};
+        for (uint64_t addr = sp; addr < STACK_BASE; addr++) {
+            if (memory[addr] < CODE_SIZE) {
+                roots.push_back(memory[addr]);
+            }
+        }
+        for (uint64_t handler : signal_handlers) {
+            if (handler != 0) {
+                roots.push_back(handler);
+            }
+        }
+        return roots;
+    }
+
     [[nodiscard]] uint64_t read_memory(uint64_t addr) const {
         VMChecks::check_memory_bounds(addr, ip, sp, bp, hp);
         return memory[addr];
@@ -920,6 +1680,7 @@ class StackVM {
     void reset_profiling() {
         opcode_counts.fill(0);
         total_instructions = 0;
+        send_sites.clear();
     }
 
     // Get profiling statistics
@@ -933,6 +1694,32 @@ class StackVM {
         return opcode_counts;
     }
 
+    // Selector symbols interned by the INTERN opcode
+    [[nodiscard]] const InternTable& get_selectors() const {
+        return selectors;
+    }
+
+    // Summarize the inline cache state of every send site executed while profiling
+    [[nodiscard]] SendSite::Stats get_send_site_stats() const {
+        SendSite::Stats stats;
+        for (uint64_t site : send_sites) {
+            const uint64_t state = memory[site + SendSite::STATE];
+            stats.sites++;
+            if (state == 0) {
+                stats.unused++;
+            } else if (state == 1) {
+                stats.monomorphic++;
+            } else if (state <= SendSite::MAX_ENTRIES) {
+                stats.polymorphic++;
+            } else {
+                stats.megamorphic++;
+            }
+            stats.hits += memory[site + SendSite::HITS];
+            stats.misses += memory[site + SendSite::MISSES];
+        }
+        return stats;
+    }
+
     // Print profiling report
     void print_profiling_report() const {
         if (total_instructions == 0) {
@@ -949,9 +1736,9 @@ class StackVM {
 
         // Create vector of (opcode, count) pairs for sorting
         std::vector<std::pair<uint8_t, uint64_t>> sorted_opcodes;
-        for (uint8_t i = 0; i < 43; i++) { // Only include valid opcodes
+        for (size_t i = 0; i < opcode_counts.size(); i++) { // Only executed opcodes
             if (opcode_counts[i] > 0) {
-                sorted_opcodes.emplace_back(i, opcode_counts[i]);
+                sorted_opcodes.emplace_back(static_cast<uint8_t>(i), opcode_counts[i]);
             }
         }
 
@@ -967,6 +1754,21 @@ class StackVM {
                       << std::setw(12) << std::right << count << " (" << std::fixed
                       << std::setprecision(2) << percentage << "%)" << std::endl;
         }
+
+        if (!send_sites.empty()) {
+            const SendSite::Stats stats = get_send_site_stats();
+            const uint64_t sends = stats.hits + stats.misses;
+            std::cerr << "\nSend sites: " << stats.sites << " (" << stats.monomorphic
+                      << " monomorphic, " << stats.polymorphic << " polymorphic, "
+                      << stats.megamorphic << " megamorphic, " << stats.unused << " unfilled)"
+                      << std::endl;
+            std::cerr << "  Cache hits: " << stats.hits << ", misses: " << stats.misses;
+            if (sends > 0) {
+                std::cerr << " (" << std::fixed << std::setprecision(2)
+                          << (100.0 * stats.hits) / sends << "% hit rate)";
+            }
+            std::cerr << std::endl;
+        }
         std::cerr << "========================" << std::endl;
     }
 
@@ -981,6 +1783,8 @@ class StackVM {
         bool profiling_enabled;
         std::array<uint64_t, 256> opcode_counts;
         uint64_t total_instructions;
+        std::set<uint64_t> send_sites;
+        InternTable selectors;
     };
 
     // Checkpoint: Save current VM state
@@ -997,6 +1801,8 @@ class StackVM {
         snap.profiling_enabled = profiling_enabled;
         snap.opcode_counts = opcode_counts;
         snap.total_instructions = total_instructions;
+        snap.send_sites = send_sites;
+        snap.selectors = selectors;
 
         // Copy entire memory
         snap.memory.resize(MEMORY_SIZE);
@@ -1022,6 +1828,8 @@ class StackVM {
         profiling_enabled = snap.profiling_enabled;
         opcode_counts = snap.opcode_counts;
         total_instructions = snap.total_instructions;
+        send_sites = snap.send_sites;
+        selectors = snap.selectors;
 
         // Restore entire memory
         memcpy(memory, snap.memory.data(), MEMORY_SIZE * sizeof(uint64_t));
@@ -1095,6 +1903,15 @@ class StackVM {
                 case Opcode::CALL:
                 case Opcode::BP_LOAD:
                 case Opcode::BP_STORE:
+                case Opcode::SEND_CACHED:
+                case Opcode::TADD:
+                case Opcode::TSUB:
+                case Opcode::TMUL:
+                case Opcode::TEQ:
+                case Opcode::TLT:
+                case Opcode::TGT:
+                case Opcode::TLTE:
+                case Opcode::TGTE:
                     if (addr + 1 < MEMORY_SIZE) {
                         std::cerr << " " << memory[addr + 1];
                         addr++; // Skip immediate
@@ -0,0 +1,175 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ============================================================================
+// Packed String Primitives
+// ============================================================================
+// Byte loops behind the STR_EQ, STR_HASH, STR_INDEX and STR_SCAN opcodes.
+// Each works on the bytes of a packed VM string ([length][bytes...]) in
+// place.
+//
+// Searches and class scans test a whole block per step: 32 bytes with AVX2,
+// 16 with SSE2 (always available on x86-64), with a scalar loop for the tail
+// and for other targets. Blocks never read past the end of the string, so
+// the caller only has to bounds check [bytes, bytes + length).
+
+namespace StringOps {
+
+// Character classes for scan(); combine with bit-or
+constexpr uint64_t CLASS_LETTER = 1;     // A-Z a-z
+constexpr uint64_t CLASS_DIGIT = 2;      // 0-9
+constexpr uint64_t CLASS_WHITESPACE = 4; // space, tab, newline, carriage return
+
+inline bool in_class(uint8_t c, uint64_t classes) {
+    if ((classes & CLASS_LETTER) != 0 && static_cast<uint8_t>((c | 0x20) - 'a') < 26) {
+        return true;
+    }
+    if ((classes & CLASS_DIGIT) != 0 && static_cast<uint8_t>(c - '0') < 10) {
+        return true;
+    }
+    return (classes & CLASS_WHITESPACE) != 0 && (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+}
+
+#if defined(__AVX2__)
+
+constexpr size_t BLOCK = 32;
+using Block = __m256i;
+
+inline Block load(const uint8_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+inline Block none() {
+    return _mm256_setzero_si256();
+}
+inline Block splat(uint8_t c) {
+    return _mm256_set1_epi8(static_cast<char>(c));
+}
+inline Block eq(Block a, Block b) {
+    return _mm256_cmpeq_epi8(a, b);
+}
+inline Block either(Block a, Block b) {
+    return _mm256_or_si256(a, b);
+}
+inline uint32_t mask(Block m) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(m));
+}
+// Bytes with lo <= c <= hi, using unsigned min for the range test
+inline Block in_range(Block v, uint8_t lo, uint8_t hi) {
+    const Block x = _mm256_sub_epi8(v, splat(lo));
+    return eq(_mm256_min_epu8(x, splat(hi - lo)), x);
+}
+constexpr uint32_t ALL = 0xFFFFFFFFU;
+
+#elif defined(__SSE2__)
+
+constexpr size_t BLOCK = 16;
+using Block = __m128i;
+
+inline Block load(const uint8_t* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+inline Block none() {
+    return _mm_setzero_si128();
+}
+inline Block splat(uint8_t c) {
+    return _mm_set1_epi8(static_cast<char>(c));
+}
+inline Block eq(Block a, Block b) {
+    return _mm_cmpeq_epi8(a, b);
+}
+inline Block either(Block a, Block b) {
+    return _mm_or_si128(a, b);
+}
+inline uint32_t mask(Block m) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(m));
+}
+inline Block in_range(Block v, uint8_t lo, uint8_t hi) {
+    const Block x = _mm_sub_epi8(v, splat(lo));
+    return eq(_mm_min_epu8(x, splat(hi - lo)), x);
+}
+constexpr uint32_t ALL = 0xFFFFU;
+
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+// Mask of the bytes in block v that belong to classes
+inline uint32_t class_mask(Block v, uint64_t classes) {
+    Block m = none();
+    if ((classes & CLASS_LETTER) != 0) {
+        m = either(m, in_range(either(v, splat(0x20)), 'a', 'z'));
+    }
+    if ((classes & CLASS_DIGIT) != 0) {
+        m = either(m, in_range(v, '0', '9'));
+    }
+    if ((classes & CLASS_WHITESPACE) != 0) {
+        m = either(m, either(either(eq(v, splat(' ')), eq(v, splat('\t'))),
+                             either(eq(v, splat('\n')), eq(v, splat('\r')))));
+    }
+    return mask(m);
+}
+#endif
+
+// Byte equality of two ranges of the same length
+inline bool equal(const uint8_t* a, const uint8_t* b, size_t length) {
+    return length == 0 || memcmp(a, b, length) == 0;
+}
+
+// DJB2 (hash * 33 + c from 5381) with 64-bit wraparound, matching the
+// symbol table's hash-string. Each step depends on the previous hash, so this
+// stays a scalar loop; running it natively is what saves the dispatch.
+inline uint64_t hash(const uint8_t* bytes, size_t length) {
+    uint64_t h = 5381;
+    for (size_t i = 0; i < length; i++) {
+        h = (h * 33) + bytes[i];
+    }
+    return h;
+}
+
+// Index of the first c in [start, length), or length if there is none
+inline size_t index_of(const uint8_t* bytes, size_t length, size_t start, uint8_t c) {
+    size_t i = start;
+#if defined(__AVX2__) || defined(__SSE2__)
+    const Block needle = splat(c);
+    for (; i + BLOCK <= length; i += BLOCK) {
+        const uint32_t hits = mask(eq(load(bytes + i), needle));
+        if (hits != 0) {
+            return i + __builtin_ctz(hits);
+        }
+    }
+#endif
+    for (; i < length; i++) {
+        if (bytes[i] == c) {
+            return i;
+        }
+    }
+    return length;
+}
+
+// Index of the first byte in [start, length) outside classes, or length
+inline size_t scan(const uint8_t* bytes, size_t length, size_t start, uint64_t classes) {
+    size_t i = start;
+#if defined(__AVX2__) || defined(__SSE2__)
+    for (; i + BLOCK <= length; i += BLOCK) {
+        const uint32_t outside = ~class_mask(load(bytes + i), classes) & ALL;
+        if (outside != 0) {
+            return i + __builtin_ctz(outside);
+        }
+    }
+#endif
+    for (; i < length; i++) {
+        if (!in_class(bytes[i], classes)) {
+            return i;
+        }
+    }
+    return length;
+}
+
+} // namespace StringOps
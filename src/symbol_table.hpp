@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
 #include <map>
 #include <optional>
@@ -25,6 +26,7 @@ class SymbolTable {
   private:
     std::map<std::string, SymbolEntry> symbols;
     std::vector<std::string> insertion_order; // For ordered iteration
+    uint64_t changes{0};                      // See generation()
 
   public:
     // Define a variable symbol
@@ -32,7 +34,10 @@ class SymbolTable {
         // Check if already exists (update address if so)
         auto it = symbols.find(name);
         if (it != symbols.end()) {
-            it->second.address = address;
+            if (it->second.address != address) {
+                it->second.address = address;
+                changes++;
+            }
             return;
         }
 
@@ -51,8 +56,11 @@ class SymbolTable {
         // Check if already exists (update if so)
         auto it = symbols.find(name);
         if (it != symbols.end()) {
-            it->second.address = code_address;
-            it->second.params = params;
+            if (it->second.address != code_address || it->second.params != params) {
+                it->second.address = code_address;
+                it->second.params = params;
+                changes++;
+            }
             return;
         }
 
@@ -131,8 +139,18 @@ class SymbolTable {
         }
     }
 
+    // Remove a symbol, if present
+    void remove(const std::string& name) {
+        if (symbols.erase(name) == 0) {
+            return;
+        }
+        changes++;
+        insertion_order.erase(std::find(insertion_order.begin(), insertion_order.end(), name));
+    }
+
     // Clear all symbols
     void clear() {
+        changes++;
         symbols.clear();
         insertion_order.clear();
     }
@@ -142,6 +160,13 @@ class SymbolTable {
         return symbols.size();
     }
 
+    // Bumped whenever an existing symbol is redefined at a new address or
+    // removed, i.e. whenever code compiled against the table may be stale.
+    // New symbols do not bump it.
+    uint64_t generation() const {
+        return changes;
+    }
+
     // Check if empty
     bool empty() const {
         return symbols.empty();
@@ -63,7 +63,7 @@ struct TestState {
         next_string_address = compiler.get_next_string_address();
         next_code_address += program.bytecode.size();
 
-        return code_addr;
+        return code_addr + FunctionHeader::SIZE;
     }
 
     int64_t run(const std::string& code) {
@@ -189,6 +189,57 @@ int main() {
             check(result == 3, "eval \"(bit-or 1 2)\" should return 3");
         }
 
+        // Test 9: Repeated eval reuses the compiled code
+        std::cout << "\nTest 9: Repeated eval reuses the compiled code" << std::endl;
+        {
+            TestState state;
+            int64_t result = state.run("(do "
+                                       "  (define-var i 0) "
+                                       "  (define-var sum 0) "
+                                       "  (while (< i 10) "
+                                       "    (do (set sum (+ sum (eval \"(+ 1 2)\"))) "
+                                       "        (set i (+ i 1)))) "
+                                       "  sum)");
+            check(result == 30, "ten evals of \"(+ 1 2)\" should sum to 30");
+            const auto& stats = state.eval_ctx.eval_cache.get_stats();
+            check(stats.misses == 1 && stats.hits == 9, "only the first eval should compile");
+
+            uint64_t start = state.next_code_address;
+            state.run("(funcall (compile \"(+ 1 2)\"))");
+            const uint64_t first = state.next_code_address - start;
+            start = state.next_code_address;
+            state.run("(funcall (compile \"(+ 1 2)\"))");
+            check(state.next_code_address - start < first &&
+                      state.eval_ctx.compile_cache.get_stats().hits == 1,
+                  "a repeated compile should load no new code");
+        }
+
+        // Test 10: Redefining a function invalidates cached code
+        std::cout << "\nTest 10: Redefining a function invalidates cached code" << std::endl;
+        {
+            TestState state;
+            state.run("(define-func (answer) 1)");
+            state.run("(eval \"(answer)\")");
+            int64_t result = state.run("(eval \"(answer)\")");
+            check(result == 1, "eval \"(answer)\" should return 1");
+            check(state.eval_ctx.eval_cache.get_stats().hits == 1, "second eval should hit");
+
+            state.run("(define-func (answer) 2)");
+            result = state.run("(eval \"(answer)\")");
+            check(result == 2, "eval after redefinition should return 2");
+            check(state.eval_ctx.eval_cache.get_stats().invalidations == 1,
+                  "redefinition should invalidate the cached entry");
+        }
+
+        // Test 11: Code that defines symbols is not cached
+        std::cout << "\nTest 11: Code that defines symbols is not cached" << std::endl;
+        {
+            TestState state;
+            state.run("(eval \"(define-var y 5)\")");
+            check(state.eval_ctx.eval_cache.size() == 0, "define-var should not be cached");
+            check(state.run("y") == 5, "variable y defined in eval should persist");
+        }
+
         std::cout << std::endl << "=== Summary ===" << std::endl;
         std::cout << "Passed: " << tests_passed << std::endl;
         std::cout << "Failed: " << tests_failed << std::endl;
@@ -3,6 +3,7 @@
 #include <stdexcept>
 #include <string>
 
+#include "function_header.hpp"
 #include "memory_layout.hpp"
 #include "vm_exception.hpp"
 
@@ -57,6 +58,16 @@ inline void check_ip_bounds(uint64_t ip_val, uint64_t sp, uint64_t bp, uint64_t
     }
 }
 
+// Byte code (byte_code.hpp) runs from byte addresses in the code segment
+inline void check_byte_ip_bounds(uint64_t ip_val, uint64_t sp, uint64_t bp, uint64_t hp) {
+    if constexpr (BOUNDS_CHECKS_ENABLED) {
+        constexpr uint64_t limit = MemoryLayout::words_to_bytes(MemoryLayout::CODE_SIZE);
+        if (ip_val >= limit) {
+            throw VMException::IPBounds(ip_val, limit, sp, bp, hp);
+        }
+    }
+}
+
 // Code segment write protection (compile-time optional via if constexpr)
 inline void check_code_segment_protection(uint64_t addr, uint64_t ip, uint64_t sp, uint64_t bp,
                                           uint64_t hp) {
@@ -76,6 +87,15 @@ inline void check_stack_overflow(uint64_t sp, uint64_t hp, uint64_t ip, uint64_t
     }
 }
 
+// Room for words more on the stack (check before growing it in one step)
+inline void check_stack_room(uint64_t sp, uint64_t words, uint64_t hp, uint64_t ip, uint64_t bp) {
+    if constexpr (BOUNDS_CHECKS_ENABLED) {
+        if (words >= sp - hp) {
+            throw VMException::StackOverflow(sp, sp - words, hp, ip, bp, hp);
+        }
+    }
+}
+
 // Stack underflow detection (check before pop)
 inline void check_stack_underflow(uint64_t sp, uint64_t ip, uint64_t bp, uint64_t hp) {
     if constexpr (BOUNDS_CHECKS_ENABLED) {
@@ -104,12 +124,34 @@ inline void check_stack_frame_bounds(uint64_t addr, uint64_t sp, uint64_t ip, ui
     }
 }
 
-// BP_STORE index validation (must be at least 1 to not overwrite return address)
-inline void check_bp_store_index(uint64_t idx, uint64_t ip, uint64_t sp, uint64_t bp, uint64_t hp) {
+// A call target must have a function header in front of it. Always checked
+// for targets that are only known at run time (FUNCALL, SEND_CACHED): RET
+// drops as many arguments as the header says, and ENTER reserves as many
+// temporaries, so a target without one would corrupt the stack.
+inline void require_function_header(uint64_t target, uint64_t header, uint64_t ip, uint64_t sp,
+                                    uint64_t bp, uint64_t hp) {
+    if (!FunctionHeader::is_header(header)) {
+        throw VMException::InvalidCall(target, "no function header", ip, sp, bp, hp);
+    }
+}
+
+// Same, for CALL targets, which the compiler already resolved
+inline void check_function_header(uint64_t target, uint64_t header, uint64_t ip, uint64_t sp,
+                                  uint64_t bp, uint64_t hp) {
     if constexpr (BOUNDS_CHECKS_ENABLED) {
-        if (idx < 1) {
-            throw VMException::InvalidBPStoreIndex(idx, ip, sp, bp, hp);
-        }
+        require_function_header(target, header, ip, sp, bp, hp);
+    }
+}
+
+// Calls whose argument count is only known at run time must match the header,
+// in every build: RET drops the header's count, not the caller's
+inline void check_call_arity(uint64_t target, uint64_t header, uint64_t nb_args, uint64_t ip,
+                             uint64_t sp, uint64_t bp, uint64_t hp) {
+    if (FunctionHeader::arity(header) != nb_args) {
+        throw VMException::InvalidCall(target,
+                                       "expects " + std::to_string(FunctionHeader::arity(header)) +
+                                           " arguments, got " + std::to_string(nb_args),
+                                       ip, sp, bp, hp);
     }
 }
 
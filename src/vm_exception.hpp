@@ -210,23 +210,6 @@ class StackFrameBounds : public Base {
     }
 };
 
-class InvalidBPStoreIndex : public Base {
-  private:
-    uint64_t index_;
-
-  public:
-    InvalidBPStoreIndex(uint64_t index, uint64_t ip, uint64_t sp, uint64_t bp, uint64_t hp)
-        : Base("INVALID_BP_STORE",
-               "Invalid BP_STORE index " + std::to_string(index) +
-                   ": must be at least 1 to avoid overwriting return address",
-               ip, sp, bp, hp),
-          index_(index) {}
-
-    [[nodiscard]] uint64_t get_index() const {
-        return index_;
-    }
-};
-
 // ============================================================================
 // Execution Exceptions
 // ============================================================================
@@ -303,6 +286,44 @@ class InvalidAddress : public Base {
     }
 };
 
+class InvalidCall : public Base {
+  private:
+    uint64_t target_;
+
+  public:
+    InvalidCall(uint64_t target, const std::string& reason, uint64_t ip, uint64_t sp, uint64_t bp,
+                uint64_t hp)
+        : Base("INVALID_CALL", "Call to " + std::to_string(target) + ": " + reason, ip, sp, bp,
+               hp),
+          target_(target) {}
+
+    [[nodiscard]] uint64_t get_target() const {
+        return target_;
+    }
+};
+
+class InvalidSymbol : public Base {
+  private:
+    std::string name_;
+    uint64_t id_;
+
+  public:
+    InvalidSymbol(const std::string& name, uint64_t id, uint64_t ip, uint64_t sp, uint64_t bp,
+                  uint64_t hp)
+        : Base("INVALID_SYMBOL",
+               "Cannot intern '" + name + "' as symbol " + std::to_string(id) +
+                   ": name or id already in use, or id out of range",
+               ip, sp, bp, hp),
+          name_(name), id_(id) {}
+
+    [[nodiscard]] const std::string& get_name() const {
+        return name_;
+    }
+    [[nodiscard]] uint64_t get_id() const {
+        return id_;
+    }
+};
+
 // ============================================================================
 // Snapshot/Restore Exceptions
 // ============================================================================
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../../src/lisp_compiler.hpp"
+#include "../../src/lisp_parser.hpp"
+#include "../../src/stack_vm.hpp"
+#include <cassert>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Driver shared by the Smalltalk integration tests. It loads the runtime straight
+// from the modules (the same list as SMALLTALK_MODULES in the Makefile) so a test
+// exercises the current sources, bootstraps the class hierarchy and runs the test
+// file: a (do ...) form that ends with the sentinel 424242.
+
+inline std::string read_file(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+inline std::string smalltalk_test_source(const std::string& test_file) {
+    const char* modules[] = {
+        "lisp/smalltalk/00-runtime.lisp",  "lisp/smalltalk/01-symbol-table.lisp",
+        "lisp/smalltalk/02-classes.lisp",  "lisp/smalltalk/03-methods.lisp",
+        "lisp/smalltalk/04-tokenizer.lisp", "lisp/smalltalk/05-parser.lisp",
+        "lisp/smalltalk/06-compiler.lisp", "lisp/smalltalk/07-bootstrap.lisp"};
+
+    std::string code = "(do\n";
+    for (const char* module : modules) {
+        code += read_file(module);
+    }
+    code += "\n(bootstrap-smalltalk)\n";
+    code += read_file(test_file);
+    code += ")\n";
+    return code;
+}
+
+// Runs lisp/smalltalk/<test_file>. `setup` runs before execution and `check`
+// after it, for tests that also inspect the VM. Returns the process exit code.
+inline int run_smalltalk_test(const std::string& title, const std::string& test_file,
+                              const std::function<void(StackVM&)>& setup = nullptr,
+                              const std::function<void(StackVM&)>& check = nullptr) {
+    std::cout << "=== Smalltalk " << title << " Tests ===" << '\n';
+    std::cout << "Loading runtime modules and test code..." << '\n' << '\n';
+
+    try {
+        LispParser parser(smalltalk_test_source("lisp/smalltalk/" + test_file));
+        auto ast = parser.parse();
+
+        LispCompiler compiler;
+        auto program = compiler.compile(ast);
+
+        std::cout << "Bytecode: " << program.bytecode.size() << " words" << '\n';
+        std::cout << "Strings: " << program.strings.size() << " literals" << '\n' << '\n';
+
+        StackVM vm;
+        vm.load_program(program);
+        if (setup) {
+            setup(vm);
+        }
+        vm.execute();
+
+        // The test form ends with a sentinel; an ABORT stops execution early
+        assert(vm.get_top() == 424242);
+        if (check) {
+            check(vm);
+        }
+
+        std::cout << "\n=== " << title << " Tests Complete ===" << '\n';
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,16 @@
+#include "st_test_driver.hpp"
+
+int main() {
+    return run_smalltalk_test(
+        "Send Cache", "test_10_send_cache.lisp", [](StackVM& vm) { vm.enable_profiling(); },
+        [](StackVM& vm) {
+            const SendSite::Stats stats = vm.get_send_site_stats();
+            assert(stats.sites > 0);
+            assert(stats.monomorphic > 0);
+            assert(stats.hits > 0);
+            assert(stats.misses > 0);
+            std::cout << "  ✓ Profiler saw " << stats.sites << " send sites ("
+                      << stats.monomorphic << " monomorphic, " << stats.polymorphic
+                      << " polymorphic, " << stats.megamorphic << " megamorphic)" << '\n';
+        });
+}
@@ -0,0 +1,5 @@
+#include "st_test_driver.hpp"
+
+int main() {
+    return run_smalltalk_test("Stack Context", "test_11_stack_contexts.lisp");
+}
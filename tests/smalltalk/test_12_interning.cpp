@@ -0,0 +1,5 @@
+#include "st_test_driver.hpp"
+
+int main() {
+    return run_smalltalk_test("Selector Interning", "test_12_interning.lisp");
+}
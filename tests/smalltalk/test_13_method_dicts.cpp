@@ -0,0 +1,5 @@
+#include "st_test_driver.hpp"
+
+int main() {
+    return run_smalltalk_test("Method Dictionary", "test_13_method_dicts.lisp");
+}
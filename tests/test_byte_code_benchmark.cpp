@@ -0,0 +1,101 @@
+#include "../src/lisp_compiler.hpp"
+#include "../src/lisp_parser.hpp"
+#include "../src/stack_vm.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+// Compiles the Smalltalk runtime and bootstrap as one program and runs it
+// from word code and from byte code (byte_code.hpp), reporting the size of
+// each and the best of several runs.
+
+static constexpr int PASSES = 20;
+
+static const char* MODULES[] = {
+    "lisp/smalltalk/00-runtime.lisp",   "lisp/smalltalk/01-symbol-table.lisp",
+    "lisp/smalltalk/02-classes.lisp",   "lisp/smalltalk/03-methods.lisp",
+    "lisp/smalltalk/04-tokenizer.lisp", "lisp/smalltalk/05-parser.lisp",
+    "lisp/smalltalk/06-compiler.lisp",  "lisp/smalltalk/07-bootstrap.lisp"};
+
+static std::string read_file(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+struct Run {
+    double ms;
+    uint64_t result;
+};
+
+// Best of PASSES runs, each in a fresh VM; load() puts the program in it.
+// The bootstrap's progress output is dropped.
+template <typename Load, typename Execute> static Run time_runs(Load load, Execute execute) {
+    Run best{duration<double, std::milli>::max().count(), 0};
+    std::streambuf* out = std::cout.rdbuf(nullptr);
+    for (int pass = 0; pass < PASSES; pass++) {
+        StackVM vm;
+        load(vm);
+        const auto start = steady_clock::now();
+        execute(vm);
+        const double ms = duration<double, std::milli>(steady_clock::now() - start).count();
+        best.ms = std::min(best.ms, ms);
+        best.result = vm.get_top();
+    }
+    std::cout.rdbuf(out);
+    std::cout.clear();
+    return best;
+}
+
+int main() {
+    std::cout << "=== Byte Code Benchmark ===" << '\n';
+
+    try {
+        std::string code = "(do\n";
+        for (const char* module : MODULES) {
+            code += read_file(module);
+        }
+        code += "\n(bootstrap-smalltalk)\n1)\n";
+
+        LispParser parser(code);
+        LispCompiler compiler;
+        const CompiledProgram program = compiler.compile(parser.parse());
+        const std::vector<uint8_t> bytes = ByteCode::encode(program.bytecode, program.code_refs);
+
+        const size_t word_bytes = program.bytecode.size() * sizeof(uint64_t);
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Word code:  " << word_bytes << " bytes (" << program.bytecode.size()
+                  << " words)" << '\n';
+        std::cout << "Byte code:  " << bytes.size() << " bytes ("
+                  << 100.0 * static_cast<double>(bytes.size()) / static_cast<double>(word_bytes)
+                  << "%)" << '\n';
+
+        const Run words = time_runs([&](StackVM& vm) { vm.load_program(program); },
+                                    [](StackVM& vm) { vm.execute(); });
+        const Run byte_code = time_runs([&](StackVM& vm) { vm.load_byte_program(program); },
+                                        [](StackVM& vm) { vm.execute_byte_code(); });
+        if (words.result != byte_code.result) {
+            std::cerr << "Results differ: " << words.result << " and " << byte_code.result
+                      << '\n';
+            return 1;
+        }
+
+        std::cout << "Bootstrap:  " << words.ms << " ms from word code, " << byte_code.ms
+                  << " ms from byte code (best of " << PASSES << ")" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+}
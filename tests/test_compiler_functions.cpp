@@ -3,6 +3,7 @@
 #include "../src/stack_vm.hpp"
 #include <cassert>
 #include <iostream>
+#include <string>
 
 void test_compile_simple_function() {
     std::cout << "Testing simple function..." << '\n';
@@ -221,6 +222,177 @@ void test_compile_function_with_arguments_and_temporaries() {
     std::cout << "  ✓ fn: f(12, 23, 34) = 144" << '\n';
 }
 
+void test_compile_function_frame_temporaries() {
+    std::cout << "Testing loops and lets in frame temporaries..." << '\n';
+
+    // Each call loops over its own i and total; with globals the recursive
+    // calls would clobber the caller's
+    std::string code = R"(
+        (do
+            (define-func (paths n)
+                (if (= n 0)
+                    1
+                    (let ((total 0))
+                        (for (i 0 n) (set total (+ total (paths i))))
+                        (define-var last n)
+                        (+ total (- last n)))))
+            (paths 6))
+    )";
+
+    LispParser parser(code);
+    LispCompiler compiler;
+    const uint64_t globals = compiler.get_next_var_address();
+    auto bytecode = compiler.compile(parser.parse());
+    assert(compiler.get_next_var_address() == globals);
+    std::cout << "  ✓ No globals are allocated for them" << '\n';
+
+    const uint64_t entry = compiler.get_symbol_table().lookup("paths")->address;
+    const uint64_t header = bytecode.bytecode[entry - FunctionHeader::SIZE];
+    assert(FunctionHeader::is_header(header));
+    assert(FunctionHeader::arity(header) == 1);
+    std::cout << "  ✓ The header before the entry point gives the frame: "
+              << FunctionHeader::temporaries(header) << " temporaries" << '\n';
+
+    StackVM vm;
+    vm.load_program(bytecode);
+    vm.execute();
+    assert(vm.get_top() == 32);
+    std::cout << "  ✓ Recursive calls inside a loop: paths(6) = 32" << '\n';
+}
+
+// A REPL-style session: one incremental compiler, one VM, code appended
+struct Session {
+    LispCompiler compiler;
+    StackVM vm;
+    uint64_t next_code_address{0};
+
+    Session() {
+        compiler.set_incremental(true);
+    }
+
+    CompiledProgram compile(const std::string& code) {
+        LispParser parser(code);
+        compiler.set_code_base_address(next_code_address);
+        return compiler.compile(parser.parse());
+    }
+
+    uint64_t run(const std::string& code) {
+        auto program = compile(code);
+        vm.reset();
+        vm.load_program_at(program, next_code_address);
+        vm.set_ip(next_code_address);
+        next_code_address += program.bytecode.size();
+        vm.execute();
+        return vm.get_top();
+    }
+
+    bool fails(const std::string& code) {
+        try {
+            compile(code);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+};
+
+void test_compile_incremental() {
+    std::cout << "Testing incremental compilation..." << '\n';
+
+    Session session;
+    session.run("(define-func (square x) (* x x))");
+    session.run("(define-var base 10)");
+    assert(session.run("(+ (square 7) base)") == 59);
+    std::cout << "  ✓ Functions and globals persist across compiles" << '\n';
+
+    const size_t call_size = session.compile("(square 3)").bytecode.size();
+    for (int i = 0; i < 20; i++) {
+        session.run("(define-func (f" + std::to_string(i) + " x) (+ (square x) " +
+                    std::to_string(i) + "))");
+    }
+    assert(session.compile("(square 3)").bytecode.size() == call_size);
+    assert(session.run("(f19 2)") == 23);
+    std::cout << "  ✓ Earlier functions are called, not compiled again" << '\n';
+
+    session.run("(define-var greeting \"hello\")");
+    assert(session.compile("(print-string \"world\")").strings.size() == 1);
+    assert(session.compile("(print-string \"hello\")").strings.empty());
+    std::cout << "  ✓ Only new string literals are emitted" << '\n';
+
+    const size_t symbols = session.compiler.get_symbol_table().size();
+    const uint64_t next_var = session.compiler.get_next_var_address();
+    assert(session.fails("(do (define-var a 1) (define-func (square y) y) (define-func (g) 2) "
+                         "(print-string \"lost\") undefined-symbol)"));
+    assert(session.compiler.get_symbol_table().size() == symbols);
+    assert(session.compiler.get_next_var_address() == next_var);
+    assert(session.fails("(g)"));
+    assert(session.run("(square 5)") == 25);
+    assert(session.compile("(print-string \"lost\")").strings.size() == 1);
+    assert(session.run("(do (define-var a 5) (+ a base))") == 15);
+    std::cout << "  ✓ A failed compile leaves no definitions behind" << '\n';
+}
+
+// A program of count functions, each calling the one before, with loops,
+// lets, globals and string literals (some shared) in their bodies
+static std::string many_functions(int count, const std::string& extra) {
+    std::string code = "(do (define-func (f0 x) x)";
+    for (int i = 1; i < count; i++) {
+        const std::string n = std::to_string(i);
+        code += " (define-func (f" + n + " x) (let ((acc (f" + std::to_string(i - 1) +
+                " x))) (define-var g" + n + " " + n + ") (for (k 0 3) (set acc (+ acc k))) " +
+                "(while (> acc 1000000) (set acc 0)) " +
+                "(if (< acc 0) (print-string \"s" + std::to_string(i % 7) + "\") 0) " +
+                "(if (< acc 0) (print-string \"t" + n + "\") 0) (+ acc g" + n + ")))";
+    }
+    return code + extra + " (f" + std::to_string(count - 1) + " 1))";
+}
+
+static CompiledProgram compile_with_threads(const std::string& code, size_t threads) {
+    LispParser parser(code);
+    LispCompiler compiler;
+    compiler.set_compile_threads(threads);
+    return compiler.compile(parser.parse());
+}
+
+static bool same_program(const CompiledProgram& a, const CompiledProgram& b) {
+    if (a.bytecode != b.bytecode || a.strings.size() != b.strings.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.strings.size(); i++) {
+        if (a.strings[i].content != b.strings[i].content ||
+            a.strings[i].address != b.strings[i].address) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_compile_parallel() {
+    std::cout << "Testing parallel function compilation..." << '\n';
+
+    const std::string code = many_functions(200, "");
+    const CompiledProgram serial = compile_with_threads(code, 1);
+    for (size_t threads : {2, 3, 8}) {
+        assert(same_program(compile_with_threads(code, threads), serial));
+    }
+    std::cout << "  ✓ Same bytecode and strings as a serial compile" << '\n';
+
+    StackVM vm;
+    vm.load_program(compile_with_threads(code, 4));
+    vm.execute();
+    assert(vm.get_top() == 1 + 3 * 199 + 199 * 200 / 2);
+    std::cout << "  ✓ The program runs" << '\n';
+
+    // symbol-count needs the symbols placed before it; a nested definition
+    // can't be compiled apart at all
+    const std::string symbols = many_functions(100, " (define-func (count) (symbol-count))");
+    assert(same_program(compile_with_threads(symbols, 4), compile_with_threads(symbols, 1)));
+    const std::string nested =
+        many_functions(100, " (define-func (outer) (define-func (inner) 1))");
+    assert(same_program(compile_with_threads(nested, 4), compile_with_threads(nested, 1)));
+    std::cout << "  ✓ Functions that can't be compiled apart are compiled in order" << '\n';
+}
+
 int main() {
     std::cout << "=== Compiler Function Tests ===" << '\n';
 
@@ -236,6 +408,9 @@ int main() {
         test_compile_function_calling_function();
         test_compile_function_with_conditionals();
         test_compile_function_with_arguments_and_temporaries();
+        test_compile_function_frame_temporaries();
+        test_compile_incremental();
+        test_compile_parallel();
 
         std::cout << "\n✓ All compiler function tests passed!" << '\n';
         return 0;
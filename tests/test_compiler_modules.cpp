@@ -0,0 +1,262 @@
+#include "../src/lisp_compiler.hpp"
+#include "../src/lisp_module.hpp"
+#include "../src/lisp_parser.hpp"
+#include "../src/stack_vm.hpp"
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+static const std::string BASE = R"(
+    (define-var counter 10)
+    (define-var greeting "hello")
+    (define-func (bump n)
+        (do (set counter (+ counter n)) counter))
+    (define-func (twice n) (* (bump n) 2))
+    0
+)";
+
+static const std::string USER = R"(
+    (define-var total 0)
+    (define-func (sum-to n)
+        (do (for (i 0 n) (set total (+ total i))) total))
+    (define-func (local-twice n) (twice n))
+    (+ (sum-to 5) (local-twice 1) (peek greeting) (funcall (function-address bump) 100))
+)";
+
+static LispModule compile_module(const std::string& source, const SymbolTable& imports) {
+    LispParser parser(source);
+    LispCompiler compiler;
+    LispModule module = compiler.compile_module(parser.parse_all(), imports);
+    module.source_hash = LispModule::hash(source);
+    return module;
+}
+
+static bool compile_fails(const std::string& source, const SymbolTable& imports) {
+    try {
+        compile_module(source, imports);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// Links modules in order, each at the given code address, running each one's
+// top-level code before linking the next; returns the last one's result
+struct Image {
+    StackVM vm;
+    SymbolTable symbols;
+    ModuleLinker linker;
+
+    // Globals and strings where a compiler would put them
+    Image()
+        : linker(LispCompiler().get_next_var_address(), LispCompiler().get_next_string_address()) {
+    }
+
+    uint64_t run(const LispModule& module, uint64_t code_address) {
+        CompiledProgram program = linker.link(module, code_address, symbols);
+        vm.load_program_at(program, code_address);
+        vm.reset();
+        vm.set_ip(code_address);
+        vm.execute();
+        return vm.get_top();
+    }
+};
+
+void test_link_and_run() {
+    std::cout << "Testing linking separately compiled modules..." << '\n';
+
+    LispParser parser("(do " + BASE + USER + ")");
+    LispCompiler whole;
+    StackVM vm;
+    vm.load_program(whole.compile(parser.parse()));
+    vm.execute();
+    const uint64_t expected = vm.get_top();
+
+    Image image;
+    const LispModule base = compile_module(BASE, image.symbols);
+    assert(image.run(base, 0) == 0);
+    const LispModule user = compile_module(USER, image.symbols);
+    assert(image.run(user, 5000) == expected);
+    std::cout << "  ✓ Same result as compiling both as one program: " << expected << '\n';
+
+    assert(base.imports.empty());
+    assert(user.imports.size() == 3); // bump, greeting, twice
+    assert(image.symbols.lookup("sum-to")->address >= 5000);
+    const uint64_t greeting = image.symbols.lookup("greeting")->address;
+    assert(image.symbols.lookup("total")->address == greeting + 1);
+    std::cout << "  ✓ Imports are recorded and exports placed at the link addresses" << '\n';
+
+    Image moved;
+    moved.run(base, 300);
+    assert(moved.run(user, 40000) == expected);
+    std::cout << "  ✓ The same modules run linked at other addresses" << '\n';
+}
+
+void test_imports() {
+    std::cout << "Testing module imports..." << '\n';
+
+    SymbolTable symbols;
+    symbols.define_function("twice", 100, {"n"});
+    symbols.define_function("bump", 200, {"n"});
+    symbols.define_variable("greeting", 300);
+    const LispModule user = compile_module(USER, symbols);
+    assert(user.links_against(symbols));
+
+    SymbolTable more = symbols;
+    more.define_function("unrelated", 400, {});
+    more.define_function("twice", 500, {"n"});
+    assert(user.links_against(more));
+    std::cout << "  ✓ New symbols and moved imports don't stop a module linking" << '\n';
+
+    SymbolTable changed = symbols;
+    changed.define_function("twice", 100, {"a", "b"});
+    assert(!user.links_against(changed));
+    SymbolTable missing;
+    missing.define_function("twice", 100, {"n"});
+    assert(!user.links_against(missing));
+    ModuleLinker linker(0, 0);
+    bool threw = false;
+    try {
+        linker.link(user, 0, missing);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ Changed or missing imports do" << '\n';
+
+    // Compiled while print was the intrinsic; a function print defined since
+    // would take the call in a fresh compile
+    const LispModule printer = compile_module("(print 5)", symbols);
+    assert(std::find(printer.forms.begin(), printer.forms.end(), "print") !=
+           printer.forms.end());
+    assert(printer.links_against(symbols));
+    SymbolTable redefined = symbols;
+    redefined.define_function("print", 600, {"x"});
+    assert(!printer.links_against(redefined));
+    threw = false;
+    try {
+        linker.link(printer, 0, redefined);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(compile_module("(print 5)", redefined).imports.size() == 1);
+    std::cout << "  ✓ So does a new function named like a form the module used" << '\n';
+
+    assert(compile_fails("(undefined-function 1)", symbols));
+    assert(compile_fails("(twice 1 2)", symbols));
+    assert(compile_fails("(symbol-count)", symbols));
+    std::cout << "  ✓ Undefined functions, bad calls and symbol-* forms don't compile" << '\n';
+}
+
+void test_serialize() {
+    std::cout << "Testing module files..." << '\n';
+
+    SymbolTable symbols;
+    const LispModule base = compile_module(BASE, symbols);
+    std::stringstream file;
+    base.write(file);
+    const LispModule copy = LispModule::read(file);
+    assert(copy.code == base.code && copy.code_relocs == base.code_relocs);
+    assert(copy.global_relocs == base.global_relocs && copy.global_count == base.global_count);
+    assert(copy.string_relocs == base.string_relocs && copy.strings == base.strings);
+    assert(copy.symbol_relocs == base.symbol_relocs && copy.source_hash == base.source_hash);
+    assert(copy.forms == base.forms && !copy.forms.empty());
+    assert(copy.exports.size() == base.exports.size());
+    for (size_t i = 0; i < copy.exports.size(); i++) {
+        assert(copy.exports[i].name == base.exports[i].name);
+        assert(copy.exports[i].address == base.exports[i].address);
+        assert(copy.exports[i].params == base.exports[i].params);
+    }
+    std::cout << "  ✓ A module reads back as written" << '\n';
+
+    const std::string bytes = file.str();
+    for (size_t cut : {size_t{0}, size_t{12}, bytes.size() / 2, bytes.size() - 1}) {
+        std::stringstream truncated(bytes.substr(0, cut));
+        bool threw = false;
+        try {
+            LispModule::read(truncated);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    std::cout << "  ✓ Truncated files are rejected" << '\n';
+
+    // Exports must name a function entry or one of the module's globals
+    auto rejects = [](const LispModule& module) {
+        std::stringstream out;
+        module.write(out);
+        try {
+            LispModule::read(out);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    auto export_of = [](LispModule& module, bool function) -> SymbolEntry& {
+        return *std::find_if(module.exports.begin(), module.exports.end(),
+                             [&](const SymbolEntry& e) { return e.is_function() == function; });
+    };
+    for (const uint64_t address : {uint64_t{0}, base.code.size(), base.code.size() + 1000}) {
+        LispModule bad = base;
+        export_of(bad, true).address = address;
+        assert(rejects(bad));
+    }
+    LispModule mid_function = base;
+    export_of(mid_function, true).address += 1;
+    assert(rejects(mid_function));
+    LispModule bad_global = base;
+    export_of(bad_global, false).address = base.global_count;
+    assert(rejects(bad_global));
+    assert(!rejects(base));
+    std::cout << "  ✓ Exports outside the module are rejected" << '\n';
+}
+
+void test_cache() {
+    std::cout << "Testing the module cache..." << '\n';
+
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "micro_talk_test_modules";
+    std::filesystem::remove_all(dir);
+    ModuleCache cache(dir);
+
+    SymbolTable symbols;
+    const LispModule base = compile_module(BASE, symbols);
+    assert(!cache.load(base.source_hash, symbols));
+    cache.store(base);
+    const std::optional<LispModule> loaded = cache.load(base.source_hash, symbols);
+    assert(loaded && loaded->code == base.code);
+    assert(!cache.load(LispModule::hash(BASE + " "), symbols));
+    std::cout << "  ✓ Modules are found by source hash" << '\n';
+
+    for (const auto& file : std::filesystem::directory_iterator(dir)) {
+        std::ofstream(file.path(), std::ios::binary) << "garbage";
+    }
+    assert(!cache.load(base.source_hash, symbols));
+    assert(cache.get_stats().hits == 1 && cache.get_stats().misses == 3);
+    std::cout << "  ✓ Damaged files are misses" << '\n';
+
+    std::filesystem::remove_all(dir);
+}
+
+int main() {
+    std::cout << "=== Compiler Module Tests ===" << '\n';
+
+    try {
+        test_link_and_run();
+        test_imports();
+        test_serialize();
+        test_cache();
+
+        std::cout << "\n✓ All compiler module tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
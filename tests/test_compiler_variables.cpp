@@ -135,6 +135,42 @@ void test_compile_let_shadowing() {
     std::cout << "  ✓ Let shadowing: outer x=100, let x=42 returns 42" << '\n';
 }
 
+void test_compile_scope_restore() {
+    std::cout << "Testing scopes close over their bindings..." << '\n';
+
+    std::string code = R"(
+        (do
+            (define-var x 100)
+            (let ((x 1))
+                (let ((x 2) (y 3))
+                    (set x (+ x y))))
+            x)
+    )";
+
+    LispParser parser(code);
+    auto ast = parser.parse();
+    LispCompiler compiler;
+    auto bytecode = compiler.compile(ast);
+
+    StackVM vm;
+    vm.load_program(bytecode);
+    vm.execute();
+
+    assert(vm.get_top() == 100);
+    std::cout << "  ✓ Outer x is visible again after nested lets shadow it" << '\n';
+
+    bool threw = false;
+    try {
+        LispParser dup("(let ((x 1) (x 2)) x)");
+        LispCompiler dup_compiler;
+        dup_compiler.compile(dup.parse());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ Binding a name twice in one scope is an error" << '\n';
+}
+
 void test_compile_let_multiple_body() {
     std::cout << "Testing let with multiple body expressions..." << '\n';
 
@@ -218,6 +254,7 @@ int main() {
 
         test_compile_let();
         test_compile_let_shadowing();
+        test_compile_scope_restore();
         test_compile_let_multiple_body();
         test_compile_nested_let();
         std::cout << '\n';
@@ -1,6 +1,9 @@
 #include "../src/lisp_parser.hpp"
 #include <cassert>
+#include <cstdint>
 #include <iostream>
+#include <string>
+#include <vector>
 
 void test_parse_number() {
     std::cout << "Testing number parsing..." << '\n';
@@ -213,6 +216,90 @@ void test_parse_multiple_expressions() {
     std::cout << "  ✓ Empty input returns empty vector" << '\n';
 }
 
+void test_arena_nodes() {
+    std::cout << "Testing arena-allocated nodes..." << '\n';
+
+    std::string source = "(define-func (greet name) (print-string \"hi \\\"there\\\"\") \"plain\")";
+    LispParser parser(source);
+    auto node = parser.parse();
+    source.assign(source.size(), 'x'); // The parser keeps its own copy
+    const auto items = node->as_list();
+    assert(items.size() == 4);
+    assert(items[0]->as_symbol() == "define-func");
+    assert(items[1]->as_list()[1]->as_symbol() == "name");
+    assert(items[2]->as_list()[1]->as_string() == "hi \"there\"");
+    assert(items[3]->as_string() == "plain");
+    assert(items.end() - items.begin() == 4);
+    std::cout << "  ✓ Symbols and strings survive the caller's source buffer" << '\n';
+
+    LispParser moved_from("(a (b c) d)");
+    auto tree = moved_from.parse();
+    LispParser moved = std::move(moved_from);
+    assert(tree->as_list()[1]->as_list()[1]->as_symbol() == "c");
+    assert(moved.nodes().bytes_used() > 0);
+    std::cout << "  ✓ Nodes stay valid when the parser is moved" << '\n';
+
+    bool threw = false;
+    try {
+        (void)items[0]->as_list();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ Reading a node as the wrong type throws" << '\n';
+
+    ASTArena arena;
+    const ASTNodePtr parts[] = {arena.make_symbol("+"), arena.make_number(1),
+                                arena.make_number(2)};
+    auto sum = arena.make_list(parts, 3);
+    assert(sum->as_list()[2]->as_number() == 2);
+    assert(arena.make_string(arena.store("copied"))->as_string() == "copied");
+    std::cout << "  ✓ Nodes can be built directly in an arena" << '\n';
+}
+
+void test_symbol_interning() {
+    std::cout << "Testing interned symbols..." << '\n';
+
+    LispParser first("(let ((counter 1)) (+ counter counter))");
+    LispParser second("(set counter 2)");
+    const auto a = first.parse()->as_list();
+    const auto b = second.parse()->as_list();
+    const uint32_t counter = a[1]->as_list()[0]->as_list()[0]->symbol_id();
+    assert(a[2]->as_list()[1]->symbol_id() == counter);
+    assert(b[1]->symbol_id() == counter);
+    assert(LispSymbols::name(counter) == "counter");
+    std::cout << "  ✓ The same name has the same id across parsers" << '\n';
+
+    assert(a[1]->as_list()[0]->as_list()[0]->as_symbol().data() ==
+           LispSymbols::name(counter).data());
+    assert(b[1]->as_symbol().data() == LispSymbols::name(counter).data());
+    std::cout << "  ✓ Symbols point at the table's text" << '\n';
+
+    // Enough names to grow the lock-free index several times
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 5000; i++) {
+        ids.push_back(LispSymbols::intern("grown-" + std::to_string(i)));
+    }
+    for (int i = 0; i < 5000; i++) {
+        const std::string name = "grown-" + std::to_string(i);
+        assert(LispSymbols::intern(name) == ids[i]);
+        assert(LispSymbols::name(ids[i]) == name);
+    }
+    assert(LispSymbols::intern("counter") == counter);
+    std::cout << "  ✓ Ids hold as the table grows" << '\n';
+
+    assert(a[0]->symbol_id() == LispSymbols::LET);
+    assert(a[2]->as_list()[0]->symbol_id() == LispSymbols::ADD);
+    assert(b[0]->symbol_id() == LispSymbols::SET);
+    assert(LispSymbols::intern("define-func") == LispSymbols::DEFINE_FUNC);
+    std::cout << "  ✓ Special forms have their fixed ids" << '\n';
+
+    ASTArena arena;
+    auto copy = arena.copy_tree(b[1]);
+    assert(copy->symbol_id() == counter && copy->as_symbol() == "counter");
+    std::cout << "  ✓ Copied trees keep symbol ids" << '\n';
+}
+
 int main() {
     std::cout << "=== Parser Basic Tests ===" << '\n';
 
@@ -236,6 +323,12 @@ int main() {
         std::cout << '\n';
 
         test_parse_multiple_expressions();
+        std::cout << '\n';
+
+        test_arena_nodes();
+        std::cout << '\n';
+
+        test_symbol_interning();
 
         std::cout << "\n✓ All parser basic tests passed!" << '\n';
         return 0;
@@ -0,0 +1,85 @@
+#include "../src/lisp_parser.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+// Parses every .lisp file under a directory (lisp/ by default) repeatedly and
+// reports the best pass. Files that do not parse are listed and left out.
+
+static constexpr int PASSES = 50;
+
+struct Source {
+    std::string path;
+    std::string text;
+};
+
+static std::vector<Source> load_corpus(const std::string& root) {
+    std::vector<Source> corpus;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".lisp") {
+            continue;
+        }
+        std::ifstream file(entry.path());
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        corpus.push_back({entry.path().string(), buffer.str()});
+    }
+    std::sort(corpus.begin(), corpus.end(),
+              [](const Source& a, const Source& b) { return a.path < b.path; });
+    return corpus;
+}
+
+int main(int argc, char** argv) {
+    const std::string root = argc > 1 ? argv[1] : "lisp";
+    std::cout << "=== Parser Benchmark ===" << '\n';
+
+    std::vector<Source> corpus;
+    for (Source& source : load_corpus(root)) {
+        try {
+            LispParser parser(source.text);
+            parser.parse_all();
+            corpus.push_back(std::move(source));
+        } catch (const std::exception& e) {
+            std::cout << "Skipping " << source.path << ": " << e.what() << '\n';
+        }
+    }
+    if (corpus.empty()) {
+        std::cerr << "No parseable .lisp files under " << root << '\n';
+        return 1;
+    }
+
+    size_t bytes = 0;
+    size_t forms = 0;
+    size_t arena_bytes = 0;
+    for (const Source& source : corpus) {
+        LispParser parser(source.text);
+        forms += parser.parse_all().size();
+        bytes += source.text.size();
+        arena_bytes += parser.nodes().bytes_used();
+    }
+
+    auto best = duration<double, std::milli>::max();
+    for (int pass = 0; pass < PASSES; pass++) {
+        const auto start = steady_clock::now();
+        for (const Source& source : corpus) {
+            LispParser parser(source.text);
+            parser.parse_all();
+        }
+        best = std::min(best, duration<double, std::milli>(steady_clock::now() - start));
+    }
+
+    std::cout << "Files:      " << corpus.size() << " (" << bytes / 1024 << " KiB, " << forms
+              << " top-level forms)" << '\n';
+    std::cout << "Arena:      " << arena_bytes / 1024 << " KiB" << '\n';
+    std::cout << "Best pass:  " << best.count() << " ms of " << PASSES << '\n';
+    std::cout << "Throughput: " << (static_cast<double>(bytes) / 1e6) / (best.count() / 1e3)
+              << " MB/s" << '\n';
+    return 0;
+}
@@ -96,6 +96,26 @@ void test_invalid_number() {
     std::cout << "  ✓ Lone minus sign handled (likely as symbol)" << '\n';
 }
 
+void test_number_range() {
+    std::cout << "Testing number range..." << '\n';
+
+    assert(LispParser("9223372036854775807").parse()->as_number() == INT64_MAX);
+    assert(LispParser("16r7FFFFFFFFFFFFFFF").parse()->as_number() == INT64_MAX);
+    std::cout << "  ✓ Largest int64 parses in decimal and radix notation" << '\n';
+
+    for (const char* code : {"9223372036854775808", "16r10000000000000000", "99999999999r1"}) {
+        bool caught = false;
+        try {
+            LispParser parser(code);
+            parser.parse();
+        } catch (const std::runtime_error& e) {
+            caught = true;
+        }
+        assert(caught);
+    }
+    std::cout << "  ✓ Out-of-range numbers and radixes are errors" << '\n';
+}
+
 void test_nested_unclosed() {
     std::cout << "Testing nested unclosed structures..." << '\n';
 
@@ -144,7 +164,7 @@ void test_mismatched_delimiters() {
     bool caught = false;
     try {
         LispParser parser("(+ 1 2))");
-        auto node = parser.parse();
+        parser.parse();
         // Try to parse the extra )
         parser.parse();
     } catch (const std::runtime_error& e) {
@@ -196,6 +216,9 @@ int main() {
         test_invalid_number();
         std::cout << '\n';
 
+        test_number_range();
+        std::cout << '\n';
+
         test_nested_unclosed();
         std::cout << '\n';
 
@@ -0,0 +1,156 @@
+#include "../src/lisp_parser.hpp"
+#include "../src/lisp_reader.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// A temporary file holding source, rewound for reading
+class SourceFile {
+  public:
+    explicit SourceFile(const std::string& source) : file(std::tmpfile()) {
+        assert(file != nullptr);
+        std::fwrite(source.data(), 1, source.size(), file);
+        std::fflush(file);
+        std::rewind(file);
+    }
+    ~SourceFile() {
+        std::fclose(file);
+    }
+    SourceFile(const SourceFile&) = delete;
+    SourceFile& operator=(const SourceFile&) = delete;
+
+    [[nodiscard]] int fd() const {
+        return fileno(file);
+    }
+
+  private:
+    FILE* file;
+};
+
+static bool same_tree(ASTNodePtr a, ASTNodePtr b) {
+    if (a->type != b->type) {
+        return false;
+    }
+    switch (a->type) {
+        case NodeType::NUMBER:
+            return a->as_number() == b->as_number();
+        case NodeType::SYMBOL:
+            return a->as_symbol() == b->as_symbol();
+        case NodeType::STRING:
+            return a->as_string() == b->as_string();
+        case NodeType::LIST: {
+            const ASTList as = a->as_list();
+            const ASTList bs = b->as_list();
+            if (as.size() != bs.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < as.size(); i++) {
+                if (!same_tree(as[i], bs[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// Every form the reader yields must match parse_all over the whole source
+static void check_stream(const std::string& source, size_t chunk_size) {
+    LispParser whole(source);
+    const std::vector<ASTNodePtr> expected = whole.parse_all();
+
+    SourceFile file(source);
+    LispReader reader(file.fd(), chunk_size);
+    for (ASTNodePtr form : expected) {
+        ASTNodePtr streamed = reader.next();
+        assert(streamed != nullptr);
+        assert(same_tree(streamed, form));
+    }
+    assert(reader.next() == nullptr);
+    assert(reader.next() == nullptr);
+}
+
+static bool stream_throws(const std::string& source) {
+    SourceFile file(source);
+    LispReader reader(file.fd(), 3);
+    try {
+        while (reader.next() != nullptr) {
+        }
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+void test_forms_across_chunks() {
+    std::cout << "Testing forms split across chunk boundaries..." << '\n';
+
+    const std::string source = "; leading comment\n"
+                               "(define-var x 42) ; trailing comment\n"
+                               "(print-string \"a ) ( ; \\\" b\")\n"
+                               "\"top-level string\" 16rFF -7 symbol 12abc\n"
+                               "(do (if (< x 10)\n  (+ x 1) ; nested comment )\n  (- x 1)))\n"
+                               "last";
+    for (size_t chunk = 1; chunk <= 32; chunk++) {
+        check_stream(source, chunk);
+    }
+    check_stream(source, LispReader::DEFAULT_CHUNK_SIZE);
+    std::cout << "  ✓ Same forms as parse_all for every chunk size from 1 to 32" << '\n';
+
+    check_stream("", 4);
+    check_stream("  \n\t ; only a comment", 4);
+    std::cout << "  ✓ Empty and comment-only input yield no forms" << '\n';
+}
+
+void test_bounded_buffer() {
+    std::cout << "Testing buffered bytes stay bounded..." << '\n';
+
+    std::string source;
+    for (int i = 0; i < 5000; i++) {
+        source += "(+ " + std::to_string(i) + " 1) ; comment\n";
+    }
+
+    const size_t chunk = 256;
+    SourceFile file(source);
+    LispReader reader(file.fd(), chunk);
+    size_t forms = 0;
+    size_t most = 0;
+    while (reader.next() != nullptr) {
+        forms++;
+        most = std::max(most, reader.buffered());
+    }
+    assert(forms == 5000);
+    assert(most <= chunk + 32);
+    std::cout << "  ✓ " << source.size() << " bytes read holding at most " << most << " at once"
+              << '\n';
+}
+
+void test_errors() {
+    std::cout << "Testing malformed streams..." << '\n';
+
+    assert(stream_throws("(+ 1 2) (+ 3"));
+    assert(stream_throws("(print-string \"unterminated)"));
+    assert(stream_throws("(+ 1 2))"));
+    assert(!stream_throws("(+ 1 2) 3"));
+    std::cout << "  ✓ Unclosed lists and strings and a stray ')' are errors" << '\n';
+}
+
+int main() {
+    std::cout << "=== Streaming Parser Tests ===" << '\n';
+
+    try {
+        test_forms_across_chunks();
+        test_bounded_buffer();
+        test_errors();
+
+        std::cout << "\n✓ All streaming parser tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
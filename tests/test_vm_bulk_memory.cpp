@@ -0,0 +1,194 @@
+#include "../src/memory_layout.hpp"
+#include "../src/stack_vm.hpp"
+#include "vm_test_helpers.hpp"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static constexpr uint64_t SRC = MemoryLayout::HEAP_START + 100;
+static constexpr uint64_t DST = MemoryLayout::HEAP_START + 200;
+
+// Program: PUSH a, PUSH b, PUSH count, <o>, HALT
+static uint64_t run(StackVM& vm, Opcode o, uint64_t a, uint64_t b, uint64_t count) {
+    vm.reset();
+    vm.load_program(std::vector<uint64_t>{op(Opcode::PUSH), a, op(Opcode::PUSH), b,
+                                          op(Opcode::PUSH), count, op(o), op(Opcode::HALT)});
+    vm.execute();
+    return vm.get_top();
+}
+
+static uint8_t byte_at(StackVM& vm, uint64_t byte_addr) {
+    return (vm.read_memory(byte_addr / 8) >> ((byte_addr % 8) * 8)) & 0xFF;
+}
+
+void test_word_ops() {
+    std::cout << "Testing word MEMCPY/MEMMOVE/MEMSET/MEMCMP..." << '\n';
+
+    StackVM vm;
+    for (uint64_t i = 0; i < 10; i++) {
+        vm.write_memory(SRC + i, i + 1);
+    }
+
+    assert(run(vm, Opcode::MEMCPY, DST, SRC, 10) == DST);
+    for (uint64_t i = 0; i < 10; i++) {
+        assert(vm.read_memory(DST + i) == i + 1);
+    }
+    assert(vm.read_memory(DST + 10) == 0);
+    std::cout << "  ✓ MEMCPY copies words and answers dst" << '\n';
+
+    run(vm, Opcode::MEMMOVE, DST + 2, DST, 8);
+    assert(vm.read_memory(DST + 2) == 1 && vm.read_memory(DST + 9) == 8);
+    run(vm, Opcode::MEMMOVE, DST, DST + 2, 8);
+    assert(vm.read_memory(DST) == 1 && vm.read_memory(DST + 7) == 8);
+    std::cout << "  ✓ MEMMOVE handles overlap in both directions" << '\n';
+
+    run(vm, Opcode::MEMSET, DST, 0xDEADBEEF, 5);
+    assert(vm.read_memory(DST + 4) == 0xDEADBEEF && vm.read_memory(DST + 5) == 6);
+    run(vm, Opcode::MEMSET, DST, 0, 5);
+    assert(vm.read_memory(DST) == 0 && vm.read_memory(DST + 4) == 0);
+    std::cout << "  ✓ MEMSET fills whole words" << '\n';
+
+    run(vm, Opcode::MEMCPY, DST, SRC, 10);
+    assert(run(vm, Opcode::MEMCMP, DST, SRC, 10) == 0);
+    vm.write_memory(DST + 6, 1000);
+    assert(run(vm, Opcode::MEMCMP, DST, SRC, 10) == 1);
+    assert(static_cast<int64_t>(run(vm, Opcode::MEMCMP, SRC, DST, 10)) == -1);
+    assert(run(vm, Opcode::MEMCMP, SRC, DST, 6) == 0);
+    // Words compare numerically, not by their little-endian bytes
+    vm.write_memory(SRC, 0x100);
+    vm.write_memory(DST, 0x001);
+    assert(run(vm, Opcode::MEMCMP, SRC, DST, 1) == 1);
+    std::cout << "  ✓ MEMCMP orders by the first differing word" << '\n';
+}
+
+void test_byte_ops() {
+    std::cout << "Testing byte MEMCPY_BYTE/MEMMOVE_BYTE/MEMSET_BYTE/MEMCMP_BYTE..." << '\n';
+
+    StackVM vm;
+    vm.write_memory(SRC, 0x0807060504030201ULL);
+    vm.write_memory(SRC + 1, 0x100F0E0D0C0B0A09ULL);
+    vm.write_memory(DST, 0xFFFFFFFFFFFFFFFFULL);
+    vm.write_memory(DST + 1, 0xFFFFFFFFFFFFFFFFULL);
+
+    run(vm, Opcode::MEMCPY_BYTE, (DST * 8) + 3, (SRC * 8) + 1, 9);
+    assert(byte_at(vm, (DST * 8) + 2) == 0xFF);
+    assert(byte_at(vm, (DST * 8) + 3) == 0x02);
+    assert(byte_at(vm, (DST * 8) + 11) == 0x0A);
+    assert(byte_at(vm, (DST * 8) + 12) == 0xFF);
+    std::cout << "  ✓ MEMCPY_BYTE copies across word boundaries at any alignment" << '\n';
+
+    run(vm, Opcode::MEMMOVE_BYTE, (SRC * 8) + 1, SRC * 8, 4);
+    assert(vm.read_memory(SRC) == 0x0807060403020101ULL);
+    std::cout << "  ✓ MEMMOVE_BYTE handles overlap" << '\n';
+
+    run(vm, Opcode::MEMSET_BYTE, (DST * 8) + 1, 0x1AB, 3);
+    assert(vm.read_memory(DST) == 0x06050403ABABABFFULL);
+    std::cout << "  ✓ MEMSET_BYTE uses the low byte of value" << '\n';
+
+    assert(run(vm, Opcode::MEMCMP_BYTE, (DST * 8) + 1, (DST * 8) + 2, 2) == 0);
+    assert(run(vm, Opcode::MEMCMP_BYTE, DST * 8, (DST * 8) + 1, 1) == 1);
+    assert(static_cast<int64_t>(run(vm, Opcode::MEMCMP_BYTE, (DST * 8) + 1, DST * 8, 1)) == -1);
+    std::cout << "  ✓ MEMCMP_BYTE compares unsigned bytes" << '\n';
+}
+
+void test_checks() {
+    std::cout << "Testing bulk memory checks..." << '\n';
+
+    StackVM vm;
+    bool threw = false;
+    try {
+        run(vm, Opcode::MEMCPY, DST + 1, DST, 4);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ MEMCPY rejects overlapping ranges" << '\n';
+
+    if constexpr (!VMChecks::BOUNDS_CHECKS_ENABLED) {
+        std::cout << "  - range checks skipped (bounds checks disabled)" << '\n';
+        return;
+    }
+
+    threw = false;
+    try {
+        run(vm, Opcode::MEMSET, 100, 0, 4);
+    } catch (const VMException::CodeSegmentProtection&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        run(vm, Opcode::MEMCPY, MemoryLayout::MEMORY_SIZE - 2, SRC, 4);
+    } catch (const VMException::MemoryBounds&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        run(vm, Opcode::MEMCMP, SRC, DST, UINT64_MAX);
+    } catch (const VMException::MemoryBounds&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(run(vm, Opcode::MEMSET, 100, 0, 0) == 100);
+    std::cout << "  ✓ Whole ranges are checked once; empty ranges are no-ops" << '\n';
+}
+
+void test_lisp_intrinsics() {
+    std::cout << "Testing Lisp mem-* intrinsics..." << '\n';
+
+    assert(run_lisp("(do"
+                    "  (define-var a 268435556)"
+                    "  (define-var b 268435656)"
+                    "  (for (i 0 8) (poke (+ a i) (* i i)))"
+                    "  (mem-copy b a 8)"
+                    "  (+ (peek (+ b 7)) (mem-compare a b 8)))") == 49);
+    assert(run_lisp("(do"
+                    "  (define-var a 268435556)"
+                    "  (mem-set a 7 4)"
+                    "  (mem-move (+ a 1) a 4)"
+                    "  (+ (peek (+ a 4)) (mem-compare a (+ a 1) 3)))") == 7);
+    assert(run_lisp("(do"
+                    "  (define-var s \"hello world\")"
+                    "  (define-var t \"hello there\")"
+                    "  (mem-compare-bytes (* (+ s 1) 8) (* (+ t 1) 8) 6))") == 0);
+    assert(run_lisp("(do"
+                    "  (define-var s \"hello world\")"
+                    "  (define-var t \"hello there\")"
+                    "  (mem-compare-bytes (* (+ s 1) 8) (* (+ t 1) 8) 7))") == 1);
+    assert(run_lisp("(do"
+                    "  (define-var buf (* 268435556 8))"
+                    "  (mem-set-bytes buf 65 3)"
+                    "  (mem-copy-bytes (+ buf 3) buf 3)"
+                    "  (mem-move-bytes (+ buf 1) buf 6)"
+                    "  (peek-byte (+ buf 6)))") == 65);
+    std::cout << "  ✓ mem-copy, mem-move, mem-set, mem-compare and the -bytes forms" << '\n';
+
+    bool threw = false;
+    try {
+        run_lisp("(mem-copy 1 2)");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ Wrong argument count is a compile error" << '\n';
+}
+
+int main() {
+    std::cout << "=== VM Bulk Memory Tests ===" << '\n';
+
+    try {
+        test_word_ops();
+        test_byte_ops();
+        test_checks();
+        test_lisp_intrinsics();
+
+        std::cout << "\n✓ All bulk memory tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
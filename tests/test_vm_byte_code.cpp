@@ -0,0 +1,271 @@
+#include "../src/byte_code.hpp"
+#include "../src/disassembler.hpp"
+#include "../src/lisp_compiler.hpp"
+#include "../src/lisp_parser.hpp"
+#include "../src/send_cache.hpp"
+#include "../src/stack_vm.hpp"
+#include "vm_test_helpers.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static uint8_t byte(Opcode o) {
+    return static_cast<uint8_t>(o);
+}
+
+static bool encode_fails(const std::vector<uint64_t>& words,
+                         const std::vector<size_t>& code_refs = {}) {
+    try {
+        ByteCode::encode(words, code_refs);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+void test_immediates() {
+    std::cout << "Testing immediates..." << '\n';
+
+    const uint64_t values[] = {0, 1, 63, 64, 8191, 8192, static_cast<uint64_t>(-1),
+                               static_cast<uint64_t>(-64), static_cast<uint64_t>(-65),
+                               uint64_t{1} << 62, uint64_t{1} << 63, UINT64_MAX >> 1};
+    for (uint64_t value : values) {
+        for (size_t min_size : {size_t{1}, size_t{4}, ByteCode::MAX_IMMEDIATE_SIZE}) {
+            std::vector<uint8_t> out;
+            ByteCode::write_immediate(out, value, min_size);
+            assert(out.size() == std::max(ByteCode::immediate_size(value), min_size));
+            uint64_t pc = 0;
+            assert(ByteCode::read_immediate(out.data(), pc) == value);
+            assert(pc == out.size());
+        }
+    }
+    std::cout << "  ✓ Values read back as written, padded or not" << '\n';
+
+    assert(ByteCode::immediate_size(63) == 1);
+    assert(ByteCode::immediate_size(64) == 2);
+    assert(ByteCode::immediate_size(static_cast<uint64_t>(-64)) == 1);
+    assert(ByteCode::immediate_size(static_cast<uint64_t>(-65)) == 2);
+    assert(ByteCode::immediate_size(MemoryLayout::GLOBALS_START) == 5);
+    assert(ByteCode::immediate_size(uint64_t{1} << 63) == ByteCode::MAX_IMMEDIATE_SIZE);
+    std::cout << "  ✓ Small values of either sign take one byte" << '\n';
+}
+
+void test_encode() {
+    std::cout << "Testing conversion from word code..." << '\n';
+
+    const std::vector<uint64_t> words = {
+        op(Opcode::PUSH), 2,  // 0
+        op(Opcode::CALL), 6,  // 2
+        op(Opcode::HALT),     // 4
+        FunctionHeader::make(1, 0),
+        op(Opcode::PUSH), 1,  // 6: the argument, past the return address
+        op(Opcode::BP_LOAD),
+        op(Opcode::PUSH), 40,
+        op(Opcode::ADD),
+        op(Opcode::RET),
+    };
+    const std::vector<uint8_t> code = ByteCode::encode(words);
+    const std::vector<uint8_t> expected = {
+        byte(Opcode::PUSH),    2,  byte(Opcode::CALL), 10, byte(Opcode::HALT),
+        byte(Opcode::FUNCTION), 1, 0, 0, 0,
+        byte(Opcode::PUSH),    1,  byte(Opcode::BP_LOAD), byte(Opcode::PUSH), 40,
+        byte(Opcode::ADD),     byte(Opcode::RET),
+    };
+    assert(code == expected);
+    std::cout << "  ✓ " << words.size() * 8 << " bytes of word code take " << code.size() << '\n';
+
+    StackVM vm;
+    vm.load_byte_program(code);
+    vm.execute_byte_code();
+    assert(vm.get_top() == 42);
+    assert(vm.get_ip() == 5);
+    std::cout << "  ✓ The byte loop calls through the header and returns" << '\n';
+
+    // The jump spans more than 8191 bytes, so its target takes three bytes
+    // where the first layout gave it one
+    std::vector<uint64_t> far = {op(Opcode::JMP), 0};
+    for (int i = 0; i < 5000; i++) {
+        far.insert(far.end(), {op(Opcode::PUSH), 1, op(Opcode::POP)});
+    }
+    far[1] = far.size();
+    far.insert(far.end(), {op(Opcode::PUSH), 7, op(Opcode::HALT)});
+    const std::vector<uint8_t> far_code = ByteCode::encode(far);
+    uint64_t pc = 1;
+    const uint64_t target = ByteCode::read_immediate(far_code.data(), pc);
+    assert(pc == 4 && target == 4 + (5000 * 3));
+    assert(far_code[target] == byte(Opcode::PUSH));
+
+    StackVM far_vm;
+    far_vm.load_byte_program(far_code);
+    far_vm.execute_byte_code();
+    assert(far_vm.get_top() == 7);
+    std::cout << "  ✓ Code addresses grow until the layout settles" << '\n';
+
+    assert(encode_fails({op(Opcode::JMP), 1, op(Opcode::HALT)}));
+    assert(encode_fails({op(Opcode::CALL), 100, op(Opcode::HALT)}));
+    assert(encode_fails({op(Opcode::PUSH), 1, 1000}));
+    assert(encode_fails({op(Opcode::PUSH)}));
+    assert(encode_fails({op(Opcode::PUSH), 1, op(Opcode::HALT)}, {0}));
+    std::cout << "  ✓ Bad targets, stray words and truncated code are rejected" << '\n';
+}
+
+void test_compiled_programs() {
+    std::cout << "Testing compiled programs..." << '\n';
+
+    const char* sources[] = {
+        "(+ 1 2)",
+        "(do (define-func (fib n) (if (< n 2) n (+ (fib (- n 1)) (fib (- n 2))))) (fib 15))",
+        "(do (define-var total 0) (for (i 0 100) (set total (+ total i))) total)",
+        "(do (define-func (add3 a b c) (let ((s (+ a b))) (+ s c)))"
+        "    (funcall (function-address add3) 1 20 300))",
+        "(do (define-var s \"hello\") (peek s))",
+        "(- 0 12345678901)",
+    };
+    for (const char* source : sources) {
+        LispParser word_parser(source);
+        LispCompiler word_compiler;
+        StackVM word_vm;
+        word_vm.load_program(word_compiler.compile(word_parser.parse()));
+        word_vm.execute();
+
+        LispParser byte_parser(source);
+        LispCompiler byte_compiler;
+        const CompiledProgram program = byte_compiler.compile(byte_parser.parse());
+        StackVM byte_vm;
+        byte_vm.load_byte_program(program);
+        byte_vm.execute_byte_code();
+
+        assert(byte_vm.get_top() == word_vm.get_top());
+        assert(ByteCode::encode(program.bytecode, program.code_refs).size() <
+               program.bytecode.size() * 8 / 3);
+    }
+    std::cout << "  ✓ Byte code answers what word code does, in under a third of the size"
+              << '\n';
+
+    // Without the function-address word listed, FUNCALL gets a word address
+    LispParser parser("(do (define-func (f) 1) (funcall (function-address f)))");
+    LispCompiler compiler;
+    CompiledProgram program = compiler.compile(parser.parse());
+    assert(program.code_refs.size() == 1);
+    program.code_refs.clear();
+    StackVM vm;
+    vm.load_byte_program(program);
+    bool threw = false;
+    try {
+        vm.execute_byte_code();
+    } catch (const VMException::InvalidCall&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ Pushed code addresses are remapped through code_refs" << '\n';
+}
+
+// Byte code only enters its own functions, bounds checks or not: these are
+// word addresses of word code, as a Smalltalk method compiled at run time is
+static bool byte_code_call_fails(const std::vector<uint64_t>& main_code) {
+    static constexpr uint64_t METHOD = 1000;
+    static constexpr uint64_t SITE = MemoryLayout::HEAP_START + 100;
+
+    StackVM vm;
+    vm.load_program_at({FunctionHeader::make(1, 0), op(Opcode::PUSH), 111, op(Opcode::RET)},
+                       METHOD - FunctionHeader::SIZE);
+    for (size_t i = 0; i < SendSite::SIZE; i++) {
+        vm.write_memory(SITE + i, 0);
+    }
+    vm.write_memory(SITE + SendSite::entry_class(0), SendSite::SMALL_INTEGER_KEY);
+    vm.write_memory(SITE + SendSite::entry_target(0), METHOD);
+    vm.write_memory(SITE + SendSite::STATE, 1);
+
+    std::vector<uint64_t> words = main_code;
+    for (uint64_t& word : words) {
+        word = word == 0xAAAA ? SITE : word == 0xBBBB ? METHOD : word;
+    }
+    vm.load_byte_program(ByteCode::encode(words), 16384);
+    vm.set_ip(16384);
+    try {
+        vm.execute_byte_code();
+    } catch (const VMException::InvalidCall&) {
+        return true;
+    }
+    return false;
+}
+
+void test_word_code_targets() {
+    std::cout << "Testing calls from byte code into word code..." << '\n';
+
+    assert(byte_code_call_fails({op(Opcode::PUSH), 7, op(Opcode::SEND_CACHED), 0xAAAA,
+                                 op(Opcode::HALT)}));
+    std::cout << "  ✓ A send that hits a word-code method is rejected" << '\n';
+
+    assert(byte_code_call_fails({op(Opcode::PUSH), 7, op(Opcode::PUSH), 1, op(Opcode::PUSH),
+                                 0xBBBB, op(Opcode::FUNCALL), op(Opcode::HALT)}));
+    std::cout << "  ✓ So is a FUNCALL of a word-code address" << '\n';
+}
+
+void test_send_error_address() {
+    std::cout << "Testing errors in byte code sends..." << '\n';
+
+    static constexpr uint64_t SITE = MemoryLayout::HEAP_START + 100;
+    StackVM vm;
+    for (size_t i = 0; i < SendSite::SIZE; i++) {
+        vm.write_memory(SITE + i, 0);
+    }
+    vm.write_memory(SITE + SendSite::entry_class(0), SendSite::SMALL_INTEGER_KEY);
+    vm.write_memory(SITE + SendSite::entry_target(0), UINT64_MAX >> 1);
+    vm.write_memory(SITE + SendSite::STATE, 1);
+
+    // The site address takes several bytes, so ip - 2 would be inside it
+    vm.load_byte_program(
+        ByteCode::encode({op(Opcode::PUSH), 7, op(Opcode::SEND_CACHED), SITE, op(Opcode::HALT)}),
+        16384);
+    vm.set_ip(16384);
+    bool threw = false;
+    try {
+        vm.execute_byte_code();
+    } catch (const VMException::InvalidAddress& e) {
+        assert(e.get_ip() == 16384 + 2);
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ A bad send target is reported at the SEND_CACHED" << '\n';
+}
+
+void test_disassemble() {
+    std::cout << "Testing the disassembler..." << '\n';
+
+    const std::vector<uint64_t> words = {
+        op(Opcode::CALL), 4, op(Opcode::HALT), FunctionHeader::make(0, 2),
+        op(Opcode::PUSH), 300, op(Opcode::RET),
+    };
+    std::ostringstream out;
+    Disassembler::disassemble_bytes(ByteCode::encode(words), out);
+    const std::string listing = out.str();
+    assert(listing.find("000000: CALL        @8") != std::string::npos);
+    assert(listing.find("000003: FUNCTION    arity 0, temporaries 2") != std::string::npos);
+    assert(listing.find("000008: PUSH        300 (0x12c)") != std::string::npos);
+    assert(listing.find("000011: RET") != std::string::npos);
+    std::cout << "  ✓ Byte code lists with byte addresses" << '\n';
+}
+
+int main() {
+    std::cout << "=== Byte Code Tests ===" << '\n';
+
+    try {
+        test_immediates();
+        test_encode();
+        test_compiled_programs();
+        test_word_code_targets();
+        test_send_error_address();
+        test_disassemble();
+
+        std::cout << "\n✓ All byte code tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,247 @@
+#include "../src/memory_layout.hpp"
+#include "../src/stack_vm.hpp"
+#include "vm_test_helpers.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Word and byte addresses of the test buffers
+static constexpr uint64_t BUFFER = MemoryLayout::HEAP_START + 100;
+static constexpr uint64_t BUFFER_BYTES = BUFFER * 8;
+static constexpr uint64_t IOV = MemoryLayout::HEAP_START + 500;
+static constexpr uint64_t MAP_BYTES = (MemoryLayout::HEAP_START + 131072) * 8; // Page aligned
+
+// Program: C_CALL func_id(args...) -> HALT
+static uint64_t c_call(StackVM& vm, uint64_t func_id, const std::vector<uint64_t>& args) {
+    std::vector<uint64_t> program;
+    for (uint64_t arg : args) {
+        program.push_back(op(Opcode::PUSH));
+        program.push_back(arg);
+    }
+    program.insert(program.end(), {op(Opcode::PUSH), args.size(), op(Opcode::PUSH), func_id,
+                                   op(Opcode::C_CALL), op(Opcode::HALT)});
+    vm.reset();
+    vm.load_program(program);
+    vm.execute();
+    return vm.get_top();
+}
+
+// Byte of VM memory at byte address addr
+static uint8_t vm_byte(StackVM& vm, uint64_t addr) {
+    return (vm.read_memory(addr / 8) >> ((addr % 8) * 8)) & 0xFF;
+}
+
+static std::string vm_bytes(StackVM& vm, uint64_t addr, size_t count) {
+    std::string s;
+    for (size_t i = 0; i < count; i++) {
+        s += static_cast<char>(vm_byte(vm, addr + i));
+    }
+    return s;
+}
+
+void test_read_write() {
+    std::cout << "Testing read/write against VM memory..." << '\n';
+
+    StackVM vm;
+    int fds[2];
+    assert(pipe(fds) == 0);
+
+    // Fill the buffer so we can check bytes around an unaligned read survive
+    for (uint64_t w = 0; w < 4; w++) {
+        vm.write_memory(BUFFER + w, 0xAAAAAAAAAAAAAAAAULL);
+    }
+    const std::string text = "hello, world!";
+    assert(write(fds[1], text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+    assert(c_call(vm, 0, {static_cast<uint64_t>(fds[0]), BUFFER_BYTES + 3, 64}) == text.size());
+    assert(vm_bytes(vm, BUFFER_BYTES + 3, text.size()) == text);
+    assert(vm_byte(vm, BUFFER_BYTES + 2) == 0xAA);
+    assert(vm_byte(vm, BUFFER_BYTES + 3 + text.size()) == 0xAA);
+    std::cout << "  ✓ read lands at an unaligned byte address, neighbours untouched" << '\n';
+
+    assert(c_call(vm, 1, {static_cast<uint64_t>(fds[1]), BUFFER_BYTES + 10, 6}) == 6);
+    char out[6];
+    assert(read(fds[0], out, sizeof(out)) == 6);
+    assert(std::string(out, 6) == "world!");
+    std::cout << "  ✓ write sends bytes straight from VM memory" << '\n';
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_vectored_io() {
+    std::cout << "Testing readv/writev..." << '\n';
+
+    StackVM vm;
+    int fds[2];
+    assert(pipe(fds) == 0);
+
+    // Two buffers: 5 bytes at BUFFER, 7 bytes at BUFFER + 3 words + 1 byte
+    vm.write_memory(IOV, BUFFER_BYTES);
+    vm.write_memory(IOV + 1, 5);
+    vm.write_memory(IOV + 2, BUFFER_BYTES + 25);
+    vm.write_memory(IOV + 3, 7);
+
+    const std::string text = "abcdeFGHIJKL";
+    assert(write(fds[1], text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+    assert(c_call(vm, 6, {static_cast<uint64_t>(fds[0]), IOV, 2}) == 12);
+    assert(vm_bytes(vm, BUFFER_BYTES, 5) == "abcde");
+    assert(vm_bytes(vm, BUFFER_BYTES + 25, 7) == "FGHIJKL");
+    std::cout << "  ✓ readv scatters into several VM buffers" << '\n';
+
+    assert(c_call(vm, 7, {static_cast<uint64_t>(fds[1]), IOV, 2}) == 12);
+    char out[12];
+    assert(read(fds[0], out, sizeof(out)) == 12);
+    assert(std::string(out, 12) == text);
+    std::cout << "  ✓ writev gathers them back in order" << '\n';
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_positioned_io() {
+    std::cout << "Testing pread/pwrite..." << '\n';
+
+    StackVM vm;
+    FILE* file = tmpfile();
+    assert(file != nullptr);
+    const int fd = fileno(file);
+    const std::string text = "0123456789";
+    assert(write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+
+    assert(c_call(vm, 8, {static_cast<uint64_t>(fd), BUFFER_BYTES + 1, 4, 3}) == 4);
+    assert(vm_bytes(vm, BUFFER_BYTES + 1, 4) == "3456");
+    std::cout << "  ✓ pread reads at an offset" << '\n';
+
+    assert(c_call(vm, 9, {static_cast<uint64_t>(fd), BUFFER_BYTES + 1, 4, 0}) == 4);
+    char out[10];
+    assert(pread(fd, out, sizeof(out), 0) == 10);
+    assert(std::string(out, 10) == "3456456789");
+    assert(lseek(fd, 0, SEEK_CUR) == 10);
+    std::cout << "  ✓ pwrite writes at an offset without moving the file position" << '\n';
+
+    fclose(file);
+}
+
+void test_mmap() {
+    std::cout << "Testing mmap/munmap into the heap..." << '\n';
+
+    StackVM vm;
+    FILE* file = tmpfile();
+    assert(file != nullptr);
+    const int fd = fileno(file);
+    std::string text(10000, 'x');
+    text.replace(0, 5, "Hello");
+    text.replace(9995, 5, "World");
+    assert(write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+
+    assert(c_call(vm, 10, {static_cast<uint64_t>(fd), MAP_BYTES, 65536}) == text.size());
+    assert(vm_bytes(vm, MAP_BYTES, 5) == "Hello");
+    assert(vm_bytes(vm, MAP_BYTES + 9995, 5) == "World");
+    assert(vm_byte(vm, MAP_BYTES + 10000) == 0);
+    std::cout << "  ✓ File contents appear at the reserved address" << '\n';
+
+    vm.write_memory(MAP_BYTES / 8, 0);
+    char first[5];
+    assert(pread(fd, first, sizeof(first), 0) == 5);
+    assert(std::string(first, 5) == "Hello");
+    std::cout << "  ✓ Mapping is private: VM writes do not reach the file" << '\n';
+
+    assert(c_call(vm, 10, {static_cast<uint64_t>(fd), MAP_BYTES + 16384, 4}) == 4);
+    assert(vm_bytes(vm, MAP_BYTES + 16384, 4) == "Hell");
+    assert(vm_byte(vm, MAP_BYTES + 16384 + 4) == 0);
+    std::cout << "  ✓ max_length limits the mapped length" << '\n';
+
+    assert(c_call(vm, 11, {MAP_BYTES, 10000}) == 0);
+    assert(vm.read_memory((MAP_BYTES + 9995) / 8) == 0);
+    vm.write_memory((MAP_BYTES + 8) / 8, 42);
+    assert(vm.read_memory((MAP_BYTES + 8) / 8) == 42);
+    std::cout << "  ✓ munmap restores zeroed, writable heap" << '\n';
+
+    bool threw = false;
+    try {
+        c_call(vm, 10, {static_cast<uint64_t>(fd), MAP_BYTES + 8, 65536});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        c_call(vm, 10, {static_cast<uint64_t>(fd), MemoryLayout::GLOBALS_START * 8, 65536});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        c_call(vm, 11, {(MemoryLayout::STACK_START * 8) - 4096, 8192});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ Unaligned or non-heap ranges are rejected" << '\n';
+
+    fclose(file);
+}
+
+void test_range_checks() {
+    std::cout << "Testing buffer range checks..." << '\n';
+
+    if constexpr (!VMChecks::BOUNDS_CHECKS_ENABLED) {
+        std::cout << "  - skipped (bounds checks disabled)" << '\n';
+        return;
+    }
+
+    StackVM vm;
+    int fds[2];
+    assert(pipe(fds) == 0);
+
+    bool threw = false;
+    try {
+        c_call(vm, 0, {static_cast<uint64_t>(fds[0]), 16, 8});
+    } catch (const VMException::CodeSegmentProtection&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ read into the code segment is rejected" << '\n';
+
+    threw = false;
+    try {
+        c_call(vm, 1, {static_cast<uint64_t>(fds[1]), (MemoryLayout::MEMORY_SIZE * 8) - 4, 8});
+    } catch (const VMException::MemoryBounds&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        c_call(vm, 1, {static_cast<uint64_t>(fds[1]), BUFFER_BYTES, UINT64_MAX});
+    } catch (const VMException::MemoryBounds&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ buffers past the end of memory are rejected" << '\n';
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+int main() {
+    std::cout << "=== VM C_CALL I/O Tests ===" << '\n';
+
+    try {
+        test_read_write();
+        test_vectored_io();
+        test_positioned_io();
+        test_mmap();
+        test_range_checks();
+
+        std::cout << "\n✓ All C_CALL I/O tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
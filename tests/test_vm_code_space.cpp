@@ -0,0 +1,161 @@
+#include "../src/code_space.hpp"
+#include "../src/stack_vm.hpp"
+#include "vm_test_helpers.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+static bool has(const std::vector<uint64_t>& roots, uint64_t addr) {
+    return std::find(roots.begin(), roots.end(), addr) != roots.end();
+}
+
+void test_allocate() {
+    std::cout << "Testing block allocation..." << '\n';
+
+    CodeSpace code(100);
+    assert(code.allocate(10) == 0);
+    assert(code.allocate(20) == 10);
+    assert(code.allocate(0) == 30);
+    assert(code.get_top() == 31);
+    assert(code.used() == 31);
+    assert(code.block_count() == 3);
+    std::cout << "  ✓ Blocks are handed out from the bottom up" << '\n';
+
+    assert(code.allocate(70) == std::nullopt);
+    assert(code.allocate(69) == 31);
+    assert(code.allocate(1) == std::nullopt);
+    std::cout << "  ✓ Allocation fails once the segment is full" << '\n';
+
+    assert(code.contains(0) && code.contains(29) && code.contains(99));
+    code.clear();
+    assert(!code.contains(0) && code.get_top() == 0 && code.allocate(100) == 0);
+    std::cout << "  ✓ clear() empties the segment" << '\n';
+}
+
+void test_collect() {
+    std::cout << "Testing collection..." << '\n';
+
+    CodeSpace code(100);
+    for (uint64_t i = 0; i < 10; i++) {
+        assert(code.allocate(10) == i * 10);
+    }
+
+    // Roots anywhere inside a block keep it; 1000 is outside every block
+    assert(code.collect({0, 25, 29, 59, 1000}) == 70);
+    assert(code.block_count() == 3);
+    assert(code.contains(0) && code.contains(20) && code.contains(50));
+    assert(!code.contains(10) && !code.contains(30) && !code.contains(60));
+    assert(code.get_top() == 60);
+    assert(code.free_block_count() == 2);
+    std::cout << "  ✓ Unreferenced blocks are freed and the top comes down" << '\n';
+
+    assert(code.allocate(25) == 60);
+    assert(code.allocate(10) == 10);
+    assert(code.allocate(5) == 30);
+    assert(code.allocate(20) == std::nullopt);
+    assert(code.allocate(15) == 35);
+    std::cout << "  ✓ Freed blocks are reused lowest first" << '\n';
+
+    assert(code.collect({}) == 85);
+    assert(code.block_count() == 0);
+    assert(code.free_block_count() == 0);
+    assert(code.get_top() == 0);
+    std::cout << "  ✓ Neighbouring free blocks merge back into the top" << '\n';
+
+    const auto& stats = code.get_stats();
+    assert(stats.collections == 2);
+    assert(stats.blocks_freed == 14);
+    assert(stats.words_freed == 155);
+    std::cout << "  ✓ " << stats.blocks_freed << " blocks, " << stats.words_freed
+              << " words freed in " << stats.collections << " collections" << '\n';
+}
+
+void test_collect_traces_code() {
+    std::cout << "Testing collection through code references..." << '\n';
+
+    // f, then g calling f, then f redefined: the symbol table only roots the
+    // new f and g, but g still calls the old f
+    CodeSpace code(100);
+    const uint64_t old_f = *code.allocate(10);
+    const uint64_t g = *code.allocate(10);
+    code.set_refs(g, {old_f + FunctionHeader::SIZE});
+    const uint64_t new_f = *code.allocate(10);
+
+    assert(code.collect({g, new_f}) == 0);
+    assert(code.contains(old_f));
+    const uint64_t spare = *code.allocate(10);
+    assert(spare == new_f + 10);
+    std::cout << "  ✓ A callee stays while a live caller still calls it" << '\n';
+
+    // Only references from kept blocks count, and they are followed through
+    // chains of callers
+    code.set_refs(spare, {g + 1});
+    assert(code.collect({new_f}) == 30);
+    assert(!code.contains(old_f) && !code.contains(g) && !code.contains(spare));
+    assert(code.contains(new_f));
+    std::cout << "  ✓ Blocks only reachable from dead blocks are freed" << '\n';
+
+    const uint64_t h = *code.allocate(10);
+    assert(h == old_f);
+    code.set_refs(new_f, {h + FunctionHeader::SIZE});
+    code.set_refs(h, {new_f + 3, 1000}); // A cycle, and an address outside every block
+    assert(code.collect({new_f}) == 0);
+    assert(code.collect({}) == 20);
+    assert(code.block_count() == 0);
+    std::cout << "  ✓ References are followed transitively" << '\n';
+
+    // A freed block forgets its references
+    const uint64_t reused = *code.allocate(10);
+    assert(code.collect({reused}) == 0);
+    assert(code.block_count() == 1);
+    std::cout << "  ✓ A reused block starts without references" << '\n';
+}
+
+void test_vm_roots() {
+    std::cout << "Testing VM code roots..." << '\n';
+
+    // A function that stops inside itself: its return address is on the
+    // stack and ip is inside the function
+    StackVM vm;
+    std::vector<uint64_t> program = {
+        op(Opcode::PUSH),           40, // Not an address, but looks like one
+        op(Opcode::CALL),           6,  // Returns to 4
+        op(Opcode::HALT),
+        FunctionHeader::make(0, 0),
+        op(Opcode::HALT), // Function at 6
+    };
+    vm.load_program(program);
+    vm.execute();
+
+    const std::vector<uint64_t> roots = vm.code_roots();
+    assert(has(roots, vm.get_ip()));
+    assert(has(roots, 4));
+    assert(has(roots, 40));
+    std::cout << "  ✓ ip and code addresses on the stack are roots" << '\n';
+
+    StackVM handler_vm;
+    handler_vm.load_program({op(Opcode::PUSH), 1234, op(Opcode::PUSH), 10,
+                             op(Opcode::SIGNAL_REG), op(Opcode::HALT)});
+    handler_vm.execute();
+    assert(has(handler_vm.code_roots(), 1234));
+    std::cout << "  ✓ Signal handlers are roots" << '\n';
+}
+
+int main() {
+    std::cout << "=== Code Space Tests ===" << '\n';
+
+    try {
+        test_allocate();
+        test_collect();
+        test_collect_traces_code();
+        test_vm_roots();
+
+        std::cout << "\n✓ All code space tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
@@ -117,13 +117,14 @@ void test_call_without_args() {
     std::cout << "Testing CALL without ARGS..." << '\n';
 
     StackVM vm;
+    const uint64_t header = FunctionHeader::make(0, 0);
     std::vector<uint64_t> program = {
         static_cast<uint64_t>(Opcode::CALL),
         5,
-        0,
         static_cast<uint64_t>(Opcode::PUSH),
         10,
         // Fn 1
+        header,
         static_cast<uint64_t>(Opcode::HALT),
     };
 
@@ -131,8 +132,10 @@ void test_call_without_args() {
     const uint64_t STARTING_SP = vm.get_sp();
     vm.execute();
 
-    assert(vm.get_sp() == STARTING_SP - 1);
-    assert(vm.get_top() == 3); // First function IP
+    assert(vm.get_sp() == STARTING_SP - 2);
+    assert(vm.get_bp() == vm.get_sp());
+    assert(vm.stack_pop() == FunctionHeader::link(STARTING_SP, header));
+    assert(vm.stack_pop() == 2); // Return address
     assert(vm.get_ip() == 6);
     std::cout << "  ✓ CALL/RET: function" << '\n';
 }
@@ -150,12 +153,12 @@ void test_call_with_args() {
         static_cast<uint64_t>(Opcode::PUSH),
         16,
         static_cast<uint64_t>(Opcode::CALL),
-        11,
-        3, // IP, NB ARGS
+        11, // IP
         static_cast<uint64_t>(Opcode::PUSH),
         10,
 
         // Fn 1
+        FunctionHeader::make(3, 0),
         static_cast<uint64_t>(Opcode::HALT),
     };
 
@@ -163,11 +166,10 @@ void test_call_with_args() {
     const uint64_t STARTING_SP = vm.get_sp();
     vm.execute();
 
-    assert(vm.get_sp() == STARTING_SP - 7);
-    assert(vm.stack_pop() == 14);
-    assert(vm.stack_pop() == 15);
-    assert(vm.stack_pop() == 16);
-    assert(vm.stack_pop() == 9); // IP In FN 1
+    // The arguments stay where they were pushed, under the return address
+    assert(vm.get_sp() == STARTING_SP - 5);
+    assert(FunctionHeader::arity(vm.stack_pop()) == 3); // Link
+    assert(vm.stack_pop() == 8);                        // IP In FN 1
     assert(vm.stack_pop() == 16);
     assert(vm.stack_pop() == 15);
     assert(vm.stack_pop() == 14);
@@ -181,52 +183,54 @@ void test_call_ret_enter_leave() {
     StackVM vm;
     std::vector<uint64_t> program = {
         // Main program
-        static_cast<uint64_t>(Opcode::PUSH), 10,   // Argument
-        static_cast<uint64_t>(Opcode::CALL), 6, 1, // IP, NB_ARGS
+        static_cast<uint64_t>(Opcode::PUSH), 10, // Argument
+        static_cast<uint64_t>(Opcode::CALL), 6,  // IP
         static_cast<uint64_t>(Opcode::HALT),
 
-        // Fn 1
+        // Fn 1: ENTER nests a frame under the one CALL built
+        FunctionHeader::make(1, 0),
         static_cast<uint64_t>(Opcode::ENTER), 0, // Temps
-        static_cast<uint64_t>(Opcode::PUSH), 0, static_cast<uint64_t>(Opcode::BP_LOAD),
+        static_cast<uint64_t>(Opcode::PUSH), 2,  // Argument, past the link and return address
+        static_cast<uint64_t>(Opcode::BP_LOAD),
         static_cast<uint64_t>(Opcode::PUSH), 2, static_cast<uint64_t>(Opcode::MUL),
         static_cast<uint64_t>(Opcode::LEAVE), 0, // Temps
-        static_cast<uint64_t>(Opcode::RET), 1    // Args
-    };
+        static_cast<uint64_t>(Opcode::RET)};
 
     vm.load_program(program);
     const uint64_t STARTING_SP = vm.get_sp();
     vm.execute();
 
-    assert(vm.get_ip() == 6);
+    assert(vm.get_ip() == 5);
     assert(vm.get_sp() == STARTING_SP - 1);
+    assert(vm.get_bp() == STARTING_SP);
     assert(vm.get_top() == 20);
     std::cout << "  ✓ CALL/RET: function doubles 10 -> 20" << '\n';
 }
 
-void test_nested_calls_enter_leave() {
-    std::cout << "Testing nested function calls with ENTER and LEAVE..." << '\n';
+void test_nested_calls() {
+    std::cout << "Testing nested function calls..." << '\n';
 
     StackVM vm;
     std::vector<uint64_t> program = {
         // Main
-        static_cast<uint64_t>(Opcode::PUSH), 5,    // arg 1
-        static_cast<uint64_t>(Opcode::CALL), 6, 1, // addresse et le nombre d'arguments
+        static_cast<uint64_t>(Opcode::PUSH), 5, // arg 1
+        static_cast<uint64_t>(Opcode::CALL), 6, // addresse
         static_cast<uint64_t>(Opcode::HALT),
 
         // Fn 1
-        static_cast<uint64_t>(Opcode::ENTER), 0, // args & temps
-        static_cast<uint64_t>(Opcode::PUSH), 0,
+        FunctionHeader::make(1, 0),
+        static_cast<uint64_t>(Opcode::PUSH), 1,
         static_cast<uint64_t>(Opcode::BP_LOAD), // get argument
         static_cast<uint64_t>(Opcode::PUSH), 10, static_cast<uint64_t>(Opcode::ADD),
-        static_cast<uint64_t>(Opcode::CALL), 21, 1, static_cast<uint64_t>(Opcode::LEAVE), 0,
-        static_cast<uint64_t>(Opcode::RET), 1, // nb args to pop automatiquement
+        static_cast<uint64_t>(Opcode::CALL), 16,
+        static_cast<uint64_t>(Opcode::RET), // args popped through the header
 
         // Fn 2
-        static_cast<uint64_t>(Opcode::ENTER), 0, static_cast<uint64_t>(Opcode::PUSH), 2,
-        static_cast<uint64_t>(Opcode::PUSH), 0,
+        FunctionHeader::make(1, 0), static_cast<uint64_t>(Opcode::PUSH), 2,
+        static_cast<uint64_t>(Opcode::PUSH), 1,
         static_cast<uint64_t>(Opcode::BP_LOAD), // Push first argument
-        static_cast<uint64_t>(Opcode::MUL), static_cast<uint64_t>(Opcode::LEAVE), 0,
-        static_cast<uint64_t>(Opcode::RET), 1 // nb args to pop automatiquement
+        static_cast<uint64_t>(Opcode::MUL),
+        static_cast<uint64_t>(Opcode::RET) // args popped through the header
     };
 
     vm.load_program(program);
@@ -234,12 +238,86 @@ void test_nested_calls_enter_leave() {
     vm.execute();
 
     // (5 + 10) * 2 = 30
-    assert(vm.get_ip() == 6);
+    assert(vm.get_ip() == 5);
     assert(vm.get_sp() == STARTING_SP - 1);
     assert(vm.get_top() == 30);
     std::cout << "  ✓ Nested calls: (5 + 10) * 2 = 30" << '\n';
 }
 
+void test_frame_temporaries() {
+    std::cout << "Testing frame temporaries and arguments..." << '\n';
+
+    StackVM vm;
+    std::vector<uint64_t> program = {
+        // Main program: f(7, 9)
+        static_cast<uint64_t>(Opcode::PUSH), 7, static_cast<uint64_t>(Opcode::PUSH), 9,
+        static_cast<uint64_t>(Opcode::CALL), 8, static_cast<uint64_t>(Opcode::HALT),
+
+        // Fn 1: temp1 = temp0 + arg1 - arg0; slots are temps 0-1, the return
+        // address at 2, then the arguments, the last one nearest
+        FunctionHeader::make(2, 2),
+        static_cast<uint64_t>(Opcode::PUSH), 0, static_cast<uint64_t>(Opcode::BP_LOAD),
+        static_cast<uint64_t>(Opcode::PUSH), 3, static_cast<uint64_t>(Opcode::BP_LOAD),
+        static_cast<uint64_t>(Opcode::ADD),
+        static_cast<uint64_t>(Opcode::PUSH), 4, static_cast<uint64_t>(Opcode::BP_LOAD),
+        static_cast<uint64_t>(Opcode::SUB),
+        static_cast<uint64_t>(Opcode::PUSH), 1, static_cast<uint64_t>(Opcode::BP_STORE),
+        static_cast<uint64_t>(Opcode::PUSH), 1, static_cast<uint64_t>(Opcode::BP_LOAD),
+        static_cast<uint64_t>(Opcode::RET)};
+
+    vm.load_program(program);
+    const uint64_t STARTING_SP = vm.get_sp();
+    // Leftovers where the temporaries will go
+    vm.write_memory(STARTING_SP - 4, 77);
+    vm.write_memory(STARTING_SP - 5, 77);
+    vm.execute();
+
+    assert(vm.get_ip() == 7);
+    assert(vm.get_sp() == STARTING_SP - 1);
+    assert(vm.get_top() == 2);
+    assert(vm.get_bp() == STARTING_SP);
+    std::cout << "  ✓ Temporaries start zeroed, arguments are read in place: 0 + 9 - 7 = 2" << '\n';
+}
+
+void test_call_checks() {
+    std::cout << "Testing call target checks..." << '\n';
+
+    auto rejected = [](const std::vector<uint64_t>& program) {
+        StackVM vm;
+        vm.load_program(program);
+        try {
+            vm.execute();
+        } catch (const VMException::InvalidCall&) {
+            return true;
+        }
+        return false;
+    };
+
+    // FUNCALL targets are runtime values, so they are checked in every
+    // build: f takes 1 argument but gets 2, then a target with no header
+    assert(rejected({static_cast<uint64_t>(Opcode::PUSH), 1, static_cast<uint64_t>(Opcode::PUSH), 2,
+                     static_cast<uint64_t>(Opcode::PUSH), 2, static_cast<uint64_t>(Opcode::PUSH),
+                     10, static_cast<uint64_t>(Opcode::FUNCALL), FunctionHeader::make(1, 0),
+                     static_cast<uint64_t>(Opcode::RET)}));
+    assert(rejected({static_cast<uint64_t>(Opcode::PUSH), 0, static_cast<uint64_t>(Opcode::PUSH),
+                     7, static_cast<uint64_t>(Opcode::FUNCALL),
+                     static_cast<uint64_t>(Opcode::HALT), static_cast<uint64_t>(Opcode::PUSH),
+                     65535, static_cast<uint64_t>(Opcode::RET)}));
+    assert(rejected({static_cast<uint64_t>(Opcode::PUSH), 0, static_cast<uint64_t>(Opcode::PUSH),
+                     0, static_cast<uint64_t>(Opcode::FUNCALL),
+                     static_cast<uint64_t>(Opcode::HALT)}));
+    std::cout << "  ✓ FUNCALL with a wrong argument count or no header is rejected" << '\n';
+
+#if MICRO_TALK_BOUNDS_CHECKS
+    // CALL into code with no header; the compiler checks CALL arities
+    assert(rejected({static_cast<uint64_t>(Opcode::CALL), 3, static_cast<uint64_t>(Opcode::HALT),
+                     static_cast<uint64_t>(Opcode::HALT)}));
+    std::cout << "  ✓ CALL targets without a header are rejected" << '\n';
+#else
+    std::cout << "  ⊘ CALL target checks skipped (bounds checking disabled)" << '\n';
+#endif
+}
+
 void test_jump_bounds_check() {
     std::cout << "Testing jump bounds checking..." << '\n';
 
@@ -283,7 +361,9 @@ int main() {
         test_call_without_args();
         test_call_with_args();
         test_call_ret_enter_leave();
-        test_nested_calls_enter_leave();
+        test_nested_calls();
+        test_frame_temporaries();
+        test_call_checks();
 
         std::cout << "\n✓ All control flow tests passed!" << '\n';
         return 0;
@@ -0,0 +1,168 @@
+#include "../src/intern_table.hpp"
+#include "../src/memory_layout.hpp"
+#include "../src/stack_vm.hpp"
+#include "vm_test_helpers.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+static constexpr uint64_t STRING = MemoryLayout::HEAP_START + 100;
+
+// Program: INTERN (str, start, len, id) -> HALT
+static std::vector<uint64_t> intern_program(uint64_t str, uint64_t start, uint64_t len,
+                                            uint64_t id) {
+    return {op(Opcode::PUSH), str, op(Opcode::PUSH), start, op(Opcode::PUSH), len,
+            op(Opcode::PUSH), id,  op(Opcode::INTERN),    op(Opcode::HALT)};
+}
+
+// Runs one INTERN on the shared test string; the intern table survives reset()
+static uint64_t run_intern(StackVM& vm, uint64_t start, uint64_t len, uint64_t id = 0) {
+    vm.reset();
+    vm.load_program(intern_program(STRING, start, len, id));
+    vm.execute();
+    return vm.get_top();
+}
+
+void test_table_basics() {
+    std::cout << "Testing InternTable intern/lookup..." << '\n';
+
+    InternTable table;
+    assert(table.lookup("at:put:") == InternTable::NO_ID);
+    assert(table.intern("at:put:") == 1);
+    assert(table.intern("size") == 2);
+    assert(table.intern("at:put:") == 1);
+    assert(table.lookup("size") == 2);
+    assert(table.name(1) == "at:put:");
+    assert(table.name(99).empty());
+    assert(table.size() == 2);
+    std::cout << "  ✓ Ids are sequential and stable" << '\n';
+}
+
+void test_table_growth() {
+    std::cout << "Testing InternTable growth..." << '\n';
+
+    InternTable table;
+    const size_t initial_capacity = table.capacity();
+    for (int i = 0; i < 20000; i++) {
+        assert(table.intern("sel" + std::to_string(i) + ":") == static_cast<uint64_t>(i + 1));
+    }
+    assert(table.size() == 20000);
+    assert(table.capacity() > initial_capacity);
+    assert(table.size() * 8 <= table.capacity() * 7);
+    for (int i = 0; i < 20000; i += 7) {
+        assert(table.lookup("sel" + std::to_string(i) + ":") == static_cast<uint64_t>(i + 1));
+    }
+    assert(table.lookup("sel20000:") == InternTable::NO_ID);
+    std::cout << "  ✓ 20000 selectors, no hard cap, load stays under 7/8" << '\n';
+}
+
+void test_table_preload() {
+    std::cout << "Testing InternTable preload..." << '\n';
+
+    InternTable table;
+    assert(table.preload(50, {"+", "-", "*", "/"}));
+    assert(table.lookup("-") == 51);
+    assert(table.preload(10, {"class"}));
+    assert(table.intern("new:") == 54);
+    assert(table.intern_as("+", 50) == 50);
+    assert(table.intern_as("+", 60) == InternTable::NO_ID);
+    assert(table.intern_as("other", 10) == InternTable::NO_ID);
+    assert(!table.preload(51, {"minus"}));
+    assert(table.intern_as("far", table.next_id() + InternTable::MAX_ID_GAP + 1) ==
+           InternTable::NO_ID);
+
+    table.clear();
+    assert(table.size() == 0);
+    assert(table.intern("+") == 1);
+    std::cout << "  ✓ Fixed ids, conflicts rejected, sequential ids continue above" << '\n';
+}
+
+void test_intern_opcode() {
+    std::cout << "Testing INTERN opcode..." << '\n';
+
+    StackVM vm;
+    write_string(vm, STRING, "3 between: 1 and: 5 printString");
+
+    const uint64_t between = run_intern(vm, 2, 8); // "between:"
+    assert(between == ((1 << 1) | 1));
+    assert(run_intern(vm, 13, 4) == ((2 << 1) | 1)); // "and:"
+    assert(run_intern(vm, 2, 8) == between);
+    assert(run_intern(vm, 20, 11) == ((3 << 1) | 1)); // "printString" crosses a word
+    assert(vm.get_selectors().name(3) == "printString");
+    std::cout << "  ✓ Slices are interned in place and answer tagged ids" << '\n';
+
+    assert(run_intern(vm, 0, 1, 40) == ((40 << 1) | 1));
+    assert(vm.get_selectors().name(40) == "3");
+    assert(run_intern(vm, 15, 1) == ((41 << 1) | 1)); // "d" continues after 40
+    std::cout << "  ✓ Nonzero id preloads at that id" << '\n';
+
+    bool threw = false;
+    try {
+        run_intern(vm, 2, 8, 7);
+    } catch (const VMException::InvalidSymbol&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ Conflicting preload raises InvalidSymbol" << '\n';
+
+    const uint64_t next = vm.get_selectors().next_id();
+    for (const uint64_t id : {next + InternTable::MAX_ID_GAP + 1, uint64_t{1} << 62}) {
+        threw = false;
+        try {
+            run_intern(vm, 20, 11, id);
+        } catch (const VMException::InvalidSymbol& e) {
+            assert(e.get_id() == id);
+            threw = true;
+        }
+        assert(threw);
+    }
+    assert(vm.get_selectors().next_id() == next);
+    assert(run_intern(vm, 24, 3, next + InternTable::MAX_ID_GAP) ==
+           (((next + InternTable::MAX_ID_GAP) << 1) | 1));
+    std::cout << "  ✓ Ids far above the next one raise InvalidSymbol" << '\n';
+
+    // "3 between: 1 and: 5 printString" is 31 bytes; start + length wraps
+    // for the last slice
+    const size_t symbols = vm.get_selectors().size();
+    for (const auto& [start, len] : {std::pair<uint64_t, uint64_t>{32, 0}, {20, 12},
+                                     {uint64_t{1} << 63, uint64_t{1} << 63}}) {
+        threw = false;
+        try {
+            run_intern(vm, start, len);
+        } catch (const std::runtime_error& e) {
+            assert(std::string(e.what()).find("INTERN") != std::string::npos);
+            threw = true;
+        }
+        assert(threw);
+    }
+    assert(vm.get_selectors().size() == symbols);
+    assert(run_intern(vm, 31, 0) == run_intern(vm, 0, 0));
+    std::cout << "  ✓ Slices outside the string are rejected" << '\n';
+
+    vm.reset();
+    vm.load_program(intern_program(0, 0, 0, 0));
+    vm.execute();
+    assert(vm.get_top() == 0);
+    assert(vm.get_selectors().size() == 0);
+    assert(run_intern(vm, 13, 4) == ((1 << 1) | 1));
+    std::cout << "  ✓ A null string clears the table" << '\n';
+}
+
+int main() {
+    std::cout << "=== VM Intern Table Tests ===" << '\n';
+
+    try {
+        test_table_basics();
+        test_table_growth();
+        test_table_preload();
+        test_intern_opcode();
+
+        std::cout << "\n✓ All intern table tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
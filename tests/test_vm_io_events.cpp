@@ -0,0 +1,235 @@
+#include "../src/memory_layout.hpp"
+#include "../src/stack_vm.hpp"
+#include "vm_test_helpers.hpp"
+#include <cassert>
+#include <csignal>
+#include <iostream>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+// Handler log in the heap: [count][record fd][record events][fd log...]
+static constexpr uint64_t COUNT = MemoryLayout::HEAP_START + 100;
+static constexpr uint64_t RECORD = COUNT + 1;
+static constexpr uint64_t LOG = COUNT + 3;
+static constexpr uint64_t HANDLER = 200;
+
+static std::vector<uint64_t> c_call(uint64_t func_id, const std::vector<uint64_t>& args) {
+    std::vector<uint64_t> code;
+    for (uint64_t arg : args) {
+        code.push_back(op(Opcode::PUSH));
+        code.push_back(arg);
+    }
+    code.insert(code.end(),
+                {op(Opcode::PUSH), args.size(), op(Opcode::PUSH), func_id, op(Opcode::C_CALL)});
+    return code;
+}
+
+static void append(std::vector<uint64_t>& code, const std::vector<uint64_t>& more) {
+    code.insert(code.end(), more.begin(), more.end());
+}
+
+// SIGIO handler at HANDLER: takes one readiness record, logs its fd at
+// LOG + count, bumps the count, and returns with IRET
+static std::vector<uint64_t> with_handler(std::vector<uint64_t> main_code) {
+    std::vector<uint64_t> program = {op(Opcode::PUSH), HANDLER, op(Opcode::PUSH),
+                                     static_cast<uint64_t>(SIGIO), op(Opcode::SIGNAL_REG)};
+    append(program, main_code);
+    assert(program.size() <= HANDLER);
+    program.resize(HANDLER, 0);
+
+    append(program, c_call(14, {RECORD}));
+    append(program, {op(Opcode::POP),  op(Opcode::PUSH), RECORD, op(Opcode::LOAD),
+                     op(Opcode::PUSH), COUNT,           op(Opcode::LOAD), op(Opcode::PUSH),
+                     LOG,              op(Opcode::ADD), op(Opcode::STORE), op(Opcode::PUSH),
+                     COUNT,            op(Opcode::LOAD), op(Opcode::PUSH), 1,
+                     op(Opcode::ADD),  op(Opcode::PUSH), COUNT,           op(Opcode::STORE),
+                     op(Opcode::IRET)});
+    return program;
+}
+
+static uint64_t run(StackVM& vm, const std::vector<uint64_t>& program) {
+    vm.reset();
+    vm.load_program(program);
+    vm.execute(1000000);
+    return vm.get_top();
+}
+
+void test_wait_delivers_interrupt() {
+    std::cout << "Testing io-wait and SIGIO delivery..." << '\n';
+
+    StackVM vm;
+    int fds[2];
+    assert(pipe(fds) == 0);
+    const auto rfd = static_cast<uint64_t>(fds[0]);
+
+    std::vector<uint64_t> main_code = c_call(12, {rfd, IoPoller::READABLE});
+    append(main_code, {op(Opcode::POP)});
+    append(main_code, c_call(13, {1000}));
+    append(main_code, {op(Opcode::HALT)});
+
+    assert(write(fds[1], "ping", 4) == 4);
+    assert(run(vm, with_handler(main_code)) == 1); // io-wait answered one record
+    assert(vm.read_memory(COUNT) == 1);
+    assert(vm.read_memory(RECORD) == rfd);
+    assert(vm.read_memory(RECORD + 1) == IoPoller::READABLE);
+    std::cout << "  ✓ Readiness runs the SIGIO handler with an [fd, events] record" << '\n';
+
+    // Edge-triggered: nothing new to report until more data arrives
+    std::vector<uint64_t> poll_code = c_call(13, {0});
+    append(poll_code, {op(Opcode::HALT)});
+    assert(run(vm, poll_code) == 0);
+    char buffer[8];
+    assert(read(fds[0], buffer, sizeof(buffer)) == 4);
+    assert(read(fds[0], buffer, sizeof(buffer)) == -1 && errno == EAGAIN);
+    std::cout << "  ✓ Watched fds are nonblocking and edge-triggered" << '\n';
+
+    std::vector<uint64_t> unwatch_code = c_call(12, {rfd, 0});
+    append(unwatch_code, {op(Opcode::HALT)});
+    assert(run(vm, unwatch_code) == 0);
+    assert(write(fds[1], "more", 4) == 4);
+    assert(run(vm, poll_code) == 0);
+    assert(static_cast<int64_t>(run(vm, unwatch_code)) == -1);
+    std::cout << "  ✓ Events 0 stops watching" << '\n';
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_many_streams() {
+    std::cout << "Testing several streams on one VM..." << '\n';
+
+    StackVM vm;
+    constexpr int STREAMS = 8;
+    int pipes[STREAMS][2];
+    std::vector<uint64_t> main_code;
+    for (auto& p : pipes) {
+        assert(pipe(p) == 0);
+        append(main_code, c_call(12, {static_cast<uint64_t>(p[0]), IoPoller::READABLE}));
+        append(main_code, {op(Opcode::POP)});
+    }
+    append(main_code, c_call(13, {1000}));
+    append(main_code, {op(Opcode::HALT)});
+
+    // Only the odd streams have data
+    for (int i = 1; i < STREAMS; i += 2) {
+        assert(write(pipes[i][1], "x", 1) == 1);
+    }
+    assert(run(vm, with_handler(main_code)) == STREAMS / 2);
+    assert(vm.read_memory(COUNT) == STREAMS / 2);
+    std::vector<bool> seen(STREAMS, false);
+    for (uint64_t i = 0; i < STREAMS / 2; i++) {
+        for (int s = 0; s < STREAMS; s++) {
+            if (vm.read_memory(LOG + i) == static_cast<uint64_t>(pipes[s][0])) {
+                seen[s] = true;
+            }
+        }
+    }
+    for (int s = 0; s < STREAMS; s++) {
+        assert(seen[s] == (s % 2 == 1));
+    }
+    std::cout << "  ✓ One handler run per ready stream, idle streams stay quiet" << '\n';
+
+    for (auto& p : pipes) {
+        close(p[0]);
+        close(p[1]);
+    }
+}
+
+void test_polling_while_running() {
+    std::cout << "Testing readiness delivered to a busy program..." << '\n';
+
+    StackVM vm;
+    int sv[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+
+    // Watch for writability, then spin until the handler has run
+    std::vector<uint64_t> main_code =
+        c_call(12, {static_cast<uint64_t>(sv[0]), IoPoller::WRITABLE});
+    append(main_code, {op(Opcode::POP)});
+    const uint64_t loop = 5 + main_code.size();
+    append(main_code, {op(Opcode::PUSH), COUNT, op(Opcode::LOAD), op(Opcode::JZ), loop,
+                       op(Opcode::PUSH), 77, op(Opcode::HALT)});
+
+    assert(run(vm, with_handler(main_code)) == 77);
+    assert(vm.read_memory(COUNT) == 1);
+    assert(vm.read_memory(RECORD) == static_cast<uint64_t>(sv[0]));
+    assert(vm.read_memory(RECORD + 1) == IoPoller::WRITABLE);
+    std::cout << "  ✓ The VM polls between instructions without io-wait" << '\n';
+
+    close(sv[0]);
+    close(sv[1]);
+}
+
+void test_close_and_reuse() {
+    std::cout << "Testing closing a watched fd..." << '\n';
+
+    StackVM vm;
+    int fds[2];
+    assert(pipe(fds) == 0);
+    const auto rfd = static_cast<uint64_t>(fds[0]);
+
+    // Watch it, queue a record for it, then close it through C_CALL
+    std::vector<uint64_t> close_code = c_call(12, {rfd, IoPoller::READABLE});
+    append(close_code, {op(Opcode::POP)});
+    append(close_code, c_call(13, {0}));
+    append(close_code, {op(Opcode::POP)});
+    append(close_code, c_call(3, {rfd}));
+    append(close_code, {op(Opcode::HALT)});
+    assert(write(fds[1], "stale", 5) == 5);
+    assert(run(vm, close_code) == 0);
+    close(fds[1]);
+
+    // A new pipe on the same fd number
+    int again[2];
+    assert(pipe(again) == 0);
+    if (again[0] != fds[0]) {
+        assert(dup2(again[0], fds[0]) == fds[0]);
+        close(again[0]);
+    }
+
+    std::vector<uint64_t> main_code = c_call(12, {rfd, IoPoller::READABLE});
+    append(main_code, {op(Opcode::POP)});
+    append(main_code, c_call(13, {1000}));
+    append(main_code, {op(Opcode::HALT)});
+    assert(write(again[1], "fresh", 5) == 5);
+    assert(run(vm, with_handler(main_code)) == 1);
+    assert(vm.read_memory(COUNT) == 1);
+    assert(vm.read_memory(RECORD) == rfd);
+    std::cout << "  ✓ The reused fd is watched afresh, without the closed one's record"
+              << '\n';
+
+    // Closed without the poller knowing, the number is still added again
+    IoPoller poller;
+    assert(poller.watch(fds[0], IoPoller::READABLE) == 0);
+    close(fds[0]);
+    int third[2];
+    assert(pipe(third) == 0);
+    if (third[0] != fds[0]) {
+        assert(dup2(third[0], fds[0]) == fds[0]);
+        close(third[0]);
+    }
+    assert(poller.watch(fds[0], IoPoller::READABLE) == 0);
+    std::cout << "  ✓ Watching a number whose fd was closed elsewhere adds it again" << '\n';
+
+    close(fds[0]);
+    close(again[1]);
+    close(third[1]);
+}
+
+int main() {
+    std::cout << "=== VM I/O Event Tests ===" << '\n';
+
+    try {
+        test_wait_delivers_interrupt();
+        test_many_streams();
+        test_polling_while_running();
+        test_close_and_reuse();
+
+        std::cout << "\n✓ All I/O event tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
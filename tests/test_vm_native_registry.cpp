@@ -0,0 +1,147 @@
+#include "../src/memory_layout.hpp"
+#include "../src/stack_vm.hpp"
+#include "vm_test_helpers.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static constexpr uint64_t DATA = MemoryLayout::HEAP_START + 100;
+
+// Program: C_CALL func_id(args...) -> HALT
+static std::vector<uint64_t> c_call_program(uint64_t func_id, const std::vector<uint64_t>& args) {
+    std::vector<uint64_t> program;
+    for (uint64_t arg : args) {
+        program.push_back(op(Opcode::PUSH));
+        program.push_back(arg);
+    }
+    program.insert(program.end(), {op(Opcode::PUSH), args.size(), op(Opcode::PUSH), func_id,
+                                   op(Opcode::C_CALL), op(Opcode::HALT)});
+    return program;
+}
+
+static uint64_t c_call(StackVM& vm, uint64_t func_id, const std::vector<uint64_t>& args) {
+    vm.reset();
+    vm.load_program(c_call_program(func_id, args));
+    vm.execute();
+    return vm.get_top();
+}
+
+// a * 100 + b * 10 + c: checks argument order
+static uint64_t digits(StackVM& /*vm*/, NativeArgs args) {
+    return (args[0] * 100) + (args[1] * 10) + args[2];
+}
+
+// FNV-1a over count words starting at a word address
+static uint64_t hash_words(StackVM& vm, NativeArgs args) {
+    uint64_t h = 14695981039346656037ULL;
+    for (uint64_t i = 0; i < args[1]; i++) {
+        h = (h ^ vm.read_memory(args[0] + i)) * 1099511628211ULL;
+    }
+    return h;
+}
+
+static uint64_t answer(StackVM& /*vm*/, NativeArgs /*args*/) {
+    return 42;
+}
+
+void test_register_and_call() {
+    std::cout << "Testing register_native..." << '\n';
+
+    StackVM vm;
+    vm.register_native(100, digits, 3, "digits");
+    vm.register_native(255, answer, 0, "answer");
+
+    const uint64_t initial_sp = vm.get_sp();
+    assert(c_call(vm, 100, {1, 2, 3}) == 123);
+    assert(vm.get_sp() == initial_sp - 1);
+    std::cout << "  ✓ Arguments arrive in call order and are replaced by the result" << '\n';
+
+    assert(c_call(vm, 255, {}) == 42);
+    std::cout << "  ✓ Zero-argument natives" << '\n';
+
+    vm.register_native(101, hash_words, 2, "hash-words");
+    for (uint64_t i = 0; i < 4; i++) {
+        vm.write_memory(DATA + i, i * 7);
+    }
+    const uint64_t h = c_call(vm, 101, {DATA, 4});
+    assert(h == c_call(vm, 101, {DATA, 4}));
+    vm.write_memory(DATA + 3, 0);
+    assert(h != c_call(vm, 101, {DATA, 4}));
+    std::cout << "  ✓ Natives can read VM memory" << '\n';
+}
+
+void test_replace_builtin() {
+    std::cout << "Testing replacing a built-in..." << '\n';
+
+    StackVM vm;
+    vm.register_native(5, answer, 1, "fsize");
+    assert(c_call(vm, 5, {0}) == 42);
+    StackVM other;
+    assert(c_call(other, 5, {999}) == static_cast<uint64_t>(-1)); // Registries are per VM
+    std::cout << "  ✓ Registering over an id replaces it for that VM only" << '\n';
+}
+
+void test_errors() {
+    std::cout << "Testing registry errors..." << '\n';
+
+    StackVM vm;
+    vm.register_native(100, digits, 3, "digits");
+
+    bool threw = false;
+    try {
+        c_call(vm, 100, {1, 2});
+    } catch (const std::runtime_error& e) {
+        threw = std::string(e.what()).find("digits") != std::string::npos;
+    }
+    assert(threw);
+    std::cout << "  ✓ Wrong argument count names the native" << '\n';
+
+    threw = false;
+    try {
+        c_call(vm, 77, {});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        c_call(vm, 1000, {});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ Unknown ids are rejected" << '\n';
+
+    threw = false;
+    try {
+        vm.register_native(256, answer, 0);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        vm.register_native(20, nullptr, 0);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ Out-of-range ids and null functions cannot be registered" << '\n';
+}
+
+int main() {
+    std::cout << "=== VM Native Registry Tests ===" << '\n';
+
+    try {
+        test_register_and_call();
+        test_replace_builtin();
+        test_errors();
+
+        std::cout << "\n✓ All native registry tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,194 @@
+#include "../src/memory_layout.hpp"
+#include "../src/send_cache.hpp"
+#include "../src/stack_vm.hpp"
+#include "vm_test_helpers.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+// Hand-assembled programs share this layout:
+//   @0    main:      push receiver (and args), SEND_CACHED site, HALT
+//   @100  method A:  returns 111
+//   @110  method B:  returns 222
+//   @120  method C:  returns its first argument after the receiver
+//   @200  handler:   returns its last argument (the site address)
+static constexpr uint64_t METHOD_A = 100;
+static constexpr uint64_t METHOD_B = 110;
+static constexpr uint64_t METHOD_C = 120;
+static constexpr uint64_t HANDLER = 200;
+static constexpr uint64_t SITE = MemoryLayout::HEAP_START + 100;
+static constexpr uint64_t OBJECT = MemoryLayout::HEAP_START + 1000;
+static constexpr uint64_t OBJECT_CLASS = MemoryLayout::HEAP_START + 2000;
+
+static std::vector<uint64_t> build_program(const std::vector<uint64_t>& main_code) {
+    std::vector<uint64_t> program(256, 0);
+    std::copy(main_code.begin(), main_code.end(), program.begin());
+
+    // Each starts with its header, in the word before its entry point
+    const std::vector<uint64_t> method_a = {FunctionHeader::make(1, 0), op(Opcode::PUSH), 111,
+                                            op(Opcode::RET)};
+    const std::vector<uint64_t> method_b = {FunctionHeader::make(1, 0), op(Opcode::PUSH), 222,
+                                            op(Opcode::RET)};
+    const std::vector<uint64_t> method_c = {FunctionHeader::make(2, 0), op(Opcode::PUSH), 1,
+                                            op(Opcode::BP_LOAD), op(Opcode::RET)};
+    const std::vector<uint64_t> handler = {FunctionHeader::make(2, 0), op(Opcode::PUSH), 1,
+                                           op(Opcode::BP_LOAD), op(Opcode::RET)};
+
+    const auto at = [&](uint64_t entry) { return program.begin() + entry - FunctionHeader::SIZE; };
+    std::copy(method_a.begin(), method_a.end(), at(METHOD_A));
+    std::copy(method_b.begin(), method_b.end(), at(METHOD_B));
+    std::copy(method_c.begin(), method_c.end(), at(METHOD_C));
+    std::copy(handler.begin(), handler.end(), at(HANDLER));
+    return program;
+}
+
+static void init_site(StackVM& vm, uint64_t nargs, uint64_t handler) {
+    for (size_t i = 0; i < SendSite::SIZE; i++) {
+        vm.write_memory(SITE + i, 0);
+    }
+    vm.write_memory(SITE + SendSite::NARGS, nargs);
+    vm.write_memory(SITE + SendSite::HANDLER, handler);
+}
+
+static void add_entry(StackVM& vm, uint64_t class_key, uint64_t target) {
+    const uint64_t state = vm.read_memory(SITE + SendSite::STATE);
+    vm.write_memory(SITE + SendSite::entry_class(state), class_key);
+    vm.write_memory(SITE + SendSite::entry_target(state), target);
+    vm.write_memory(SITE + SendSite::STATE, state + 1);
+}
+
+void test_empty_site_calls_handler() {
+    std::cout << "Testing SEND_CACHED miss on an empty site..." << '\n';
+
+    StackVM vm;
+    vm.load_program(build_program(
+        {op(Opcode::PUSH), 7, op(Opcode::SEND_CACHED), SITE, op(Opcode::HALT)}));
+    init_site(vm, 0, HANDLER);
+
+    const uint64_t initial_sp = vm.get_sp();
+    vm.execute();
+
+    assert(vm.get_top() == SITE);
+    assert(vm.get_sp() == initial_sp - 1);
+    assert(vm.read_memory(SITE + SendSite::MISSES) == 1);
+    assert(vm.read_memory(SITE + SendSite::HITS) == 0);
+    std::cout << "  ✓ Handler receives (receiver, site) and its result is the send's result"
+              << '\n';
+}
+
+void test_hit_by_class() {
+    std::cout << "Testing SEND_CACHED hits for integers and objects..." << '\n';
+
+    // Tagged integer receiver
+    {
+        StackVM vm;
+        vm.load_program(build_program(
+            {op(Opcode::PUSH), 7, op(Opcode::SEND_CACHED), SITE, op(Opcode::HALT)}));
+        init_site(vm, 0, HANDLER);
+        add_entry(vm, OBJECT_CLASS, METHOD_B);
+        add_entry(vm, SendSite::SMALL_INTEGER_KEY, METHOD_A);
+
+        const uint64_t initial_sp = vm.get_sp();
+        vm.execute();
+
+        assert(vm.get_top() == 111);
+        assert(vm.get_sp() == initial_sp - 1);
+        assert(vm.read_memory(SITE + SendSite::HITS) == 1);
+        assert(vm.read_memory(SITE + SendSite::MISSES) == 0);
+    }
+    std::cout << "  ✓ Tagged integers hit the SmallInteger entry" << '\n';
+
+    // Heap object receiver, keyed by its behavior word
+    {
+        StackVM vm;
+        vm.load_program(build_program(
+            {op(Opcode::PUSH), OBJECT, op(Opcode::SEND_CACHED), SITE, op(Opcode::HALT)}));
+        vm.write_memory(OBJECT, OBJECT_CLASS);
+        init_site(vm, 0, HANDLER);
+        add_entry(vm, SendSite::SMALL_INTEGER_KEY, METHOD_A);
+        add_entry(vm, OBJECT_CLASS, METHOD_B);
+
+        vm.execute();
+
+        assert(vm.get_top() == 222);
+        assert(vm.read_memory(SITE + SendSite::HITS) == 1);
+    }
+    std::cout << "  ✓ Objects hit the entry for their class" << '\n';
+}
+
+void test_send_with_argument() {
+    std::cout << "Testing SEND_CACHED with an argument..." << '\n';
+
+    StackVM vm;
+    vm.load_program(build_program({op(Opcode::PUSH), 7, op(Opcode::PUSH), 42,
+                                   op(Opcode::SEND_CACHED), SITE, op(Opcode::HALT)}));
+    init_site(vm, 1, HANDLER);
+    add_entry(vm, SendSite::SMALL_INTEGER_KEY, METHOD_C);
+
+    const uint64_t initial_sp = vm.get_sp();
+    vm.execute();
+
+    assert(vm.get_top() == 42);
+    assert(vm.get_sp() == initial_sp - 1);
+    std::cout << "  ✓ Receiver and argument are passed in order and popped on return" << '\n';
+}
+
+void test_megamorphic_site() {
+    std::cout << "Testing SEND_CACHED on a megamorphic site..." << '\n';
+
+    StackVM vm;
+    vm.load_program(build_program(
+        {op(Opcode::PUSH), 7, op(Opcode::SEND_CACHED), SITE, op(Opcode::HALT)}));
+    init_site(vm, 0, HANDLER);
+    add_entry(vm, SendSite::SMALL_INTEGER_KEY, METHOD_A);
+    vm.write_memory(SITE + SendSite::STATE, SendSite::MEGAMORPHIC);
+
+    vm.execute();
+
+    assert(vm.get_top() == SITE);
+    assert(vm.read_memory(SITE + SendSite::MISSES) == 1);
+    std::cout << "  ✓ Megamorphic sites always go through the handler" << '\n';
+}
+
+void test_send_site_profiling() {
+    std::cout << "Testing send site profiling..." << '\n';
+
+    StackVM vm;
+    vm.load_program(build_program({op(Opcode::PUSH), 7, op(Opcode::SEND_CACHED), SITE,
+                                   op(Opcode::POP), op(Opcode::PUSH), 9,
+                                   op(Opcode::SEND_CACHED), SITE, op(Opcode::HALT)}));
+    init_site(vm, 0, HANDLER);
+    add_entry(vm, SendSite::SMALL_INTEGER_KEY, METHOD_A);
+
+    vm.enable_profiling();
+    vm.execute();
+
+    const SendSite::Stats stats = vm.get_send_site_stats();
+    assert(stats.sites == 1);
+    assert(stats.monomorphic == 1);
+    assert(stats.hits == 2);
+    assert(stats.misses == 0);
+    assert(vm.get_opcode_count(Opcode::SEND_CACHED) == 2);
+
+    vm.reset_profiling();
+    assert(vm.get_send_site_stats().sites == 0);
+    std::cout << "  ✓ Profiler tracks per-site cache state" << '\n';
+}
+
+int main() {
+    std::cout << "=== VM Send Cache Tests ===" << '\n';
+
+    try {
+        test_empty_site_calls_handler();
+        test_hit_by_class();
+        test_send_with_argument();
+        test_megamorphic_site();
+        test_send_site_profiling();
+
+        std::cout << "\n✓ All send cache tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
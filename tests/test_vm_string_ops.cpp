@@ -0,0 +1,183 @@
+#include "../src/memory_layout.hpp"
+#include "../src/stack_vm.hpp"
+#include "../src/string_ops.hpp"
+#include "vm_test_helpers.hpp"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static constexpr uint64_t STR_A = MemoryLayout::HEAP_START + 100;
+static constexpr uint64_t STR_B = MemoryLayout::HEAP_START + 200;
+static constexpr uint64_t NOT_FOUND = static_cast<uint64_t>(-1);
+
+// Program: PUSH each argument, <o>, HALT
+static uint64_t run(StackVM& vm, Opcode o, const std::vector<uint64_t>& args) {
+    std::vector<uint64_t> program;
+    for (uint64_t arg : args) {
+        program.push_back(op(Opcode::PUSH));
+        program.push_back(arg);
+    }
+    program.push_back(op(o));
+    program.push_back(op(Opcode::HALT));
+    vm.reset();
+    vm.load_program(program);
+    vm.execute();
+    return vm.get_top();
+}
+
+// Byte-at-a-time references for the block loops
+static size_t reference_index(const std::string& s, size_t start, char c) {
+    const size_t i = s.find(c, start);
+    return i == std::string::npos ? s.size() : i;
+}
+
+static size_t reference_scan(const std::string& s, size_t start, uint64_t classes) {
+    size_t i = start;
+    while (i < s.size() && StringOps::in_class(static_cast<uint8_t>(s[i]), classes)) {
+        i++;
+    }
+    return i;
+}
+
+void test_block_loops() {
+    std::cout << "Testing block search and scan against byte loops..." << '\n';
+
+    // Every length and start up to a few blocks, so each match position
+    // lands both inside a block and in the scalar tail
+    const std::string pattern = "abcXYZ019 \t\r\n_:+@[`{/";
+    for (size_t length = 0; length <= 80; length++) {
+        std::string s;
+        for (size_t i = 0; i < length; i++) {
+            s += pattern[(i * 7 + length) % pattern.size()];
+        }
+        const auto* bytes = reinterpret_cast<const uint8_t*>(s.data());
+        for (size_t start = 0; start <= length; start++) {
+            for (char c : {'a', 'Z', ' ', '/', '\0'}) {
+                assert(StringOps::index_of(bytes, length, start, static_cast<uint8_t>(c)) ==
+                       reference_index(s, start, c));
+            }
+            for (uint64_t classes = 0; classes < 8; classes++) {
+                assert(StringOps::scan(bytes, length, start, classes) ==
+                       reference_scan(s, start, classes));
+            }
+        }
+    }
+    std::cout << "  ✓ index_of and scan agree with byte loops (block size "
+#if defined(__AVX2__) || defined(__SSE2__)
+              << StringOps::BLOCK
+#else
+              << 1
+#endif
+              << ")" << '\n';
+
+    // Class boundaries: the characters on either side of each range
+    for (int c = 0; c < 256; c++) {
+        const auto b = static_cast<uint8_t>(c);
+        const bool letter = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+        const bool digit = c >= '0' && c <= '9';
+        const bool space = c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        assert(StringOps::in_class(b, StringOps::CLASS_LETTER) == letter);
+        assert(StringOps::in_class(b, StringOps::CLASS_DIGIT) == digit);
+        assert(StringOps::in_class(b, StringOps::CLASS_WHITESPACE) == space);
+
+        const std::string run_of(40, static_cast<char>(c));
+        const auto* bytes = reinterpret_cast<const uint8_t*>(run_of.data());
+        assert(StringOps::scan(bytes, 40, 0, StringOps::CLASS_LETTER) == (letter ? 40 : 0));
+        assert(StringOps::scan(bytes, 40, 0, StringOps::CLASS_DIGIT) == (digit ? 40 : 0));
+    }
+    std::cout << "  ✓ Classes match exactly, including bytes >= 128" << '\n';
+}
+
+void test_opcodes() {
+    std::cout << "Testing STR_EQ/STR_HASH/STR_INDEX/STR_SCAN..." << '\n';
+
+    StackVM vm;
+    const std::string source = "   between: aValue and: another42 + 7";
+    write_string(vm, STR_A, source);
+    write_string(vm, STR_B, source);
+
+    assert(run(vm, Opcode::STR_EQ, {STR_A, STR_B}) == 1);
+    write_string(vm, STR_B, source.substr(0, source.size() - 1) + "8");
+    assert(run(vm, Opcode::STR_EQ, {STR_A, STR_B}) == 0);
+    write_string(vm, STR_B, source.substr(0, 10));
+    assert(run(vm, Opcode::STR_EQ, {STR_A, STR_B}) == 0);
+    write_string(vm, STR_B, "");
+    assert(run(vm, Opcode::STR_EQ, {STR_B, STR_B}) == 1);
+    std::cout << "  ✓ STR_EQ compares lengths and bytes" << '\n';
+
+    uint64_t djb2 = 5381;
+    for (char c : source) {
+        djb2 = (djb2 * 33) + static_cast<uint8_t>(c);
+    }
+    assert(run(vm, Opcode::STR_HASH, {STR_A}) == djb2);
+    assert(run(vm, Opcode::STR_HASH, {STR_B}) == 5381);
+    std::cout << "  ✓ STR_HASH is DJB2 with 64-bit wraparound" << '\n';
+
+    assert(run(vm, Opcode::STR_INDEX, {STR_A, 0, ':'}) == 10);
+    assert(run(vm, Opcode::STR_INDEX, {STR_A, 11, ':'}) == 22);
+    assert(run(vm, Opcode::STR_INDEX, {STR_A, 23, ':'}) == NOT_FOUND);
+    assert(run(vm, Opcode::STR_INDEX, {STR_A, 0, '7'}) == source.size() - 1);
+    assert(run(vm, Opcode::STR_INDEX, {STR_A, 0, 0x13A}) == NOT_FOUND);
+    assert(run(vm, Opcode::STR_INDEX, {STR_A, 500, ':'}) == NOT_FOUND);
+    std::cout << "  ✓ STR_INDEX finds chars from start, -1 when absent" << '\n';
+
+    assert(run(vm, Opcode::STR_SCAN, {STR_A, 0, StringOps::CLASS_WHITESPACE}) == 3);
+    assert(run(vm, Opcode::STR_SCAN, {STR_A, 3, StringOps::CLASS_LETTER}) == 10);
+    assert(run(vm, Opcode::STR_SCAN, {STR_A, 24, StringOps::CLASS_LETTER}) == 31);
+    assert(run(vm, Opcode::STR_SCAN,
+               {STR_A, 24, StringOps::CLASS_LETTER | StringOps::CLASS_DIGIT}) == 33);
+    assert(run(vm, Opcode::STR_SCAN, {STR_A, source.size() - 1, StringOps::CLASS_DIGIT}) ==
+           source.size());
+    assert(run(vm, Opcode::STR_SCAN, {STR_A, 500, StringOps::CLASS_DIGIT}) == source.size());
+    std::cout << "  ✓ STR_SCAN stops at the first char outside the classes" << '\n';
+
+    bool threw = false;
+    vm.write_memory(STR_A, MemoryLayout::MEMORY_SIZE * 8);
+    try {
+        run(vm, Opcode::STR_HASH, {STR_A});
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ A length past the end of memory is rejected" << '\n';
+}
+
+void test_lisp_intrinsics() {
+    std::cout << "Testing str-* Lisp intrinsics..." << '\n';
+
+    assert(run_lisp("(str-equal \"selector:\" \"selector:\")") == 1);
+    assert(run_lisp("(str-equal \"selector:\" \"selector\")") == 0);
+    assert(run_lisp("(= (str-hash \"ab\") (+ (* (+ (* 5381 33) 97) 33) 98))") == 1);
+    assert(run_lisp("(str-index \"foo: bar: baz\" 4 58)") == 8);
+    assert(run_lisp("(str-index \"foo\" 0 58)") == -1);
+    assert(run_lisp("(str-scan \"  \t\n x\" 0 4)") == 5);
+    assert(run_lisp("(str-scan \"abc123 def\" 0 3)") == 6);
+    std::cout << "  ✓ str-equal, str-hash, str-index and str-scan compile to opcodes" << '\n';
+
+    bool threw = false;
+    try {
+        run_lisp("(str-scan \"abc\" 0)");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ Wrong argument count is a compile error" << '\n';
+}
+
+int main() {
+    std::cout << "=== VM String Primitive Tests ===" << '\n';
+
+    try {
+        test_block_loops();
+        test_opcodes();
+        test_lisp_intrinsics();
+
+        std::cout << "\n✓ All string primitive tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
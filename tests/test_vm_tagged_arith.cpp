@@ -0,0 +1,127 @@
+#include "../src/stack_vm.hpp"
+#include "vm_test_helpers.hpp"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Programs share this layout:
+//   @0   push a, push b, T<op> FALLBACK, HALT
+//   @20  fallback: PUSH 999, HALT (operands left underneath)
+static constexpr uint64_t FALLBACK = 20;
+static constexpr uint64_t FALLBACK_MARK = 999;
+
+static uint64_t tag(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) | 1;
+}
+
+static int64_t untag(uint64_t t) {
+    return static_cast<int64_t>(t) >> 1;
+}
+
+static std::vector<uint64_t> build_program(Opcode o, uint64_t a, uint64_t b) {
+    std::vector<uint64_t> program(32, 0);
+    const std::vector<uint64_t> main_code = {op(Opcode::PUSH), a,        op(Opcode::PUSH), b,
+                                             op(o),            FALLBACK, op(Opcode::HALT)};
+    const std::vector<uint64_t> fallback = {op(Opcode::PUSH), FALLBACK_MARK, op(Opcode::HALT)};
+    std::copy(main_code.begin(), main_code.end(), program.begin());
+    std::copy(fallback.begin(), fallback.end(), program.begin() + FALLBACK);
+    return program;
+}
+
+// Runs a op b; returns the result, or FALLBACK_MARK if the fallback was taken
+// (after checking the operands were left in place for the send)
+static uint64_t run(Opcode o, uint64_t a, uint64_t b) {
+    StackVM vm;
+    vm.load_program(build_program(o, a, b));
+    const uint64_t initial_sp = vm.get_sp();
+    vm.execute();
+
+    const uint64_t top = vm.get_top();
+    if (top == FALLBACK_MARK) {
+        assert(vm.get_sp() == initial_sp - 3);
+        vm.stack_pop();
+        assert(vm.stack_pop() == b);
+        assert(vm.stack_pop() == a);
+    } else {
+        assert(vm.get_sp() == initial_sp - 1);
+    }
+    return top;
+}
+
+void test_tagged_arithmetic() {
+    std::cout << "Testing TADD/TSUB/TMUL on SmallIntegers..." << '\n';
+
+    assert(untag(run(Opcode::TADD, tag(3), tag(4))) == 7);
+    assert(untag(run(Opcode::TADD, tag(-10), tag(4))) == -6);
+    std::cout << "  ✓ TADD adds tagged operands" << '\n';
+
+    assert(untag(run(Opcode::TSUB, tag(3), tag(10))) == -7);
+    assert(untag(run(Opcode::TSUB, tag(-3), tag(-10))) == 7);
+    std::cout << "  ✓ TSUB subtracts tagged operands" << '\n';
+
+    assert(untag(run(Opcode::TMUL, tag(6), tag(7))) == 42);
+    assert(untag(run(Opcode::TMUL, tag(-6), tag(7))) == -42);
+    assert(untag(run(Opcode::TMUL, tag(-6), tag(-7))) == 42);
+    assert(untag(run(Opcode::TMUL, tag(0), tag(-7))) == 0);
+    std::cout << "  ✓ TMUL multiplies tagged operands" << '\n';
+}
+
+void test_tagged_comparisons() {
+    std::cout << "Testing TEQ/TLT/TGT/TLTE/TGTE on SmallIntegers..." << '\n';
+
+    assert(run(Opcode::TEQ, tag(5), tag(5)) == tag(1));
+    assert(run(Opcode::TEQ, tag(5), tag(6)) == tag(0));
+    assert(run(Opcode::TLT, tag(-1), tag(0)) == tag(1));
+    assert(run(Opcode::TLT, tag(0), tag(0)) == tag(0));
+    assert(run(Opcode::TGT, tag(1), tag(-1)) == tag(1));
+    assert(run(Opcode::TGT, tag(-1), tag(1)) == tag(0));
+    assert(run(Opcode::TLTE, tag(4), tag(4)) == tag(1));
+    assert(run(Opcode::TLTE, tag(5), tag(4)) == tag(0));
+    assert(run(Opcode::TGTE, tag(4), tag(4)) == tag(1));
+    assert(run(Opcode::TGTE, tag(3), tag(4)) == tag(0));
+    std::cout << "  ✓ Comparisons answer tagged 1/0" << '\n';
+}
+
+void test_non_integer_fallback() {
+    std::cout << "Testing fallback for non-SmallInteger operands..." << '\n';
+
+    const uint64_t object = MemoryLayout::HEAP_START + 1000;
+    assert(run(Opcode::TADD, object, tag(1)) == FALLBACK_MARK);
+    assert(run(Opcode::TSUB, tag(1), object) == FALLBACK_MARK);
+    assert(run(Opcode::TMUL, 0, tag(2)) == FALLBACK_MARK);
+    assert(run(Opcode::TEQ, object, object) == FALLBACK_MARK);
+    assert(run(Opcode::TLT, tag(1), 0) == FALLBACK_MARK);
+    std::cout << "  ✓ Pointer or nil operands jump to the send with operands in place" << '\n';
+}
+
+void test_overflow_fallback() {
+    std::cout << "Testing fallback on SmallInteger overflow..." << '\n';
+
+    const int64_t max = INT64_MAX >> 1;
+    const int64_t min = INT64_MIN >> 1;
+    assert(untag(run(Opcode::TADD, tag(max - 1), tag(1))) == max);
+    assert(run(Opcode::TADD, tag(max), tag(1)) == FALLBACK_MARK);
+    assert(run(Opcode::TSUB, tag(min), tag(1)) == FALLBACK_MARK);
+    assert(untag(run(Opcode::TMUL, tag(max / 2), tag(2))) == max - 1);
+    assert(run(Opcode::TMUL, tag(max), tag(2)) == FALLBACK_MARK);
+    assert(run(Opcode::TMUL, tag(min), tag(-1)) == FALLBACK_MARK);
+    std::cout << "  ✓ Results outside the SmallInteger range take the send" << '\n';
+}
+
+int main() {
+    std::cout << "=== VM Tagged Arithmetic Tests ===" << '\n';
+
+    try {
+        test_tagged_arithmetic();
+        test_tagged_comparisons();
+        test_non_integer_fallback();
+        test_overflow_fallback();
+
+        std::cout << "\n✓ All tagged arithmetic tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
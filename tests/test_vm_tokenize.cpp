@@ -0,0 +1,124 @@
+#include "../src/memory_layout.hpp"
+#include "../src/smalltalk_lexer.hpp"
+#include "../src/stack_vm.hpp"
+#include "vm_test_helpers.hpp"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static constexpr uint64_t SOURCE = MemoryLayout::HEAP_START + 100;
+static constexpr uint64_t RECORDS = MemoryLayout::HEAP_START + 1000;
+static constexpr uint64_t RECORD_WORDS = 4;
+
+static uint64_t tag(uint64_t value) {
+    return (value << 1) | 1;
+}
+
+// Program: TOKENIZE (SOURCE, RECORDS, max) -> HALT
+static uint64_t run_tokenize(StackVM& vm, uint64_t max) {
+    vm.reset();
+    vm.load_program({op(Opcode::PUSH), SOURCE, op(Opcode::PUSH), RECORDS, op(Opcode::PUSH), max,
+                     op(Opcode::TOKENIZE), op(Opcode::HALT)});
+    vm.execute();
+    return vm.get_top();
+}
+
+struct Expected {
+    uint64_t type;
+    uint64_t value; // Tagged, or 0 for END
+    uint64_t start;
+    uint64_t end;
+};
+
+static void check_records(StackVM& vm, const std::vector<Expected>& expected) {
+    for (size_t i = 0; i < expected.size(); i++) {
+        const uint64_t record = RECORDS + (i * RECORD_WORDS);
+        assert(vm.read_memory(record) == tag(expected[i].type));
+        assert(vm.read_memory(record + 1) == expected[i].value);
+        assert(vm.read_memory(record + 2) == tag(expected[i].start));
+        assert(vm.read_memory(record + 3) == tag(expected[i].end));
+    }
+}
+
+void test_lexer() {
+    std::cout << "Testing SmalltalkLexer..." << '\n';
+
+    const std::string source = " x at: 12 put: y <= 3 >= 4 < z";
+    SmalltalkLexer lexer(reinterpret_cast<const uint8_t*>(source.data()), source.size());
+    const std::vector<uint64_t> types = {
+        SmalltalkLexer::IDENTIFIER, SmalltalkLexer::KEYWORD,   SmalltalkLexer::NUMBER,
+        SmalltalkLexer::KEYWORD,    SmalltalkLexer::IDENTIFIER, SmalltalkLexer::BINARY_OP,
+        SmalltalkLexer::NUMBER,     SmalltalkLexer::BINARY_OP, SmalltalkLexer::NUMBER,
+        SmalltalkLexer::BINARY_OP,  SmalltalkLexer::IDENTIFIER, SmalltalkLexer::END};
+    std::vector<SmalltalkLexer::Token> tokens;
+    for (uint64_t type : types) {
+        tokens.push_back(lexer.next());
+        assert(tokens.back().type == type);
+    }
+    assert(tokens[1].value == 3 && tokens[1].end == 6); // "at:" includes the colon
+    assert(tokens[2].value == 12);
+    assert(tokens[5].value == ('<' | ('=' << 8)));
+    assert(tokens[7].value == ('>' | ('=' << 8)));
+    assert(tokens[9].value == '<' && tokens[9].end == tokens[9].start + 1);
+    assert(tokens[11].start == source.size() && tokens[11].end == source.size());
+    assert(lexer.next().type == SmalltalkLexer::END);
+    std::cout << "  ✓ Identifiers, keywords, numbers and packed <=/>= operators" << '\n';
+
+    const std::string stops = "a # b";
+    SmalltalkLexer stop_lexer(reinterpret_cast<const uint8_t*>(stops.data()), stops.size());
+    assert(stop_lexer.next().type == SmalltalkLexer::IDENTIFIER);
+    const SmalltalkLexer::Token end = stop_lexer.next();
+    assert(end.type == SmalltalkLexer::END && end.start == 2 && end.end == 2);
+    std::cout << "  ✓ A character that starts no token ends the stream" << '\n';
+}
+
+void test_tokenize_opcode() {
+    std::cout << "Testing TOKENIZE opcode..." << '\n';
+
+    StackVM vm;
+    write_string(vm, SOURCE, "3 + 4\tbetween: aValue");
+    assert(run_tokenize(vm, 100) == 6);
+    check_records(vm, {{SmalltalkLexer::NUMBER, tag(3), 0, 1},
+                       {SmalltalkLexer::BINARY_OP, tag('+'), 2, 3},
+                       {SmalltalkLexer::NUMBER, tag(4), 4, 5},
+                       {SmalltalkLexer::KEYWORD, tag(6), 6, 14},
+                       {SmalltalkLexer::IDENTIFIER, tag(15), 15, 21},
+                       {SmalltalkLexer::END, 0, 21, 21}});
+    std::cout << "  ✓ Records use the Token slot layout and end with END" << '\n';
+
+    vm.write_memory(RECORDS + (2 * RECORD_WORDS), 0xDEAD);
+    assert(run_tokenize(vm, 2) == 2);
+    assert(vm.read_memory(RECORDS + (2 * RECORD_WORDS)) == 0xDEAD);
+    std::cout << "  ✓ max bounds the records written" << '\n';
+
+    write_string(vm, SOURCE, "");
+    assert(run_tokenize(vm, 1) == 1);
+    check_records(vm, {{SmalltalkLexer::END, 0, 0, 0}});
+    std::cout << "  ✓ Empty source gives a lone END token" << '\n';
+
+    bool threw = false;
+    try {
+        run_tokenize(vm, UINT64_MAX);
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ A record range past the end of memory is rejected" << '\n';
+}
+
+int main() {
+    std::cout << "=== VM Tokenizer Tests ===" << '\n';
+
+    try {
+        test_lexer();
+        test_tokenize_opcode();
+
+        std::cout << "\n✓ All tokenizer tests passed!" << '\n';
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n✗ Test failed: " << e.what() << '\n';
+        return 1;
+    }
+}
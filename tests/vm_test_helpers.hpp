@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../src/lisp_compiler.hpp"
+#include "../src/lisp_parser.hpp"
+#include "../src/stack_vm.hpp"
+#include <cstdint>
+#include <string>
+
+// Helpers shared by the VM tests (tests/test_vm_*.cpp)
+
+// Opcode as a program word
+inline uint64_t op(Opcode o) {
+    return static_cast<uint64_t>(o);
+}
+
+// Write a packed VM string ([length][bytes...]) at addr
+inline void write_string(StackVM& vm, uint64_t addr, const std::string& s) {
+    vm.write_memory(addr, s.size());
+    for (size_t w = 0; w <= s.size() / 8; w++) {
+        uint64_t word = 0;
+        for (size_t b = 0; b < 8 && w * 8 + b < s.size(); b++) {
+            word |= static_cast<uint64_t>(static_cast<uint8_t>(s[w * 8 + b])) << (b * 8);
+        }
+        vm.write_memory(addr + 1 + w, word);
+    }
+}
+
+// Compile and run a Lisp program on a fresh VM; returns the top of the stack
+inline int64_t run_lisp(const std::string& code) {
+    LispParser parser(code);
+    auto ast = parser.parse();
+    LispCompiler compiler;
+    auto program = compiler.compile(ast);
+    StackVM vm;
+    vm.load_program(program);
+    vm.execute();
+    return static_cast<int64_t>(vm.get_top());
+}